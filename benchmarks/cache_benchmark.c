@@ -0,0 +1,294 @@
+/**
+ * @file cache_benchmark.c
+ * @brief Cache misses per tick for the runtime context layout
+ * @version 2.0.0
+ *
+ * This benchmark measures:
+ * - Cache misses and time per tick for many independent instances, comparing
+ *   the legacy context layout (error handler embedded next to the dispatch
+ *   fields) with the hot/cold split layout
+ * - Cache misses and time per StateMachine_Execute() tick of the framework
+ *
+ * Hardware counters are read with perf_event_open(). If the kernel does not
+ * allow it (perf_event_paranoid, containers), only timings are reported.
+ */
+
+#define _GNU_SOURCE
+
+#include "sm_framework/sm_framework.h"
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_INSTANCES  (16384U)  /**< Instances in the synthetic sweep */
+#define BENCH_ROUNDS     (32U)     /**< Sweeps over all instances */
+#define BENCH_TICKS      (1000000U) /**< Framework ticks */
+
+/* =============================================================================
+ * LEGACY LAYOUT (replica of the pre-split structures)
+ * ===========================================================================*/
+
+typedef struct {
+    StateMachineState_t state_id;
+    void (*on_entry)(void);
+    void (*on_state)(void);
+    void (*on_exit)(void);
+    StateTransition_t transitions[SM_MAX_TRANSITIONS_PER_STATE];
+    uint8_t transition_count;
+    uint32_t timeout_ms;
+} LegacyStateConfig_t;
+
+typedef struct {
+    ErrorInfo_t current_error;
+    ErrorInfo_t error_history[ERROR_HISTORY_SIZE];
+    uint8_t history_index;
+    uint32_t minor_error_timestamp;
+    uint8_t minor_good_message_count;
+    bool critical_lock_active;
+} LegacyErrorHandler_t;
+
+typedef struct {
+    StateMachineState_t current_state;
+    StateMachineState_t previous_state;
+    volatile StateMachineEvent_t pending_event;
+    uint32_t state_entry_time;
+    uint32_t state_execution_count;
+    bool state_changed;
+    LegacyErrorHandler_t error_handler;
+} LegacyContext_t;
+
+/* =============================================================================
+ * PERF COUNTERS
+ * ===========================================================================*/
+
+typedef struct {
+    int llc_fd;    /**< Last level cache misses */
+    int l1d_fd;    /**< L1 data cache read misses */
+} PerfCounters_t;
+
+static int OpenCounter(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void Perf_Open(PerfCounters_t *perf)
+{
+    perf->llc_fd = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    perf->l1d_fd = OpenCounter(PERF_TYPE_HW_CACHE,
+                               PERF_COUNT_HW_CACHE_L1D |
+                               (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+}
+
+static void Perf_Start(const PerfCounters_t *perf)
+{
+    if (perf->llc_fd >= 0) {
+        ioctl(perf->llc_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf->llc_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    if (perf->l1d_fd >= 0) {
+        ioctl(perf->l1d_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(perf->l1d_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+static uint64_t ReadCounter(int fd)
+{
+    uint64_t value = 0;
+
+    if (fd < 0) {
+        return 0;
+    }
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value)) {
+        return 0;
+    }
+    return value;
+}
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void Report(const char *name, const PerfCounters_t *perf,
+                   uint64_t elapsed_ns, uint64_t ticks)
+{
+    uint64_t llc = ReadCounter(perf->llc_fd);
+    uint64_t l1d = ReadCounter(perf->l1d_fd);
+
+    printf("%-28s %8.2f ns/tick", name, (double)elapsed_ns / (double)ticks);
+    if (perf->llc_fd >= 0) {
+        printf("  %6.3f LLC miss/tick", (double)llc / (double)ticks);
+    }
+    if (perf->l1d_fd >= 0) {
+        printf("  %6.3f L1D miss/tick", (double)l1d / (double)ticks);
+    }
+    printf("\n");
+}
+
+/* =============================================================================
+ * SYNTHETIC TICKS (same fields StateMachine_Execute() touches when idle)
+ * ===========================================================================*/
+
+static uint32_t TickLegacy(LegacyContext_t *ctx, const LegacyStateConfig_t *table, uint32_t now)
+{
+    const LegacyStateConfig_t *config;
+
+    if (ctx->error_handler.critical_lock_active) {
+        return 0;
+    }
+    config = &table[ctx->current_state];
+    if (ctx->state_changed) {
+        ctx->state_changed = false;
+        ctx->state_entry_time = now;
+    }
+    ctx->state_execution_count++;
+    if (config->timeout_ms > 0 && (now - ctx->state_entry_time) >= config->timeout_ms) {
+        return 1;
+    }
+    return (ctx->pending_event != EVENT_NONE) ? 1U : 0U;
+}
+
+static uint32_t TickSplit(StateMachineContext_t *ctx, uint32_t now)
+{
+    if (ctx->critical_lock_active) {
+        return 0;
+    }
+    if (ctx->state_changed) {
+        ctx->state_changed = false;
+        ctx->state_entry_time = now;
+    }
+    ctx->state_execution_count++;
+    if (ctx->state_timeout_ms > 0 && (now - ctx->state_entry_time) >= ctx->state_timeout_ms) {
+        return 1;
+    }
+    return (ctx->queue_count != 0U) ? 1U : 0U;
+}
+
+static void Shuffle(uint32_t *order, uint32_t count)
+{
+    uint32_t seed = 0x12345678U;
+
+    for (uint32_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    for (uint32_t i = count - 1U; i > 0U; i--) {
+        uint32_t j;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        j = seed % (i + 1U);
+        uint32_t tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+}
+
+int main(void)
+{
+    static LegacyStateConfig_t legacy_table[SM_MAX_STATES];
+    LegacyContext_t *legacy;
+    StateMachineContext_t *split;
+    uint32_t *order;
+    PerfCounters_t perf;
+    uint64_t start;
+    uint32_t sink = 0;
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Cache Layout Benchmark\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+    printf("sizeof(legacy context)      = %zu bytes\n", sizeof(LegacyContext_t));
+    printf("sizeof(StateMachineContext) = %zu bytes (align %u)\n",
+           sizeof(StateMachineContext_t), (unsigned)SM_CACHE_LINE_SIZE);
+    printf("sizeof(legacy state row)    = %zu bytes\n", sizeof(LegacyStateConfig_t));
+    printf("sizeof(StateConfig_t)       = %zu bytes\n", sizeof(StateConfig_t));
+    printf("sizeof(ErrorHandler_t)      = %zu bytes (now outside the context)\n\n",
+           sizeof(ErrorHandler_t));
+
+    legacy = calloc(BENCH_INSTANCES, sizeof(LegacyContext_t));
+    split = aligned_alloc(SM_CACHE_LINE_SIZE, BENCH_INSTANCES * sizeof(StateMachineContext_t));
+    order = malloc(BENCH_INSTANCES * sizeof(uint32_t));
+    if (legacy == NULL || split == NULL || order == NULL) {
+        printf("ERROR: allocation failed\n");
+        return -1;
+    }
+    memset(split, 0, BENCH_INSTANCES * sizeof(StateMachineContext_t));
+    Shuffle(order, BENCH_INSTANCES);
+
+    for (uint32_t i = 0; i < BENCH_INSTANCES; i++) {
+        legacy[i].current_state = STATE_IDLE;
+        split[i].current_state = STATE_IDLE;
+    }
+
+    Perf_Open(&perf);
+    if (perf.llc_fd < 0 && perf.l1d_fd < 0) {
+        printf("NOTE: perf counters unavailable - reporting timings only\n\n");
+    }
+
+    printf("--- %u instances, random tick order ---\n", (unsigned)BENCH_INSTANCES);
+
+    Perf_Start(&perf);
+    start = NowNs();
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        for (uint32_t i = 0; i < BENCH_INSTANCES; i++) {
+            sink += TickLegacy(&legacy[order[i]], legacy_table, round);
+        }
+    }
+    Report("legacy layout", &perf, NowNs() - start,
+           (uint64_t)BENCH_ROUNDS * BENCH_INSTANCES);
+
+    Perf_Start(&perf);
+    start = NowNs();
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        for (uint32_t i = 0; i < BENCH_INSTANCES; i++) {
+            sink += TickSplit(&split[order[i]], round);
+        }
+    }
+    Report("hot/cold split layout", &perf, NowNs() - start,
+           (uint64_t)BENCH_ROUNDS * BENCH_INSTANCES);
+
+    /* Real framework tick, parked in IDLE */
+    printf("\n--- StateMachine_Execute() ---\n");
+    if (!App_Main_Init(COMM_INTERFACE_SPI)) {
+        printf("ERROR: Initialization failed!\n");
+        return -1;
+    }
+    Debug_DisableAllMessages();
+    for (uint32_t i = 0; i < 10U; i++) {
+        StateMachine_Execute();
+    }
+
+    Perf_Start(&perf);
+    start = NowNs();
+    for (uint32_t i = 0; i < BENCH_TICKS; i++) {
+        sink += (uint32_t)StateMachine_Execute();
+    }
+    Report("framework tick (IDLE)", &perf, NowNs() - start, BENCH_TICKS);
+
+    printf("\n(sink %u)\n", (unsigned)sink);
+
+    free(order);
+    free(split);
+    free(legacy);
+    return 0;
+}
@@ -0,0 +1,293 @@
+/**
+ * @file event_bus_benchmark.c
+ * @brief Cross-process event latency over the shared-memory event bus
+ * @version 2.0.0
+ *
+ * This benchmark measures one-way latency (half the round trip) between two
+ * processes playing ping-pong with events:
+ * - Event bus, receiver spinning on its mailbox (yielding the CPU)
+ * - Event bus, receiver blocked in EventBus_Wait() (eventfd wakeup)
+ * - A Unix socketpair exchanging one byte, for comparison
+ *
+ * A second run sends bursts of BENCH_BURST_SIZE events to a process that
+ * runs App_Main_Task(), so EventBus_Poll() has to feed them through the
+ * local event queue (SM_EVENT_QUEUE_SIZE) over several ticks. It reports the
+ * time until the last event of a burst is delivered, and fails if any event
+ * is lost.
+ *
+ * Each result lists mean, median and 99th percentile. On a single CPU every
+ * hop includes a context switch, so expect microseconds rather than the
+ * sub-microsecond figures of a multi-core host.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sm_framework/sm_framework.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_ROUND_TRIPS (20000U)   /**< Round trips per mode */
+#define BENCH_WARMUP      (1000U)    /**< Round trips not measured */
+#define WAIT_TIMEOUT_MS   (1000U)    /**< EventBus_Wait() timeout */
+#define BENCH_BURSTS      (2000U)    /**< Bursts in the burst run */
+#define BENCH_BURST_SIZE  (16U)      /**< Events per burst (< EVENT_BUS_RING_SIZE) */
+
+#define INSTANCE_MAIN     (0U)
+#define INSTANCE_ECHO     (1U)
+
+typedef enum {
+    MODE_SPIN = 0,
+    MODE_WAIT,
+    MODE_MAX
+} BenchMode_t;
+
+static uint64_t g_samples[BENCH_ROUND_TRIPS];
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static int CompareU64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Block (or spin) until an event arrives in this process's mailbox */
+static StateMachineEvent_t ReceiveEvent(BenchMode_t mode)
+{
+    StateMachineEvent_t event;
+
+    while (!EventBus_Receive(&event, NULL)) {
+        if (mode == MODE_WAIT) {
+            (void)EventBus_Wait(WAIT_TIMEOUT_MS);
+        } else {
+            sched_yield();
+        }
+    }
+    return event;
+}
+
+/* Child: answer every ping until STOP */
+static void EchoLoop(BenchMode_t mode)
+{
+    if (!EventBus_Attach(INSTANCE_ECHO)) {
+        _exit(1);
+    }
+    while (ReceiveEvent(mode) != EVENT_STOP) {
+        while (!EventBus_Post(INSTANCE_MAIN, EVENT_PROCESSING_DONE)) {
+            sched_yield();
+        }
+    }
+    _exit(0);
+}
+
+/* Child of the burst run: tick the state machine until every event arrived */
+static void BurstLoop(void)
+{
+    const uint32_t expected = BENCH_BURSTS * BENCH_BURST_SIZE;
+    EventBusStats_t stats;
+    uint32_t acked = 0;
+
+    /* Keep the framework's debug output out of the results */
+    if (freopen("/dev/null", "w", stdout) == NULL ||
+        !EventBus_Attach(INSTANCE_ECHO) || !App_Main_Init(COMM_INTERFACE_UART)) {
+        _exit(1);
+    }
+
+    do {
+        App_Main_Task();  /* EventBus_Poll() + StateMachine_Execute() */
+        (void)EventBus_GetStats(&stats);
+
+        /* Acknowledge each burst once all of it reached the local queue */
+        while ((stats.delivered + stats.dropped) >= ((acked + 1U) * BENCH_BURST_SIZE)) {
+            while (!EventBus_Post(INSTANCE_MAIN, EVENT_PROCESSING_DONE)) {
+                sched_yield();
+            }
+            acked++;
+        }
+        if (!EventBus_Wait(0)) {
+            sched_yield();
+        }
+    } while ((stats.delivered + stats.dropped) < expected);
+
+    _exit((stats.dropped == 0U && stats.delivered == expected) ? 0 : 2);
+}
+
+static void Report(const char *label, uint32_t count, double divisor)
+{
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        total += g_samples[i];
+    }
+    qsort(g_samples, count, sizeof(g_samples[0]), CompareU64);
+    printf("%-28s %10.0f %10.0f %10.0f\n", label,
+           (double)total / (divisor * (double)count),
+           (double)g_samples[count / 2U] / divisor,
+           (double)g_samples[(count * 99U) / 100U] / divisor);
+}
+
+static bool RunBus(BenchMode_t mode)
+{
+    pid_t child = fork();
+    int status = 0;
+
+    if (child < 0) {
+        return false;
+    }
+    if (child == 0) {
+        EchoLoop(mode);
+    }
+
+    for (uint32_t i = 0; i < (BENCH_WARMUP + BENCH_ROUND_TRIPS); i++) {
+        uint64_t start = NowNs();
+
+        while (!EventBus_Post(INSTANCE_ECHO, EVENT_DATA_READY)) {
+            sched_yield();
+        }
+        (void)ReceiveEvent(mode);
+        if (i >= BENCH_WARMUP) {
+            g_samples[i - BENCH_WARMUP] = NowNs() - start;
+        }
+    }
+    while (!EventBus_Post(INSTANCE_ECHO, EVENT_STOP)) {
+        sched_yield();
+    }
+    waitpid(child, &status, 0);
+
+    Report((mode == MODE_WAIT) ? "event bus (eventfd wait)" : "event bus (spin + yield)",
+           BENCH_ROUND_TRIPS, 2.0);
+    return WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+static bool RunSocketPair(void)
+{
+    int fds[2];
+    pid_t child;
+    char byte = 0;
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        return false;
+    }
+
+    child = fork();
+    if (child < 0) {
+        return false;
+    }
+    if (child == 0) {
+        close(fds[0]);
+        while (read(fds[1], &byte, 1) == 1 && byte != 'q') {
+            if (write(fds[1], &byte, 1) != 1) {
+                break;
+            }
+        }
+        _exit(0);
+    }
+
+    close(fds[1]);
+    for (uint32_t i = 0; i < (BENCH_WARMUP + BENCH_ROUND_TRIPS); i++) {
+        uint64_t start = NowNs();
+
+        byte = 'p';
+        if (write(fds[0], &byte, 1) != 1 || read(fds[0], &byte, 1) != 1) {
+            return false;
+        }
+        if (i >= BENCH_WARMUP) {
+            g_samples[i - BENCH_WARMUP] = NowNs() - start;
+        }
+    }
+    byte = 'q';
+    (void)write(fds[0], &byte, 1);
+    close(fds[0]);
+    waitpid(child, NULL, 0);
+
+    Report("unix socketpair (1 byte)", BENCH_ROUND_TRIPS, 2.0);
+    return true;
+}
+
+static bool RunBurst(void)
+{
+    pid_t child;
+    int status = 0;
+
+    fflush(stdout);  /* The child must not inherit buffered output */
+    child = fork();
+    if (child < 0) {
+        return false;
+    }
+    if (child == 0) {
+        BurstLoop();
+    }
+
+    for (uint32_t i = 0; i < BENCH_BURSTS; i++) {
+        uint64_t start = NowNs();
+
+        for (uint32_t j = 0; j < BENCH_BURST_SIZE; j++) {
+            while (!EventBus_Post(INSTANCE_ECHO, EVENT_DATA_READY)) {
+                sched_yield();
+            }
+        }
+        (void)ReceiveEvent(MODE_SPIN);
+        g_samples[i] = NowNs() - start;
+    }
+    waitpid(child, &status, 0);
+
+    Report("burst -> App_Main_Task()", BENCH_BURSTS, 1.0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("ERROR: events of a burst were lost\n");
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    bool ok = true;
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Event Bus Latency Benchmark\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+    if (!EventBus_Create(NULL, 2) || !EventBus_Attach(INSTANCE_MAIN)) {
+        printf("ERROR: could not create the event bus\n");
+        return -1;
+    }
+
+    printf("%u round trips per mode, one-way latency in ns (CPUs online: %ld)\n\n",
+           (unsigned int)BENCH_ROUND_TRIPS, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%-28s %10s %10s %10s\n", "transport", "mean", "p50", "p99");
+    printf("%-28s %10s %10s %10s\n", "---------", "----", "---", "---");
+
+    for (uint32_t mode = 0; mode < MODE_MAX; mode++) {
+        ok = RunBus((BenchMode_t)mode) && ok;
+    }
+    ok = RunSocketPair() && ok;
+
+    printf("\n%u bursts of %u events, SM_EVENT_QUEUE_SIZE %u, time until the whole\n"
+           "burst is in the local queue, in ns\n\n",
+           (unsigned int)BENCH_BURSTS, (unsigned int)BENCH_BURST_SIZE,
+           (unsigned int)SM_EVENT_QUEUE_SIZE);
+    printf("%-28s %10s %10s %10s\n", "transport", "mean", "p50", "p99");
+    printf("%-28s %10s %10s %10s\n", "---------", "----", "---", "---");
+    ok = RunBurst() && ok;
+
+    EventBus_Close();
+
+    printf("\n");
+    if (!ok) {
+        printf("ERROR: a benchmark process failed\n");
+        return 1;
+    }
+    return 0;
+}
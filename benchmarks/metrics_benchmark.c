@@ -0,0 +1,155 @@
+/**
+ * @file metrics_benchmark.c
+ * @brief Cost of rendering the OpenMetrics exposition for 1000 instances
+ * @version 2.0.0
+ *
+ * This benchmark measures:
+ * - Metrics_Render() of the framework metrics, once per instance label, for
+ *   BENCH_INSTANCES instances (what a host scraping 1000 processes pays in
+ *   total, or one process serving 1000 scrapes)
+ * - Bytes per exposition and render throughput
+ * - The same text produced with snprintf(), for comparison
+ *
+ * The framework is single-instance per process, so the instances share one
+ * state machine and differ only in their "instance" label. Build with
+ * -DSM_STATS_LEVEL=2 or more for the full metric set (histograms dominate).
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "sm_framework/sm_framework.h"
+#include "sm_framework/sm_sim.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_INSTANCES  (1000U)     /**< Instances rendered per run */
+#define BENCH_RUNS       (5U)        /**< Runs, best one reported */
+#define TEXT_SIZE        (65536U)    /**< Exposition buffer */
+
+static char g_text[TEXT_SIZE];
+static char g_labels[BENCH_INSTANCES][32];
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/* Same samples as the renderer's integer metrics and histogram buckets, via snprintf */
+static uint32_t RenderSnprintf(char *buffer, uint32_t size, const char *labels)
+{
+    int length = 0;
+    Histogram_t histogram;
+
+#define APPEND(...) \
+    length += snprintf(&buffer[length], (length < (int)size) ? (size - (uint32_t)length) : 0U, __VA_ARGS__)
+
+    for (uint32_t state = 0; state < STATE_MAX; state++) {
+        APPEND("sm_state{%s,sm_state=\"%s\"} %u\n", labels,
+               StateMachine_StateToString((StateMachineState_t)state),
+               (state == (uint32_t)StateMachine_GetCurrentState()) ? 1U : 0U);
+    }
+    for (uint32_t code = 1; code < ERROR_CODE_MAX; code++) {
+        APPEND("sm_errors_total{%s,code=\"%s\"} %lu\n", labels,
+               ErrorHandler_CodeToString((ErrorCode_t)code),
+               (unsigned long)ErrorHandler_GetReportCount((ErrorCode_t)code));
+    }
+#if SM_STATS_LEVEL >= 2
+    for (uint32_t state = 0; state < STATE_MAX; state++) {
+        uint64_t count = 0;
+
+        (void)StateMachine_GetResidencyHistogram((StateMachineState_t)state, &histogram);
+        for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+            count += histogram.counts[bucket];
+            if (((bucket + 1U) % HISTOGRAM_SUB_COUNT) == 0U) {
+                APPEND("sm_state_residency_seconds_bucket{%s,state=\"%s\",le=\"%.3f\"} %llu\n", labels,
+                       StateMachine_StateToString((StateMachineState_t)state),
+                       (double)Histogram_BucketLower(bucket + 1U) / 1000.0, (unsigned long long)count);
+            }
+        }
+    }
+#else
+    (void)histogram;
+#endif
+#undef APPEND
+    return (length < (int)size) ? (uint32_t)length : 0U;
+}
+
+static double RunRender(uint32_t (*render)(char *, uint32_t, const char *), uint64_t *bytes)
+{
+    double best = 0.0;
+
+    for (uint32_t run = 0; run < BENCH_RUNS; run++) {
+        uint64_t start = NowNs();
+        uint64_t total = 0;
+        double elapsed;
+
+        for (uint32_t i = 0; i < BENCH_INSTANCES; i++) {
+            total += render(g_text, sizeof(g_text), g_labels[i]);
+        }
+        elapsed = (double)(NowNs() - start) / 1e6;
+        if (run == 0U || elapsed < best) {
+            best = elapsed;
+        }
+        *bytes = total;
+    }
+    return best;
+}
+
+int main(void)
+{
+    uint64_t bytes = 0;
+    uint64_t snprintf_bytes = 0;
+    double render_ms;
+    double snprintf_ms;
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Metrics Export Benchmark\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+#if SM_STATS_LEVEL < 2
+    printf("NOTE: built with SM_STATS_LEVEL < 2 - no histograms in the exposition\n\n");
+#endif
+
+    if (!App_Main_Init(COMM_INTERFACE_UART)) {
+        printf("ERROR: Initialization failed!\n");
+        return -1;
+    }
+    Debug_DisableAllMessages();
+
+    /* Some history so the histograms are not empty */
+    for (uint32_t i = 0; i < 2000U; i++) {
+        if ((i % 10U) == 0U) {
+            (void)StateMachine_PostEvent(((i / 10U) % 2U) == 0U ? EVENT_START : EVENT_STOP);
+        }
+        App_Main_Task();
+        SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+    }
+    for (uint32_t i = 0; i < BENCH_INSTANCES; i++) {
+        (void)snprintf(g_labels[i], sizeof(g_labels[i]), "instance=\"sm-%04u\"", (unsigned)i);
+    }
+
+    render_ms = RunRender(Metrics_Render, &bytes);
+    if (bytes == 0U) {
+        printf("ERROR: exposition does not fit in %u bytes\n", (unsigned)TEXT_SIZE);
+        return -1;
+    }
+    snprintf_ms = RunRender(RenderSnprintf, &snprintf_bytes);
+
+    printf("Instances:                 %u\n", (unsigned)BENCH_INSTANCES);
+    printf("Bytes per exposition:      %lu\n", (unsigned long)(bytes / BENCH_INSTANCES));
+    printf("Metrics_Render():          %8.2f ms total, %7.2f us per instance, %6.0f MB/s\n",
+           render_ms, render_ms * 1000.0 / BENCH_INSTANCES, (double)bytes / (render_ms * 1000.0));
+    printf("snprintf() subset:         %8.2f ms total, %7.2f us per instance, %6.0f MB/s\n",
+           snprintf_ms, snprintf_ms * 1000.0 / BENCH_INSTANCES,
+           (double)snprintf_bytes / (snprintf_ms * 1000.0));
+
+    printf("\n========================================================\n");
+    printf(" Metrics benchmark complete\n");
+    printf("========================================================\n\n");
+
+    return 0;
+}
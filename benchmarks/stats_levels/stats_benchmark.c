@@ -0,0 +1,121 @@
+/**
+ * @file stats_benchmark.c
+ * @brief Per-tick cost of each statistics level (SM_STATS_LEVEL)
+ * @version 2.0.0
+ *
+ * This benchmark measures, for the SM_STATS_LEVEL it is compiled with:
+ * - An idle tick: App_Main_Task() with nothing queued
+ * - An event tick: post + App_Main_Task() dispatching an IDLE <-> ACTIVE
+ *   transition (counters, latency stamp, residency, matrix all hit)
+ * - The RAM the level adds
+ *
+ * CMake builds one binary per level (stats_benchmark_level0 ... 3) from the
+ * same framework sources; run all four for the comparison table.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "sm_framework/sm_framework.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_TICKS  (1000000U)  /**< Ticks per run */
+#define BENCH_RUNS   (15U)       /**< Runs, best one reported */
+
+static const char *const g_level_names[] = {
+    "none",
+    "counters",
+    "+ histograms",
+    "+ matrix, trace"
+};
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static double RunTicks(bool with_events)
+{
+    double best = 0.0;
+
+    for (uint32_t run = 0; run < BENCH_RUNS; run++) {
+        uint64_t start = NowNs();
+        double elapsed;
+
+        for (uint32_t i = 0; i < BENCH_TICKS; i++) {
+            if (with_events) {
+                (void)StateMachine_PostEvent(((i & 1U) == 0U) ? EVENT_START : EVENT_STOP);
+            }
+            App_Main_Task();
+        }
+        elapsed = (double)(NowNs() - start) / (double)BENCH_TICKS;
+        if (run == 0U || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+/* Static data the level adds (sm_state_machine.c, sm_cadence.c) */
+static uint32_t StatsRamBytes(void)
+{
+    uint32_t bytes = 0;
+
+#if SM_STATS_LEVEL >= 1
+    bytes += (uint32_t)sizeof(StateMachineStats_t);
+#endif
+#if SM_STATS_LEVEL >= 2
+    /* Latency, residency per state and cadence jitter; post time stamps */
+    bytes += (uint32_t)((SM_MAX_STATES + 2U) * sizeof(Histogram_t));
+    bytes += (uint32_t)(SM_EVENT_QUEUE_SIZE * sizeof(uint32_t));
+#endif
+#if SM_STATS_LEVEL >= 3
+    bytes += (uint32_t)(STATE_MAX * EVENT_MAX * sizeof(TransitionMatrixCell_t));
+#endif
+    return bytes;
+}
+
+int main(void)
+{
+    double idle_ns;
+    double event_ns;
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Statistics Level Benchmark\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+    if (!App_Main_Init(COMM_INTERFACE_UART)) {
+        printf("ERROR: Initialization failed!\n");
+        return -1;
+    }
+    Debug_DisableAllMessages();
+
+    /* Through INIT into IDLE */
+    for (uint32_t i = 0; i < 10U; i++) {
+        App_Main_Task();
+    }
+    if (StateMachine_GetCurrentState() != STATE_IDLE) {
+        printf("ERROR: expected IDLE, in %s\n", StateMachine_StateToString(StateMachine_GetCurrentState()));
+        return -1;
+    }
+
+    (void)RunTicks(true);  /* Warm up */
+    event_ns = RunTicks(true);
+    idle_ns = RunTicks(false);
+
+    printf("SM_STATS_LEVEL:              %u (%s)\n", (unsigned)SM_STATS_LEVEL, g_level_names[SM_STATS_LEVEL]);
+    printf("Idle tick:                   %8.2f ns/tick\n", idle_ns);
+    printf("Event tick (transition):     %8.2f ns/tick\n", event_ns);
+    printf("Statistics RAM:              %8lu bytes\n", (unsigned long)StatsRamBytes());
+    printf("\n| %u | %s | %.1f | %.1f | %lu |\n", (unsigned)SM_STATS_LEVEL, g_level_names[SM_STATS_LEVEL],
+           idle_ns, event_ns, (unsigned long)StatsRamBytes());
+
+    printf("\n========================================================\n");
+    printf(" Statistics level benchmark complete\n");
+    printf("========================================================\n\n");
+
+    return 0;
+}
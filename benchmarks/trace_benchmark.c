@@ -0,0 +1,104 @@
+/**
+ * @file trace_benchmark.c
+ * @brief Cost of the binary transition trace per transition
+ * @version 2.0.0
+ *
+ * This benchmark measures:
+ * - TransitionTrace_Record() in isolation (the per-transition trace cost)
+ * - Real IDLE <-> ACTIVE transitions through StateMachine_Execute() with
+ *   tracing inactive and active
+ *
+ * The trace budget is 50 ns per transition; the benchmark exits non-zero if
+ * the isolated record cost exceeds it.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "sm_framework/sm_framework.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_RECORDS      (10000000U)  /**< Isolated record calls */
+#define BENCH_TRANSITIONS  (2000000U)   /**< Framework transitions per run */
+#define BENCH_BUDGET_NS    (50.0)       /**< Trace budget per transition */
+#define TRACE_RECORDS      (4096U)      /**< Ring capacity */
+
+static uint8_t g_trace_memory[sizeof(TransitionTraceHeader_t) +
+                              (TRACE_RECORDS * sizeof(TransitionRecord_t))];
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static double RunTransitions(void)
+{
+    uint64_t start = NowNs();
+
+    for (uint32_t i = 0; i < BENCH_TRANSITIONS; i += 2U) {
+        StateMachine_PostEvent(EVENT_START);
+        StateMachine_Execute();
+        StateMachine_PostEvent(EVENT_STOP);
+        StateMachine_Execute();
+    }
+    return (double)(NowNs() - start) / (double)BENCH_TRANSITIONS;
+}
+
+int main(void)
+{
+    uint64_t start;
+    double record_ns;
+    double off_ns;
+    double on_ns;
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Transition Trace Benchmark\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+#if !FEATURE_TRANSITION_TRACE
+    printf("NOTE: built without FEATURE_TRANSITION_TRACE - framework runs are untraced\n\n");
+#endif
+
+    if (!App_Main_Init(COMM_INTERFACE_SPI)) {
+        printf("ERROR: Initialization failed!\n");
+        return -1;
+    }
+    Debug_DisableAllMessages();
+    for (uint32_t i = 0; i < 10U; i++) {
+        StateMachine_Execute();
+    }
+
+    /* Isolated record cost */
+    TransitionTrace_Init(g_trace_memory, sizeof(g_trace_memory));
+    start = NowNs();
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++) {
+        TransitionTrace_Record(STATE_IDLE, STATE_ACTIVE, EVENT_START, i);
+    }
+    record_ns = (double)(NowNs() - start) / (double)BENCH_RECORDS;
+
+    /* Framework transitions, tracing off then on */
+    TransitionTrace_Stop();
+    (void)RunTransitions();  /* Warm up */
+    off_ns = RunTransitions();
+
+    TransitionTrace_Init(g_trace_memory, sizeof(g_trace_memory));
+    on_ns = RunTransitions();
+    TransitionTrace_Stop();
+
+    printf("Record size:                 %u bytes, ring %u records\n",
+           (unsigned)sizeof(TransitionRecord_t), (unsigned)TRACE_RECORDS);
+    printf("TransitionTrace_Record():    %8.2f ns/transition\n", record_ns);
+    printf("Transition, trace inactive:  %8.2f ns/transition\n", off_ns);
+    printf("Transition, trace active:    %8.2f ns/transition (%+.2f ns)\n",
+           on_ns, on_ns - off_ns);
+
+    if (record_ns > BENCH_BUDGET_NS) {
+        printf("\n✗ Trace cost exceeds %.0f ns budget\n", BENCH_BUDGET_NS);
+        return -1;
+    }
+    printf("\n✓ Trace cost within %.0f ns budget\n", BENCH_BUDGET_NS);
+    return 0;
+}
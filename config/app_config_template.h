@@ -31,12 +31,21 @@
 /* Maximum number of states (must be >= STATE_MAX) */
 #define SM_MAX_STATES (10U)
 
+/* Maximum number of events (must be >= EVENT_MAX) */
+#define SM_MAX_EVENTS (32U)
+
 /* Maximum transitions per state */
 #define SM_MAX_TRANSITIONS_PER_STATE (5U)
 
+/* Maximum transition observers (sm_observer.h, max 32) */
+#define SM_MAX_OBSERVERS (8U)
+
 /* Default state timeout in milliseconds */
 #define SM_STATE_TIMEOUT_MS (5000U)
 
+/* Default per-tick execution budget of on_state in microseconds (0 = none) */
+#define SM_STATE_BUDGET_US (0U)
+
 /* Task execution period in milliseconds
  * Adjust based on your system requirements:
  * - Fast response systems: 1-10ms
@@ -45,11 +54,33 @@
  */
 #define SM_TASK_PERIOD_MS (10U)
 
+/* Task intervals longer than this count as deadline misses (us)
+ * Measured by the cadence monitor when statistics are enabled
+ */
+#define SM_CADENCE_DEADLINE_US (SM_TASK_PERIOD_MS * 1500U)
+
+/* Histogram resolution (log2 buckets per power of two) and range (log2 max value) */
+#define HISTOGRAM_SUB_BITS (3U)
+#define HISTOGRAM_MAX_BITS (24U)
+
+/* Pending event queue depth (1 = single pending event) */
+#define SM_EVENT_QUEUE_SIZE (1U)
+
+/* Drop events the current state does not handle at post time (1)
+ * instead of queueing them (0)
+ */
+#define SM_REJECT_UNHANDLED_EVENTS (0U)
+
+/* Data cache line size used to align the runtime context
+ * - Cortex-M7: 32, x86-64 / Cortex-A: 64
+ */
+#define SM_CACHE_LINE_SIZE (64U)
+
 /* =============================================================================
  * ERROR HANDLING CONFIGURATION
  * ===========================================================================*/
 
-/* Maximum recovery attempts for normal errors */
+/* Maximum recovery attempts for normal errors (1-255) */
 #define ERROR_MAX_RECOVERY_ATTEMPTS (3U)
 
 /* Minor error retry count */
@@ -66,6 +97,24 @@
  */
 #define ERROR_HISTORY_SIZE (16U)
 
+/* Error storm suppression (token bucket per error code)
+ * BURST reports pass immediately, then one per REFILL_MS; repeats are
+ * folded into one history entry with a count. BURST 0 disables.
+ */
+#define ERROR_RATE_LIMIT_BURST (5U)
+#define ERROR_RATE_LIMIT_REFILL_MS (100U)
+
+/* Buckets per error-rate window (1 s, 1 min, 1 h); must divide 1000 */
+#define ERROR_RATE_BUCKETS (10U)
+
+/* Recovery scheduling (default policy: exponential backoff with jitter)
+ * Failed attempts are retried after BASE, 2*BASE, ... up to MAX_DELAY.
+ * Per-code strategies: ErrorHandler_SetRecoveryPolicy().
+ */
+#define ERROR_RECOVERY_BASE_DELAY_MS (100U)
+#define ERROR_RECOVERY_MAX_DELAY_MS (1000U)
+#define ERROR_RECOVERY_JITTER_PERCENT (20U)
+
 /* =============================================================================
  * DEBUG SYSTEM CONFIGURATION
  * ===========================================================================*/
@@ -82,6 +131,9 @@
 #define DEBUG_ENABLE_INIT_MESSAGES (1U)      /* Initialization messages */
 #define DEBUG_ENABLE_RUNTIME_MESSAGES (1U)   /* Runtime messages */
 #define DEBUG_ENABLE_PERIODIC_MESSAGES (1U)  /* Periodic status */
+#define DEBUG_ENABLE_ERROR_MESSAGES (1U)     /* Errors */
+#define DEBUG_ENABLE_WARNING_MESSAGES (1U)   /* Warnings */
+#define DEBUG_ENABLE_INFO_MESSAGES (1U)      /* Informational */
 
 /* Periodic message interval (ms) */
 #define DEBUG_PERIODIC_INTERVAL_MS (1000U)
@@ -103,15 +155,106 @@
 #define COMM_VERIFICATION_COUNT (3U)         /* Good messages needed */
 #define COMM_VERIFICATION_WINDOW_MS (50U)    /* Verification window */
 
+/* Per-channel circuit breakers (sm_comm_breaker.h)
+ * Open when FAILURE_PERCENT of at least MIN_REQUESTS exchanges in the
+ * sliding WINDOW_MS failed; fail fast for OPEN_MS, then probe.
+ */
+#define COMM_BREAKER_WINDOW_MS (1000U)
+#define COMM_BREAKER_BUCKETS (10U)
+#define COMM_BREAKER_MIN_REQUESTS (5U)
+#define COMM_BREAKER_FAILURE_PERCENT (50U)
+#define COMM_BREAKER_OPEN_MS (500U)
+#define COMM_BREAKER_HALF_OPEN_PROBES (1U)
+
+/* Shared-memory event bus between processes (sm_event_bus.h)
+ * RING_SIZE events per mailbox (power of 2), one mailbox per instance
+ */
+#define EVENT_BUS_MAX_INSTANCES (8U)
+#define EVENT_BUS_RING_SIZE (64U)
+
+/* Worker pool for long-running state work (sm_worker_pool.h)
+ * QUEUE_SIZE counts queued, running and undelivered jobs
+ */
+#define WORKER_POOL_THREADS (2U)
+#define WORKER_POOL_QUEUE_SIZE (16U)
+
+/* Local metrics endpoint (sm_metrics_server.h)
+ * BUFFER_SIZE holds one OpenMetrics exposition, TIMEOUT_MS bounds a scrape
+ */
+#define METRICS_SERVER_BUFFER_SIZE (65536U)
+#define METRICS_SERVER_TIMEOUT_MS (50U)
+
 /* =============================================================================
  * FEATURE FLAGS
  * ===========================================================================*/
 
-/* Enable runtime statistics collection
- * Set to 1 to collect transition counts, timing, etc.
- * Adds ~100 bytes RAM overhead
+/* Statistics granularity (FEATURE_STATISTICS_ENABLED is derived from it)
+ * 0 = none, 1 = counters, 2 = plus latency / residency / jitter histograms,
+ * 3 = plus the dispatch matrix, transition trace and perf trace hooks
+ * Level 1 adds ~100 bytes RAM, level 2 about 5 KB (HISTOGRAM_BUCKETS)
+ */
+#define SM_STATS_LEVEL (0U)
+
+/* Compile the binary transition trace hook (sm_trace.h)
+ * Costs one branch per transition until a trace buffer is attached;
+ * required by SM_STATS_LEVEL 3
+ */
+#define FEATURE_TRANSITION_TRACE (0U)
+
+/* Compile state span / callback timing hooks (sm_perf_trace.h)
+ * Costs one branch per callback until PerfTrace_Start() is called
+ */
+#define FEATURE_PERF_TRACE (0U)
+
+/* Time on_state of states with a budget and count overruns
+ * Costs one compare per tick for states without a budget
+ */
+#define FEATURE_STATE_BUDGETS (1U)
+
+/* Count handled / ignored events per state and event (heat map)
+ * Costs STATE_MAX * EVENT_MAX * 16 bytes RAM; required by SM_STATS_LEVEL 3
+ */
+#define FEATURE_TRANSITION_MATRIX (0U)
+
+/* Keep 1 s / 1 min / 1 h error rates per error code and state
+ * Costs 3 * ERROR_RATE_BUCKETS * (ERROR_CODE_MAX + STATE_MAX + 1) words RAM
+ */
+#define FEATURE_ERROR_RATES (1U)
+
+/* Compile the transition observer fan-out (sm_observer.h)
+ * Costs three loads per transition while no observer is interested
+ */
+#define FEATURE_TRANSITION_OBSERVERS (1U)
+
+/* Compile the crash-persistent error/transition log hooks (sm_error_persist.h)
+ * Costs one branch per error and transition until a region is attached
+ */
+#define FEATURE_ERROR_PERSIST (1U)
+
+/* Virtual clock and event record/replay for host simulation (src/sim)
+ * Target builds provide Platform_GetTimeMs() and leave src/sim out
+ */
+#define FEATURE_SIMULATION (0U)
+
+/* Deliver events from other processes over the shared-memory event bus
+ * Needs the POSIX extensions (src/posix/sm_event_bus.c)
+ */
+#define FEATURE_EVENT_BUS (0U)
+
+/* Run heavy state work on worker threads, completions delivered per tick
+ * Needs the POSIX extensions (src/posix/sm_worker_pool.c)
+ */
+#define FEATURE_WORKER_POOL (0U)
+
+/* Answer OpenMetrics scrapes over local HTTP / a Unix socket
+ * Needs the POSIX extensions (src/posix/sm_metrics_server.c)
+ */
+#define FEATURE_METRICS_SERVER (0U)
+
+/* Store states, events and error codes as uint8_t
+ * Set to 1 on memory-constrained targets (shrinks tables and history)
  */
-#define FEATURE_STATISTICS_ENABLED (0U)
+#define FEATURE_PACKED_ENCODING (0U)
 
 /* Enable runtime assertions
  * Set to 1 for development, 0 for production
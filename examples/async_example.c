@@ -0,0 +1,167 @@
+/**
+ * @file async_example.c
+ * @brief Async state action awaiting I/O, a timer and an event
+ * @version 2.0.0
+ *
+ * This example demonstrates:
+ * - Replacing the tick-polled COMMUNICATING on_state with one async action
+ * - Awaiting a DMA completion flag, a settle delay and a reply event
+ * - The action running only when resumed: a fast-forward loop skips every
+ *   tick in which nothing it waits for has happened
+ */
+
+#include "sm_framework/sm_framework.h"
+#include "sm_framework/sm_sim.h"
+#include <stdio.h>
+
+#define DMA_DURATION_MS   (30U)   /**< Simulated transfer time */
+#define REPLY_DELAY_MS    (45U)   /**< Peer answers this long after the transfer */
+#define COMM_TIMEOUT_LONG (500U)  /**< COMMUNICATING timeout for this example */
+
+/* "Hardware": completion flag written by the DMA ISR */
+static volatile bool g_dma_done = false;
+static bool g_dma_running = false;
+static uint32_t g_dma_due = 0;
+static bool g_reply_pending = false;
+static uint32_t g_reply_due = 0;
+
+static uint32_t g_resumes = 0;
+
+static void Log(const char *text)
+{
+    printf("[%5lu ms] %s\n", (unsigned long)SimClock_Now(), text);
+}
+
+static void Dma_Start(void)
+{
+    g_dma_done = false;
+    g_dma_running = true;
+    g_dma_due = SimClock_Now() + DMA_DURATION_MS;
+}
+
+/* Whole exchange as one sequence - no step counters, no polling */
+static AsyncStatus_t Communicating_Async(AsyncContext_t *async)
+{
+    g_resumes++;
+
+    ASYNC_BEGIN(async);
+
+    Log("COMMUNICATING: request sent, waiting for DMA");
+    Dma_Start();
+    ASYNC_AWAIT_IO(async, &g_dma_done);
+
+    Log("COMMUNICATING: transfer done, settling 20 ms");
+    g_reply_pending = true;
+    g_reply_due = SimClock_Now() + REPLY_DELAY_MS;
+    ASYNC_AWAIT_TIME(async, 20);
+
+    Log("COMMUNICATING: waiting for reply (EVENT_DATA_READY)");
+    ASYNC_AWAIT_EVENT(async, EVENT_DATA_READY);
+
+    Log("COMMUNICATING: reply received, verifying channel");
+    ASYNC_AWAIT_UNTIL(async, ErrorHandler_VerifyCommChannel());
+
+    Log("COMMUNICATING: complete");
+    StateMachine_PostEvent(EVENT_COMM_COMPLETE);
+
+    ASYNC_END(async);
+}
+
+/* Fire the simulated interrupts that are due */
+static void Hardware_Poll(void)
+{
+    uint32_t now = SimClock_Now();
+
+    if (g_dma_running && (int32_t)(now - g_dma_due) >= 0) {
+        g_dma_running = false;
+        g_dma_done = true;
+    }
+    if (g_reply_pending && (int32_t)(now - g_reply_due) >= 0) {
+        g_reply_pending = false;
+        StateMachine_PostEvent(EVENT_DATA_READY);
+    }
+}
+
+/* Ticks until the next simulated interrupt (bounds fast-forward) */
+static uint32_t TicksToNextInterrupt(uint32_t max_ticks)
+{
+    uint32_t now = SimClock_Now();
+    uint32_t ticks = max_ticks;
+
+    if (g_dma_running) {
+        uint32_t t = (g_dma_due - now) / SM_TASK_PERIOD_MS;
+        ticks = (t < ticks) ? t : ticks;
+    }
+    if (g_reply_pending) {
+        uint32_t t = (g_reply_due - now) / SM_TASK_PERIOD_MS;
+        ticks = (t < ticks) ? t : ticks;
+    }
+    return ticks;
+}
+
+int main(void)
+{
+    const uint32_t end_time = 600U;
+    uint32_t executed = 0;
+    uint32_t skipped = 0;
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Async State Action Example\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+    SimClock_SetAutoIncrement(0);
+    SimClock_Reset(0);
+
+    if (!App_Main_Init(COMM_INTERFACE_UART)) {
+        printf("ERROR: Initialization failed!\n");
+        return -1;
+    }
+    Debug_EnableRuntimeMessages(false);
+    Debug_EnablePeriodicMessages(false);
+
+    /* COMMUNICATING: async action instead of the tick-polled callback */
+    StateMachine_SetStateCallbacks(STATE_COMMUNICATING, NULL, NULL, NULL);
+    StateMachine_SetStateAsync(STATE_COMMUNICATING, Communicating_Async);
+    StateMachine_SetStateFlags(STATE_COMMUNICATING, 0);
+    StateMachine_SetStateTimeout(STATE_COMMUNICATING, COMM_TIMEOUT_LONG);
+
+    /* INIT -> IDLE -> ACTIVE -> PROCESSING -> COMMUNICATING */
+    for (uint32_t i = 0; i < 10U; i++) {
+        App_Main_Task();
+        SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+    }
+    StateMachine_PostEvent(EVENT_START);
+    App_Main_Task();
+    SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+    StateMachine_PostEvent(EVENT_DATA_READY);
+
+    /* Fast-forward: execute a tick only when something can happen */
+    while ((int32_t)(end_time - SimClock_Now()) > 0) {
+        uint32_t remaining = (end_time - SimClock_Now()) / SM_TASK_PERIOD_MS;
+        uint32_t skip;
+
+        Hardware_Poll();
+        skip = SimDriver_SkippableTicks(TicksToNextInterrupt(remaining));
+        if (skip > 0U) {
+            StateMachine_SkipTicks(skip);
+            SimClock_AdvanceBy(skip * SM_TASK_PERIOD_MS);
+            skipped += skip;
+        } else {
+            App_Main_Task();
+            SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+            executed++;
+        }
+    }
+
+    printf("\nFinal state:     %s\n", StateMachine_StateToString(StateMachine_GetCurrentState()));
+    printf("Action resumed:  %lu times\n", (unsigned long)g_resumes);
+    printf("Ticks executed:  %lu\n", (unsigned long)executed);
+    printf("Ticks skipped:   %lu\n", (unsigned long)skipped);
+
+    printf("\n========================================================\n");
+    printf(" Async example complete\n");
+    printf("========================================================\n\n");
+
+    return (StateMachine_GetCurrentState() == STATE_MONITORING) ? 0 : 1;
+}
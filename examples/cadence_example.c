@@ -0,0 +1,99 @@
+/**
+ * @file cadence_example.c
+ * @brief Measuring App_Main_Task() cadence on a real-time clock (Linux)
+ * @version 2.0.0
+ *
+ * This example demonstrates:
+ * - Platform_GetTimeMs()/Platform_GetTimeUs() on CLOCK_MONOTONIC instead of
+ *   the simulation clock
+ * - A periodic task loop on absolute deadlines (clock_nanosleep)
+ * - The cadence monitor: interval, jitter percentiles, deadline misses and
+ *   the jitter histogram
+ *
+ * Usage: cadence_example [seconds]
+ * Run it next to a loaded system (e.g. a parallel build) to see the tail.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sm_framework/sm_framework.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Real clock: overrides the weak simulation defaults */
+uint32_t Platform_GetTimeUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U));
+}
+
+uint32_t Platform_GetTimeMs(void)
+{
+    return Platform_GetTimeUs() / 1000U;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t seconds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : 2U;
+    uint32_t ticks = (seconds * 1000U) / SM_TASK_PERIOD_MS;
+    Histogram_t histogram;
+    StateMachineStats_t stats;
+    struct timespec next;
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Cadence Monitor Example\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+    if (!App_Main_Init(COMM_INTERFACE_UART)) {
+        printf("ERROR: Initialization failed!\n");
+        return -1;
+    }
+    Debug_EnableRuntimeMessages(false);
+
+    printf("Running %lu ticks of %u ms...\n\n", (unsigned long)ticks, (unsigned)SM_TASK_PERIOD_MS);
+
+    /* Absolute deadlines: a late tick does not shift the ones after it */
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (uint32_t i = 0; i < ticks; i++) {
+        App_Main_Task();
+
+        next.tv_nsec += (long)SM_TASK_PERIOD_MS * 1000000L;
+        if (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+    }
+
+    (void)StateMachine_GetStats(&stats);
+    printf("\nIntervals:       %lu\n", (unsigned long)stats.cadence.intervals);
+    printf("Interval us:     min %lu / avg %lu / max %lu\n",
+           (unsigned long)stats.cadence.interval_min_us,
+           (unsigned long)stats.cadence.interval_avg_us,
+           (unsigned long)stats.cadence.interval_max_us);
+    printf("Jitter us:       p50 %lu / p99 %lu / p99.9 %lu / max %lu\n",
+           (unsigned long)stats.cadence.jitter_p50_us,
+           (unsigned long)stats.cadence.jitter_p99_us,
+           (unsigned long)stats.cadence.jitter_p999_us,
+           (unsigned long)stats.cadence.jitter_max_us);
+    printf("Deadline misses: %lu (interval > %lu us)\n",
+           (unsigned long)stats.cadence.deadline_misses, (unsigned long)SM_CADENCE_DEADLINE_US);
+
+    printf("\nJitter histogram:\n");
+    (void)Cadence_GetHistogram(&histogram);
+    for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        if (histogram.counts[bucket] != 0U) {
+            printf("  >= %8lu us: %lu\n", (unsigned long)Histogram_BucketLower(bucket),
+                   (unsigned long)histogram.counts[bucket]);
+        }
+    }
+
+    printf("\n========================================================\n");
+    printf(" Cadence example complete\n");
+    printf("========================================================\n\n");
+
+    return 0;
+}
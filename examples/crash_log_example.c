@@ -0,0 +1,128 @@
+/**
+ * @file crash_log_example.c
+ * @brief Post-mortem error and transition log that survives a crash
+ * @version 2.0.0
+ *
+ * This example demonstrates:
+ * - Attaching a memory-mapped log file before App_Main_Init()
+ * - Recovery of the previous run's errors and transitions at init
+ * - Records surviving an abort() without any fsync
+ *
+ * Usage: crash_log_example <log_file> [--crash]
+ *   --crash  run into a critical error and abort() instead of exiting
+ *
+ * Run it once with --crash, then again without to see the post-mortem.
+ */
+
+#include "sm_framework/sm_framework.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOG_ERRORS       (32U)   /**< Error ring capacity */
+#define LOG_TRANSITIONS  (64U)   /**< Transition ring capacity */
+
+static ErrorPersistRecord_t g_records[LOG_TRANSITIONS];
+
+static void print_previous_run(void)
+{
+    ErrorPersistInfo_t info;
+    uint32_t count;
+
+    if (!ErrorPersist_GetInfo(&info)) {
+        return;
+    }
+
+    printf("\n--- Persistent log (boot %lu%s) ---\n", (unsigned long)info.boot_count,
+           info.formatted ? ", new log" : "");
+    printf("Recovered %lu errors, %lu transitions, %lu corrupt records\n",
+           (unsigned long)info.recovered_errors, (unsigned long)info.recovered_transitions,
+           (unsigned long)info.corrupt_records);
+
+    count = ErrorPersist_Read(ERROR_PERSIST_RING_ERRORS, g_records, LOG_ERRORS);
+    for (uint32_t i = 0; i < count; i++) {
+        const ErrorPersistRecord_t *record = &g_records[i];
+
+        if (record->kind == (uint8_t)ERROR_PERSIST_BOOT) {
+            printf("  #%-4lu ---- boot %u ----\n", (unsigned long)record->seq, (unsigned)record->extra);
+        } else {
+            printf("  #%-4lu [%6lu ms] %-8s %-20s in %s\n", (unsigned long)record->seq,
+                   (unsigned long)record->timestamp,
+                   ErrorHandler_LevelToString((ErrorLevel_t)record->a),
+                   ErrorHandler_CodeToString((ErrorCode_t)record->b),
+                   StateMachine_StateToString((StateMachineState_t)record->c));
+        }
+    }
+
+    count = ErrorPersist_Read(ERROR_PERSIST_RING_TRANSITIONS, g_records, 8U);
+    printf("Last %lu transitions:\n", (unsigned long)count);
+    for (uint32_t i = 0; i < count; i++) {
+        const ErrorPersistRecord_t *record = &g_records[i];
+
+        printf("  #%-4lu [%6lu ms] %-14s -> %-14s %s\n", (unsigned long)record->seq,
+               (unsigned long)record->timestamp,
+               StateMachine_StateToString((StateMachineState_t)record->a),
+               StateMachine_StateToString((StateMachineState_t)record->b),
+               StateMachine_EventToString((StateMachineEvent_t)record->c));
+    }
+    printf("\n");
+}
+
+static void run_ticks(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        App_Main_Task();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    bool crash;
+
+    if (argc < 2) {
+        printf("Usage: %s <log_file> [--crash]\n", argv[0]);
+        return -1;
+    }
+    crash = (argc > 2) && (strcmp(argv[2], "--crash") == 0);
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Crash Log Example\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+#if !FEATURE_ERROR_PERSIST
+    printf("NOTE: built without FEATURE_ERROR_PERSIST - nothing is logged\n\n");
+#endif
+
+    /* Attach before init so ErrorHandler_Init() recovers the previous run */
+    if (!ErrorPersist_MapFile(argv[1], LOG_ERRORS, LOG_TRANSITIONS)) {
+        printf("ERROR: cannot map %s\n", argv[1]);
+        return -1;
+    }
+
+    if (!App_Main_Init(COMM_INTERFACE_UART)) {
+        printf("ERROR: Initialization failed!\n");
+        return -1;
+    }
+    Debug_EnablePeriodicMessages(false);
+    print_previous_run();
+
+    /* Some activity and a recoverable error */
+    run_ticks(10);
+    StateMachine_PostEvent(EVENT_START);
+    run_ticks(10);
+    ErrorHandler_Report(ERROR_LEVEL_NORMAL, ERROR_CODE_TIMEOUT);
+    run_ticks(10);
+
+    if (crash) {
+        ErrorHandler_Report(ERROR_LEVEL_CRITICAL, ERROR_CODE_HARDWARE_FAULT);
+        run_ticks(5);
+        printf("Simulating a crash (abort) - run again to see the post-mortem\n");
+        fflush(stdout);
+        abort();
+    }
+
+    ErrorPersist_UnmapFile();
+    printf("Clean exit\n");
+    return 0;
+}
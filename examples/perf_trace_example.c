@@ -0,0 +1,105 @@
+/**
+ * @file perf_trace_example.c
+ * @brief Export state residency and callback timing as a Chrome trace
+ * @version 2.0.0
+ *
+ * This example demonstrates:
+ * - Providing Platform_GetTimeMs()/Platform_GetTimeUs() from a real clock
+ * - Buffering state spans and callback slices with PerfTrace_Start()
+ * - Flushing the buffer in bulk between ticks
+ *
+ * Usage: perf_trace_example [output.json]
+ *   Open the output in chrome://tracing or https://ui.perfetto.dev
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "sm_framework/sm_framework.h"
+#include <stdio.h>
+#include <time.h>
+
+#define TRACE_EVENTS      (512U)   /**< Buffered events between flushes */
+#define FLUSH_EVERY_TICKS (50U)    /**< Flush cadence */
+
+static PerfTraceEvent_t g_events[TRACE_EVENTS];
+
+/* Real monotonic time instead of the simulation clock */
+static uint64_t monotonic_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000ULL) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+uint32_t Platform_GetTimeMs(void)
+{
+    return (uint32_t)(monotonic_us() / 1000U);
+}
+
+uint32_t Platform_GetTimeUs(void)
+{
+    return (uint32_t)monotonic_us();
+}
+
+/* Run ticks in real time, flushing the trace in bulk between ticks */
+static void run_ticks(uint32_t count)
+{
+    struct timespec period = {0, (long)SM_TASK_PERIOD_MS * 1000000L};
+
+    for (uint32_t i = 0; i < count; i++) {
+        App_Main_Task();
+        if ((StateMachine_GetTickCount() % FLUSH_EVERY_TICKS) == 0U) {
+            (void)PerfTrace_Flush();
+        }
+        nanosleep(&period, NULL);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = (argc > 1) ? argv[1] : "sm_trace.json";
+    FILE *file;
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Performance Trace Example\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+#if !FEATURE_PERF_TRACE
+    printf("NOTE: built without FEATURE_PERF_TRACE - the trace will be empty\n\n");
+#endif
+
+    file = fopen(path, "w");
+    if (file == NULL) {
+        printf("ERROR: cannot create %s\n", path);
+        return -1;
+    }
+
+    if (!App_Main_Init(COMM_INTERFACE_UART)) {
+        printf("ERROR: Initialization failed!\n");
+        fclose(file);
+        return -1;
+    }
+    Debug_EnablePeriodicMessages(false);
+
+    PerfTrace_Start(g_events, TRACE_EVENTS, PerfTrace_WriteFile, file);
+
+    /* Init, full processing cycle, error recovery */
+    run_ticks(10);
+    StateMachine_PostEvent(EVENT_START);
+    run_ticks(10);
+    StateMachine_PostEvent(EVENT_DATA_READY);
+    run_ticks(40);
+    ErrorHandler_Report(ERROR_LEVEL_NORMAL, ERROR_CODE_TIMEOUT);
+    run_ticks(20);
+    StateMachine_PostEvent(EVENT_STOP);
+    run_ticks(5);
+
+    PerfTrace_Stop();
+    fclose(file);
+
+    printf("\nTrace written to %s (%lu events dropped)\n", path,
+           (unsigned long)PerfTrace_GetDropped());
+    printf("Open it in chrome://tracing or https://ui.perfetto.dev\n\n");
+    return 0;
+}
@@ -1,60 +1,178 @@
+/**
+ * @file simulation_example.c
+ * @brief Deterministic simulation with event record/replay
+ * @version 2.0.0
+ *
+ * This example demonstrates:
+ * - Running the state machine on the deterministic virtual clock
+ * - Recording every posted event into a compact binary trace
+ * - Replaying the trace at many times real speed and checking it matches
+ * - Fast-forward replay and a multi-day soak run that skip idle ticks
+ *
+ * Usage: simulation_example [trace_file]
+ *   If trace_file is given, the recorded trace is saved there.
+ */
+
 #define _POSIX_C_SOURCE 199309L
 
 #include "sm_framework/sm_framework.h"
+#include "sm_framework/sm_sim.h"
 #include <stdio.h>
 #include <time.h>
-#include <unistd.h>
 
-/* Override Platform_GetTimeMs() with real millisecond timing */
-uint32_t Platform_GetTimeMs(void)
+#define TRACE_BUFFER_SIZE (4096U)
+#define SOAK_DURATION_MS  (3U * 24U * 60U * 60U * 1000U)
+
+static uint8_t g_trace_buffer[TRACE_BUFFER_SIZE];
+
+/* Run ticks on the virtual clock, one task period apart */
+static void run_ticks(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        App_Main_Task();
+        SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+    }
+}
+
+static double wall_ms(void)
 {
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (uint32_t)((ts.tv_sec * 1000) + (ts.tv_nsec / 1000000));
+    return ((double)ts.tv_sec * 1000.0) + ((double)ts.tv_nsec / 1000000.0);
 }
 
-static void test_basic_operation(void)
+static StateMachineState_t record_scenario(SimTrace_t *trace)
 {
-    printf("\n--- TEST: Basic Operation ---\n");
+    printf("\n--- Recording scenario ---\n");
 
-    /* Let initialization complete */
-    for (int i = 0; i < 10; i++) {
-        App_Main_Task();
-        usleep(10000);
-    }
+    SimTrace_StartRecording(trace, g_trace_buffer, sizeof(g_trace_buffer));
 
+    /* Let initialization complete */
+    run_ticks(10);
     printf("State after init: %s\n", StateMachine_StateToString(StateMachine_GetCurrentState()));
 
-    /* Post events and observe transitions */
+    /* Full processing cycle */
     StateMachine_PostEvent(EVENT_START);
-    for (int i = 0; i < 10; i++) {
-        App_Main_Task();
-        usleep(10000);
-    }
+    run_ticks(10);
+    StateMachine_PostEvent(EVENT_DATA_READY);
+    run_ticks(40);
+    printf("State after DATA_READY: %s\n", StateMachine_StateToString(StateMachine_GetCurrentState()));
+
+    /* Normal error and recovery */
+    ErrorHandler_Report(ERROR_LEVEL_NORMAL, ERROR_CODE_TIMEOUT);
+    run_ticks(10);
 
-    printf("State after START: %s\n", StateMachine_StateToString(StateMachine_GetCurrentState()));
-    printf("✓ Test passed\n");
+    /* Long idle period (10 minutes of virtual time) */
+    StateMachine_PostEvent(EVENT_START);
+    run_ticks(60000);
+    StateMachine_PostEvent(EVENT_STOP);
+    run_ticks(5);
+
+    SimTrace_StopRecording();
+
+    printf("Recorded %lu records in %lu bytes over %lu ticks\n",
+           (unsigned long)trace->record_count, (unsigned long)trace->length,
+           (unsigned long)StateMachine_GetTickCount());
+    return StateMachine_GetCurrentState();
 }
 
-int main(void)
+int main(int argc, char *argv[])
 {
+    SimTrace_t trace;
+    SimReplayResult_t result;
+    SimReplayResult_t fast;
+    SimDriverStats_t soak = {0};
+    bool ok;
+    StateMachineState_t recorded_state;
+    double start;
+    double elapsed;
+
     printf("\n========================================================\n");
     printf(" State Machine Framework - Simulation Example\n");
     printf(" Version: %s\n", App_Main_GetVersion());
     printf("========================================================\n\n");
 
+    /* Deterministic time: only advances when we say so */
+    SimClock_SetAutoIncrement(0);
+    SimClock_Reset(0);
+
     /* Initialize framework */
     if (!App_Main_Init(COMM_INTERFACE_UART)) {
         printf("ERROR: Initialization failed!\n");
         return -1;
     }
+    Debug_EnableRuntimeMessages(false);
+    Debug_EnablePeriodicMessages(false);
+
+    recorded_state = record_scenario(&trace);
+
+    if (argc > 1) {
+        if (SimTrace_Save(&trace, argv[1])) {
+            printf("Trace saved to %s\n", argv[1]);
+        } else {
+            printf("WARNING: could not save trace to %s\n", argv[1]);
+        }
+    }
+
+    printf("\n--- Replaying trace ---\n");
+    start = wall_ms();
+    if (!SimTrace_Replay(&trace, &result)) {
+        printf("ERROR: Replay failed - corrupt trace\n");
+        return -1;
+    }
+    elapsed = wall_ms() - start;
+
+    printf("Replayed %lu ticks, %lu external events, %lu error reports, internal posts %lu/%lu\n",
+           (unsigned long)result.ticks, (unsigned long)result.events_injected,
+           (unsigned long)result.errors_injected,
+           (unsigned long)result.internal_observed, (unsigned long)result.internal_expected);
+    printf("Virtual time %lu ms in %.2f ms wall time (%.0fx real time)\n",
+           (unsigned long)result.end_time, elapsed,
+           (elapsed > 0.0) ? ((double)result.end_time / elapsed) : 0.0);
+    printf("Final state: recorded %s, replayed %s\n",
+           StateMachine_StateToString(recorded_state),
+           StateMachine_StateToString(result.final_state));
+
+    if (result.final_state != recorded_state ||
+        result.internal_observed != result.internal_expected) {
+        printf("✗ Replay diverged from recording\n");
+        return -1;
+    }
+
+    printf("\n--- Fast-forward replay ---\n");
+    SimTrace_SetFastForward(true);
+    start = wall_ms();
+    ok = SimTrace_Replay(&trace, &fast);
+    elapsed = wall_ms() - start;
+    SimTrace_SetFastForward(false);
+    if (!ok) {
+        printf("ERROR: Replay failed - corrupt trace\n");
+        return -1;
+    }
 
-    printf("Framework initialized - running test\n");
+    printf("Replayed %lu ticks (%lu skipped) in %.2f ms wall time\n",
+           (unsigned long)fast.ticks, (unsigned long)fast.ticks_skipped, elapsed);
+    if (fast.final_state != result.final_state || fast.ticks != result.ticks ||
+        fast.end_time != result.end_time ||
+        fast.internal_observed != result.internal_observed) {
+        printf("✗ Fast-forward replay diverged from full replay\n");
+        return -1;
+    }
+
+    /* Soak: three days of virtual time in ACTIVE */
+    printf("\n--- Fast-forward soak (3 days) ---\n");
+    StateMachine_PostEvent(EVENT_START);
+    start = wall_ms();
+    SimDriver_RunUntil(SimClock_Now() + SOAK_DURATION_MS, &soak);
+    elapsed = wall_ms() - start;
 
-    test_basic_operation();
+    printf("Ran %lu ticks (%lu executed, %lu skipped) in %.2f ms wall time\n",
+           (unsigned long)(soak.ticks_executed + soak.ticks_skipped),
+           (unsigned long)soak.ticks_executed, (unsigned long)soak.ticks_skipped, elapsed);
+    printf("State after soak: %s\n", StateMachine_StateToString(StateMachine_GetCurrentState()));
 
     printf("\n========================================================\n");
-    printf(" Test completed successfully!\n");
+    printf(" Replay matches recording!\n");
     printf("========================================================\n\n");
 
     return 0;
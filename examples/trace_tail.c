@@ -0,0 +1,121 @@
+/**
+ * @file trace_tail.c
+ * @brief Tail a memory-mapped transition trace from another process
+ * @version 2.0.0
+ *
+ * This example demonstrates:
+ * - Mapping a trace file written by TransitionTrace_MapFile() read-only
+ * - Reading new records without stopping or signalling the writer
+ * - Detecting records the writer overwrote before they were read
+ *
+ * Usage: trace_tail <trace_file> [-f]
+ *   -f  keep following the trace (like tail -f)
+ *
+ * Writer side (in the traced application):
+ *   TransitionTrace_MapFile("/tmp/sm.trace", 1024);
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sm_framework/sm_framework.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+static void print_record(const TransitionRecord_t *record)
+{
+    printf("#%-8lu [%10lu ms] %-14s -> %-14s %-22s after %lu ticks\n",
+           (unsigned long)record->seq, (unsigned long)record->timestamp,
+           StateMachine_StateToString((StateMachineState_t)record->from),
+           StateMachine_StateToString((StateMachineState_t)record->to),
+           StateMachine_EventToString((StateMachineEvent_t)record->event),
+           (unsigned long)record->exec_count);
+}
+
+int main(int argc, char *argv[])
+{
+    const TransitionTraceHeader_t *header;
+    const TransitionRecord_t *ring;
+    struct timespec poll_interval = {0, 10000000L};  /* 10 ms */
+    struct stat info;
+    bool follow;
+    uint32_t next = 0;
+    uint32_t lost = 0;
+    uint32_t read_count = 0;
+    void *map;
+    int fd;
+
+    if (argc < 2) {
+        printf("Usage: %s <trace_file> [-f]\n", argv[0]);
+        return -1;
+    }
+    follow = (argc > 2) && (strcmp(argv[2], "-f") == 0);
+
+    fd = open(argv[1], O_RDONLY);
+    if (fd < 0 || fstat(fd, &info) != 0 ||
+        (size_t)info.st_size < sizeof(TransitionTraceHeader_t)) {
+        printf("ERROR: cannot open trace %s\n", argv[1]);
+        return -1;
+    }
+    map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        printf("ERROR: cannot map trace %s\n", argv[1]);
+        return -1;
+    }
+
+    header = (const TransitionTraceHeader_t *)map;
+    ring = (const TransitionRecord_t *)(const void *)(header + 1);
+    if (header->magic != TRANSITION_TRACE_MAGIC ||
+        header->version != TRANSITION_TRACE_VERSION ||
+        header->record_size != sizeof(TransitionRecord_t) ||
+        (size_t)info.st_size < sizeof(TransitionTraceHeader_t) +
+                               ((size_t)header->capacity * sizeof(TransitionRecord_t))) {
+        printf("ERROR: %s is not a transition trace\n", argv[1]);
+        munmap(map, (size_t)info.st_size);
+        return -1;
+    }
+
+    do {
+        uint32_t end = SM_ATOMIC_LOAD(&header->write_count);
+
+        /* Skip what the writer already overwrote */
+        if ((end - next) > header->capacity) {
+            lost += (end - next) - header->capacity;
+            next = end - header->capacity;
+        }
+
+        while (next != end) {
+            TransitionRecord_t record = ring[next & (header->capacity - 1U)];
+            uint32_t written;
+
+            /*
+             * Overwritten while we copied it - count as lost and move on.
+             * The writer of seq `written` is already reusing the slot of
+             * `written - capacity`, so that record is not intact either.
+             */
+            SM_ATOMIC_FENCE();
+            written = SM_ATOMIC_LOAD(&header->write_count);
+            if (record.seq != next || (written - next) >= header->capacity) {
+                lost++;
+            } else {
+                print_record(&record);
+                read_count++;
+            }
+            next++;
+        }
+        fflush(stdout);
+
+        if (follow) {
+            nanosleep(&poll_interval, NULL);
+        }
+    } while (follow);
+
+    printf("%lu records read, %lu lost\n", (unsigned long)read_count, (unsigned long)lost);
+    munmap(map, (size_t)info.st_size);
+    return 0;
+}
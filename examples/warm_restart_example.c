@@ -0,0 +1,146 @@
+/**
+ * @file warm_restart_example.c
+ * @brief Warm restart from a state machine snapshot
+ * @version 2.0.0
+ *
+ * This example demonstrates:
+ * - Taking a snapshot in the middle of PROCESSING with events still queued
+ * - "Rebooting" (clock back to zero, App_Main_Init()) and restoring it
+ * - The restored run continuing tick for tick like the uninterrupted one
+ * - A cold start for comparison, walking INIT -> IDLE again
+ * - Rejection of a corrupted snapshot
+ */
+
+#include "sm_framework/sm_framework.h"
+#include "sm_framework/sm_sim.h"
+#include <stdio.h>
+
+#define COMPARE_TICKS (40U)
+
+static uint8_t g_snapshot[SM_SNAPSHOT_MAX_SIZE];
+
+/* Run ticks on the virtual clock, one task period apart */
+static void run_ticks(uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        App_Main_Task();
+        SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+    }
+}
+
+/* Record the state after each of the next COMPARE_TICKS ticks */
+static void record_states(StateMachineState_t *states)
+{
+    for (uint32_t i = 0; i < COMPARE_TICKS; i++) {
+        run_ticks(1);
+        states[i] = StateMachine_GetCurrentState();
+    }
+}
+
+static bool boot(uint32_t clock_ms)
+{
+    SimClock_Reset(clock_ms);
+    if (!App_Main_Init(COMM_INTERFACE_UART)) {
+        printf("ERROR: Initialization failed!\n");
+        return false;
+    }
+    Debug_EnableRuntimeMessages(false);
+    Debug_EnablePeriodicMessages(false);
+    return true;
+}
+
+static void print_states(const char *label, const StateMachineState_t *states)
+{
+    printf("%-10s", label);
+    for (uint32_t i = 0; i < COMPARE_TICKS; i += 4U) {
+        printf(" %.4s", StateMachine_StateToString(states[i]));
+    }
+    printf("\n");
+}
+
+int main(void)
+{
+    StateMachineState_t reference[COMPARE_TICKS];
+    StateMachineState_t restored[COMPARE_TICKS];
+    uint32_t length;
+    uint32_t cold_ticks = 0;
+    bool same = true;
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Warm Restart Example\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+    /* Deterministic time: only advances when we say so */
+    SimClock_SetAutoIncrement(0);
+    if (!boot(0)) {
+        return -1;
+    }
+
+    /* Run into PROCESSING and leave work queued */
+    run_ticks(10);
+    StateMachine_PostEvent(EVENT_START);
+    run_ticks(5);
+    StateMachine_PostEvent(EVENT_DATA_READY);
+    run_ticks(8);
+    ErrorHandler_Report(ERROR_LEVEL_MINOR, ERROR_CODE_INVALID_DATA);
+    StateMachine_PostEvent(EVENT_PROCESSING_DONE);
+    StateMachine_PostEvent(EVENT_COMM_REQUEST);
+
+    length = StateMachine_Snapshot(g_snapshot, sizeof(g_snapshot));
+    if (length == 0U) {
+        printf("ERROR: Snapshot failed\n");
+        return -1;
+    }
+    printf("Snapshot at %lu ms: %s, %lu executions, %u errors in history, %lu bytes\n",
+           (unsigned long)SimClock_Now(),
+           StateMachine_StateToString(StateMachine_GetCurrentState()),
+           (unsigned long)StateMachine_GetExecutionCount(),
+           (unsigned int)ErrorHandler_GetHistoryCount(), (unsigned long)length);
+
+    /* Uninterrupted run */
+    record_states(reference);
+
+    /* Warm restart: new boot, clock from zero, restore before the first tick */
+    if (!boot(0) || !StateMachine_Restore(g_snapshot, length)) {
+        printf("ERROR: Restore failed\n");
+        return -1;
+    }
+    printf("Restored: %s, %lu executions, %u errors in history\n",
+           StateMachine_StateToString(StateMachine_GetCurrentState()),
+           (unsigned long)StateMachine_GetExecutionCount(),
+           (unsigned int)ErrorHandler_GetHistoryCount());
+    record_states(restored);
+
+    printf("\nState every 4th tick after the snapshot:\n");
+    print_states("reference", reference);
+    print_states("restored", restored);
+    for (uint32_t i = 0; i < COMPARE_TICKS; i++) {
+        same = same && (reference[i] == restored[i]);
+    }
+    printf("Restored run matches: %s\n", same ? "SAME" : "DIFFERENT");
+
+    /* Cold start for comparison */
+    if (!boot(0)) {
+        return -1;
+    }
+    while (StateMachine_GetCurrentState() != STATE_IDLE && cold_ticks < 1000U) {
+        run_ticks(1);
+        cold_ticks++;
+    }
+    printf("\nCold start: %lu ticks to reach IDLE (queued events and errors lost)\n",
+           (unsigned long)cold_ticks);
+    printf("Warm start: resumes %s on the first tick\n",
+           StateMachine_StateToString(restored[0]));
+
+    /* A damaged snapshot is refused and leaves the state machine alone */
+    g_snapshot[length / 2U] ^= 0x01U;
+    printf("Corrupted snapshot restored: %s\n",
+           StateMachine_Restore(g_snapshot, length) ? "yes" : "no (rejected)");
+
+    printf("\n========================================================\n");
+    printf(" Warm restart example complete\n");
+    printf("========================================================\n\n");
+
+    return same ? 0 : 1;
+}
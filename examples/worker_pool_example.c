@@ -0,0 +1,186 @@
+/**
+ * @file worker_pool_example.c
+ * @brief Offloading PROCESSING work to the worker pool
+ * @version 2.0.0
+ *
+ * This example demonstrates:
+ * - The cost of heavy work inside on_state: one tick takes the whole job
+ * - The same work submitted from on_entry: ticks stay short, the state
+ *   machine keeps running, EVENT_PROCESSING_DONE arrives when the job ends
+ * - A failing job: its error code goes through ErrorHandler_Report() and
+ *   the state machine moves to RECOVERY
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sm_framework/sm_framework.h"
+#include "sm_framework/sm_sim.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BLOCK_SAMPLES (1024U * 1024U)
+#define FILTER_PASSES (16U)
+#define MAX_TICKS     (250U)     /**< Below the 3000 ms PROCESSING timeout */
+
+typedef struct {
+    uint32_t samples[BLOCK_SAMPLES];
+    uint32_t checksum;
+    bool corrupt;                 /**< Simulated bad input */
+} Block_t;
+
+typedef struct {
+    const char *label;
+    StateMachineState_t next_state;
+    uint32_t ticks;
+    uint64_t max_tick_us;
+    uint64_t total_us;
+} RunResult_t;
+
+static Block_t g_block;
+static uint32_t g_job = WORKER_JOB_INVALID;
+
+static uint64_t NowUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U);
+}
+
+/* The heavy part: a few smoothing passes over the block */
+static ErrorCode_t ProcessBlock(void *arg)
+{
+    Block_t *block = (Block_t *)arg;
+    uint32_t sum = 0;
+
+    for (uint32_t pass = 0; pass < FILTER_PASSES; pass++) {
+        for (uint32_t i = 1; i < BLOCK_SAMPLES; i++) {
+            block->samples[i] = (block->samples[i] + block->samples[i - 1U]) >> 1;
+            sum += block->samples[i];
+        }
+    }
+    block->checksum = sum;
+
+    return block->corrupt ? ERROR_CODE_INVALID_DATA : ERROR_CODE_NONE;
+}
+
+/* PROCESSING, classic: the job blocks the tick it runs in */
+static void Inline_OnState(void)
+{
+    if (StateMachine_GetExecutionCount() == 1U) {
+        if (ProcessBlock(&g_block) == ERROR_CODE_NONE) {
+            StateMachine_PostEvent(EVENT_PROCESSING_DONE);
+        }
+    }
+}
+
+/* PROCESSING, offloaded: submit on entry, completion arrives as an event */
+static void Offload_OnEntry(void)
+{
+    g_job = WorkerPool_Submit(ProcessBlock, &g_block);
+}
+
+static void Offload_OnExit(void)
+{
+    (void)WorkerPool_Cancel(g_job);   /* No-op once delivered */
+}
+
+/* Boot, walk to PROCESSING and tick until it is left */
+static void Run(RunResult_t *result, bool offload, bool corrupt)
+{
+    uint64_t start_us;
+
+    SimClock_SetAutoIncrement(0);
+    SimClock_Reset(0);
+    if (!App_Main_Init(COMM_INTERFACE_UART)) {
+        printf("ERROR: Initialization failed!\n");
+        return;
+    }
+    Debug_EnableInitMessages(false);
+    Debug_EnableRuntimeMessages(false);
+    Debug_EnablePeriodicMessages(false);
+
+    if (offload) {
+        StateMachine_SetStateCallbacks(STATE_PROCESSING, Offload_OnEntry, NULL, Offload_OnExit);
+    } else {
+        StateMachine_SetStateCallbacks(STATE_PROCESSING, NULL, Inline_OnState, NULL);
+    }
+    for (uint32_t i = 0; i < BLOCK_SAMPLES; i++) {
+        g_block.samples[i] = i * 2654435761U;
+    }
+    g_block.corrupt = corrupt;
+
+    /* INIT -> IDLE -> ACTIVE -> PROCESSING */
+    for (uint32_t i = 0; i < 10U; i++) {
+        App_Main_Task();
+        SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+    }
+    StateMachine_PostEvent(EVENT_START);
+    App_Main_Task();
+    SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+    StateMachine_PostEvent(EVENT_DATA_READY);
+
+    start_us = NowUs();
+    do {
+        struct timespec period = {0, 1000000L};
+        uint64_t tick_start = NowUs();
+        uint64_t tick_us;
+
+        App_Main_Task();
+        SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+        tick_us = NowUs() - tick_start;
+        result->max_tick_us = (tick_us > result->max_tick_us) ? tick_us : result->max_tick_us;
+        result->ticks++;
+
+        nanosleep(&period, NULL);   /* Rest of the "task period" */
+    } while (StateMachine_GetCurrentState() == STATE_PROCESSING &&
+             result->ticks < MAX_TICKS);
+
+    result->next_state = StateMachine_GetCurrentState();
+    result->total_us = NowUs() - start_us;
+}
+
+int main(void)
+{
+    RunResult_t results[3] = {
+        {"inline on_state", STATE_INIT, 0, 0, 0},
+        {"worker pool", STATE_INIT, 0, 0, 0},
+        {"worker pool, bad", STATE_INIT, 0, 0, 0},
+    };
+    WorkerPoolStats_t stats;
+
+    printf("\n========================================================\n");
+    printf(" State Machine Framework - Worker Pool Example\n");
+    printf(" Version: %s\n", App_Main_GetVersion());
+    printf("========================================================\n\n");
+
+    if (!WorkerPool_Init()) {
+        printf("ERROR: Worker pool failed to start!\n");
+        return -1;
+    }
+
+    Run(&results[0], false, false);
+    Run(&results[1], true, false);
+    Run(&results[2], true, true);
+
+    printf("\n%-18s %-14s %8s %12s %12s\n", "PROCESSING work", "Next state", "Ticks",
+           "Max tick us", "Total us");
+    for (uint32_t i = 0; i < 3U; i++) {
+        printf("%-18s %-14s %8lu %12lu %12lu\n", results[i].label,
+               StateMachine_StateToString(results[i].next_state),
+               (unsigned long)results[i].ticks, (unsigned long)results[i].max_tick_us,
+               (unsigned long)results[i].total_us);
+    }
+
+    (void)WorkerPool_GetStats(&stats);
+    printf("\nJobs: %lu submitted, %lu succeeded, %lu failed, %lu discarded\n",
+           (unsigned long)stats.submitted, (unsigned long)stats.succeeded,
+           (unsigned long)stats.failed, (unsigned long)stats.discarded);
+
+    WorkerPool_Shutdown();
+
+    printf("\n========================================================\n");
+    printf(" Worker pool example complete\n");
+    printf("========================================================\n\n");
+
+    return (stats.succeeded == 1U && stats.failed == 1U) ? 0 : 1;
+}
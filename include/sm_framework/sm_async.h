@@ -0,0 +1,122 @@
+/**
+ * @file sm_async.h
+ * @brief Async state actions (stackless coroutines)
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * A plain on_state callback is re-entered every tick, so multi-step work has
+ * to keep step counters and poll. An async state action is written as one
+ * straight sequence that suspends at await points; the state machine resumes
+ * it only when what it waits for has happened:
+ *
+ * @code
+ *   static AsyncStatus_t Comm_Async(AsyncContext_t *async)
+ *   {
+ *       ASYNC_BEGIN(async);
+ *       Uart_StartTransfer(&g_transfer_done);           // ISR sets the flag
+ *       ASYNC_AWAIT_IO(async, &g_transfer_done);        // No ticks spent waiting
+ *       ASYNC_AWAIT_TIME(async, 20);                    // Settle for 20 ms
+ *       ASYNC_AWAIT_EVENT(async, EVENT_DATA_READY);     // Reply arrived
+ *       ASYNC_AWAIT_UNTIL(async, ErrorHandler_VerifyCommChannel());
+ *       StateMachine_PostEvent(EVENT_COMM_COMPLETE);
+ *       ASYNC_END(async);
+ *   }
+ *
+ *   StateMachine_SetStateAsync(STATE_COMMUNICATING, Comm_Async);
+ * @endcode
+ *
+ * Protothread rules apply (the action is a switch on __LINE__):
+ * - Locals do not survive an await; keep state in static or context data
+ * - At most one await per source line; no awaits inside another switch
+ * - The action restarts from ASYNC_BEGIN() on every entry into the state
+ *
+ * The action runs after event dispatch in StateMachine_Execute() and only in
+ * ticks without a transition. An awaited event is accepted by
+ * StateMachine_PostEvent() even if the state has no transition for it; if
+ * the state does have one, the transition wins.
+ *
+ * This is a C99 macro set. A C++20 coroutine adapter is not provided: the
+ * framework is built as C99 and carries no C++ sources.
+ */
+
+#ifndef SM_ASYNC_H
+#define SM_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+#include "sm_platform.h"
+
+/** Start of the action body */
+#define ASYNC_BEGIN(async) \
+    switch ((async)->resume_point) { \
+        case 0:
+
+/** End of the action body: finished until the state is entered again */
+#define ASYNC_END(async) \
+    } \
+    (async)->wait = (uint8_t)ASYNC_WAIT_DONE; \
+    return ASYNC_DONE
+
+/** Suspend until the next tick */
+#define ASYNC_YIELD(async) \
+    do { \
+        (async)->wait = (uint8_t)ASYNC_WAIT_TICK; \
+        (async)->resume_point = (uint16_t)__LINE__; \
+        return ASYNC_WAITING; \
+        case __LINE__:; \
+    } while (0)
+
+/** Suspend until a condition holds (re-checked every tick) */
+#define ASYNC_AWAIT_UNTIL(async, condition) \
+    do { \
+        if (!(condition)) { \
+            (async)->wait = (uint8_t)ASYNC_WAIT_TICK; \
+            (async)->resume_point = (uint16_t)__LINE__; \
+            return ASYNC_WAITING; \
+            case __LINE__: \
+            if (!(condition)) { \
+                return ASYNC_WAITING; \
+            } \
+        } \
+    } while (0)
+
+/** Suspend for a number of milliseconds (not resumed before then) */
+#define ASYNC_AWAIT_TIME(async, ms) \
+    do { \
+        (async)->wake_time = Platform_GetTimeMs() + (uint32_t)(ms); \
+        (async)->wait = (uint8_t)ASYNC_WAIT_TIME; \
+        (async)->resume_point = (uint16_t)__LINE__; \
+        return ASYNC_WAITING; \
+        case __LINE__:; \
+    } while (0)
+
+/** Suspend until an event has been dispatched in this state */
+#define ASYNC_AWAIT_EVENT(async, event) \
+    do { \
+        (async)->wait_event = (uint8_t)(event); \
+        (async)->wait = (uint8_t)ASYNC_WAIT_EVENT; \
+        (async)->resume_point = (uint16_t)__LINE__; \
+        return ASYNC_WAITING; \
+        case __LINE__:; \
+    } while (0)
+
+/** Suspend until a completion flag (set by an ISR, DMA callback, thread...) is true */
+#define ASYNC_AWAIT_IO(async, done_flag) \
+    do { \
+        (async)->io_done = (done_flag); \
+        (async)->wait = (uint8_t)ASYNC_WAIT_IO; \
+        (async)->resume_point = (uint16_t)__LINE__; \
+        return ASYNC_WAITING; \
+        case __LINE__:; \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_ASYNC_H */
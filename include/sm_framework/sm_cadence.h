@@ -0,0 +1,76 @@
+/**
+ * @file sm_cadence.h
+ * @brief Task cadence monitor (interval, jitter, deadline misses)
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * SM_TASK_PERIOD_MS is what App_Main_Task() is supposed to run at; this
+ * module measures what it actually runs at. App_Main_Task() records the
+ * interval since its previous call (Platform_GetTimeUs()) when
+ * SM_STATS_LEVEL is 2 or more:
+ *
+ * - Shortest, longest and mean interval
+ * - Jitter (|interval - period|) in a log-linear histogram (sm_histogram.h)
+ * - Deadline misses: intervals longer than SM_CADENCE_DEADLINE_US
+ *
+ * The summary is part of StateMachine_GetStats() and of the periodic debug
+ * message. Ticks skipped on purpose (StateMachine_SkipTicks()) are not
+ * counted as a late call.
+ */
+
+#ifndef SM_CADENCE_H
+#define SM_CADENCE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+#include "sm_histogram.h"
+
+/* =============================================================================
+ * CADENCE MONITOR API
+ * ===========================================================================*/
+
+/**
+ * @brief Clear all measurements (called by StateMachine_Init() and
+ *        StateMachine_ResetStats())
+ */
+void Cadence_Reset(void);
+
+/**
+ * @brief Record one task call (called by App_Main_Task())
+ */
+void Cadence_Record(void);
+
+/**
+ * @brief Forget the previous call time
+ *
+ * The next interval is not measured. Called when ticks are skipped on
+ * purpose, so a tickless sleep is not reported as a deadline miss.
+ */
+void Cadence_Resync(void);
+
+/**
+ * @brief Get the cadence summary
+ *
+ * @param stats Filled with the summary
+ * @return true if filled, false if stats is NULL
+ */
+bool Cadence_GetStats(CadenceStats_t *stats);
+
+/**
+ * @brief Get a copy of the jitter histogram (microseconds)
+ *
+ * @param histogram Filled with the histogram
+ * @return true if filled, false if histogram is NULL
+ */
+bool Cadence_GetHistogram(Histogram_t *histogram);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_CADENCE_H */
@@ -0,0 +1,159 @@
+/**
+ * @file sm_comm_breaker.h
+ * @brief Per-channel circuit breakers for communication interfaces
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Each CommInterface_t has a breaker that tracks the failure rate of its
+ * exchanges over a sliding window (COMM_BREAKER_BUCKETS time buckets):
+ *
+ * - CLOSED: requests pass; when at least min_requests were seen in the window
+ *   and failure_percent of them failed, the breaker opens
+ * - OPEN: CommBreaker_AllowRequest() fails fast for open_ms, so callers skip
+ *   sends that would only run into COMM_TIMEOUT_MS
+ * - HALF_OPEN: up to half_open_probes trial requests pass; a success closes
+ *   the breaker, a failure opens it again
+ *
+ * Usage:
+ * @code
+ *   if (CommBreaker_AllowRequest(COMM_INTERFACE_SPI)) {
+ *       if (Send(...)) {
+ *           CommBreaker_RecordSuccess(COMM_INTERFACE_SPI);
+ *       } else {
+ *           CommBreaker_RecordFailure(COMM_INTERFACE_SPI);
+ *       }
+ *   }
+ * @endcode
+ *
+ * COMM_LOST and COMM_CORRUPT reports count as failures of the debug
+ * interface channel and every successful ErrorHandler_VerifyCommChannel()
+ * counts as a success; verification fails fast while that breaker is open.
+ *
+ * Breaker updates run inside Platform_EnterCritical(), so results may be
+ * recorded from ISRs or other tasks. Queries do not modify the breaker.
+ */
+
+#ifndef SM_COMM_BREAKER_H
+#define SM_COMM_BREAKER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+
+/* =============================================================================
+ * BREAKER TYPES
+ * ===========================================================================*/
+
+/**
+ * @brief Circuit breaker states
+ */
+typedef enum {
+    COMM_BREAKER_CLOSED = 0,    /**< Healthy - requests pass */
+    COMM_BREAKER_OPEN,          /**< Failing - requests rejected */
+    COMM_BREAKER_HALF_OPEN,     /**< Probing - limited trial requests */
+    COMM_BREAKER_STATE_MAX
+} CommBreakerState_t;
+
+/**
+ * @brief Circuit breaker configuration
+ */
+typedef struct {
+    uint32_t window_ms;         /**< Sliding window length */
+    uint32_t open_ms;           /**< Time open before probing */
+    uint16_t min_requests;      /**< Requests in window before the rate counts */
+    uint8_t failure_percent;    /**< Failure rate that opens the breaker (1-100) */
+    uint8_t half_open_probes;   /**< Trial requests allowed while half-open */
+} CommBreakerConfig_t;
+
+/**
+ * @brief Circuit breaker statistics
+ */
+typedef struct {
+    CommBreakerState_t state;   /**< Current state */
+    uint32_t window_requests;   /**< Requests in the sliding window */
+    uint32_t window_failures;   /**< Failures in the sliding window */
+    uint32_t trips;             /**< Times the breaker opened */
+    uint32_t rejected;          /**< Requests failed fast */
+} CommBreakerStats_t;
+
+/* =============================================================================
+ * BREAKER API
+ * ===========================================================================*/
+
+/**
+ * @brief Reset all breakers to CLOSED with the default configuration
+ *
+ * Called by ErrorHandler_Init().
+ */
+void CommBreaker_Init(void);
+
+/**
+ * @brief Configure the breaker of a channel (resets its state)
+ *
+ * @param channel Communication interface
+ * @param config Configuration to copy
+ * @return true if configured, false if invalid parameters
+ */
+bool CommBreaker_Configure(CommInterface_t channel, const CommBreakerConfig_t *config);
+
+/**
+ * @brief Check whether a request on a channel should be attempted
+ *
+ * @param channel Communication interface
+ * @return false if the breaker is open (fail fast), true otherwise
+ *
+ * @note While half-open, each true return uses one trial slot; report its
+ *       outcome with CommBreaker_RecordSuccess() / CommBreaker_RecordFailure().
+ */
+bool CommBreaker_AllowRequest(CommInterface_t channel);
+
+/**
+ * @brief Record a successful exchange
+ *
+ * @param channel Communication interface
+ */
+void CommBreaker_RecordSuccess(CommInterface_t channel);
+
+/**
+ * @brief Record a failed exchange
+ *
+ * @param channel Communication interface
+ */
+void CommBreaker_RecordFailure(CommInterface_t channel);
+
+/**
+ * @brief Get the state of a channel's breaker
+ *
+ * An open breaker whose open period has ended reports HALF_OPEN.
+ *
+ * @param channel Communication interface
+ * @return Breaker state (COMM_BREAKER_CLOSED for invalid channels)
+ */
+CommBreakerState_t CommBreaker_GetState(CommInterface_t channel);
+
+/**
+ * @brief Get statistics of a channel's breaker
+ *
+ * @param channel Communication interface
+ * @param stats Receives the statistics
+ * @return true if successful, false if invalid parameters
+ */
+bool CommBreaker_GetStats(CommInterface_t channel, CommBreakerStats_t *stats);
+
+/**
+ * @brief Convert breaker state to string
+ *
+ * @param state Breaker state
+ * @return State name string
+ */
+const char *CommBreaker_StateToString(CommBreakerState_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_COMM_BREAKER_H */
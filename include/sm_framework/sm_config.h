@@ -31,6 +31,15 @@
 #define SM_MAX_STATES (10U)
 #endif
 
+/**
+ * @brief Maximum number of events the state machine can handle
+ *
+ * Sizes the per-state handled-event bitset. Must be >= EVENT_MAX.
+ */
+#ifndef SM_MAX_EVENTS
+#define SM_MAX_EVENTS (32U)
+#endif
+
 /**
  * @brief Maximum number of transitions per state
  *
@@ -40,6 +49,15 @@
 #define SM_MAX_TRANSITIONS_PER_STATE (5U)
 #endif
 
+/**
+ * @brief Maximum number of transition observers (see sm_observer.h)
+ *
+ * Each observer costs about 24 bytes plus one bit in the match masks. Max 32.
+ */
+#ifndef SM_MAX_OBSERVERS
+#define SM_MAX_OBSERVERS (8U)
+#endif
+
 /**
  * @brief Default state timeout in milliseconds
  *
@@ -49,6 +67,17 @@
 #define SM_STATE_TIMEOUT_MS (5000U)
 #endif
 
+/**
+ * @brief Default per-tick execution budget of every state in microseconds
+ *
+ * Time allowed for on_state plus the async action in one tick, measured with
+ * Platform_GetTimeUs(). 0 = no budget (clock not read). Override per state
+ * with StateMachine_SetStateBudget().
+ */
+#ifndef SM_STATE_BUDGET_US
+#define SM_STATE_BUDGET_US (0U)
+#endif
+
 /**
  * @brief State machine task execution period in milliseconds
  *
@@ -61,6 +90,76 @@
 #define SM_TASK_PERIOD_MS (10U)
 #endif
 
+/**
+ * @brief Longest acceptable interval between two App_Main_Task() calls (us)
+ *
+ * Longer intervals are counted as deadline misses by the cadence monitor
+ * (sm_cadence.h, SM_STATS_LEVEL >= 2). Default: 1.5 task periods.
+ */
+#ifndef SM_CADENCE_DEADLINE_US
+#define SM_CADENCE_DEADLINE_US (SM_TASK_PERIOD_MS * 1500U)
+#endif
+
+/**
+ * @brief Histogram resolution: linear buckets per power of two (log2)
+ *
+ * Bucket width is at most 1 / 2^HISTOGRAM_SUB_BITS of the value (12.5% for
+ * 3). Each extra bit doubles the histogram size (sm_histogram.h).
+ */
+#ifndef HISTOGRAM_SUB_BITS
+#define HISTOGRAM_SUB_BITS (3U)
+#endif
+
+/**
+ * @brief Histogram range: values up to 2^HISTOGRAM_MAX_BITS - 1 get their own bucket
+ *
+ * 24 bits covers ~16.7 s in microseconds. Default size:
+ * (24 - 3 + 1) * 8 = 176 buckets, ~0.7 KB per histogram.
+ */
+#ifndef HISTOGRAM_MAX_BITS
+#define HISTOGRAM_MAX_BITS (24U)
+#endif
+
+/**
+ * @brief Depth of the pending event queue
+ *
+ * Number of events that can be posted between two StateMachine_Execute()
+ * calls. One event is dispatched per call.
+ * - 1: classic single pending event (new events dropped while one is pending)
+ * - 2-8: bursty producers (ISRs, multiple tasks)
+ */
+#ifndef SM_EVENT_QUEUE_SIZE
+#define SM_EVENT_QUEUE_SIZE (1U)
+#endif
+
+/**
+ * @brief Reject unhandled events at post time
+ *
+ * When 1, StateMachine_PostEvent() checks the current state's handled-event
+ * bitset and drops events that would not trigger a transition instead of
+ * queueing them (only while the queue is empty and no transition is under
+ * way, so the check is made against the state that will dispatch the event;
+ * events posted from on_exit are always queued). Rejected events are counted as
+ * ignored in the statistics but not logged, which keeps posting from ISRs
+ * cheap. When 0, unhandled events are queued and ignored at dispatch time.
+ */
+#ifndef SM_REJECT_UNHANDLED_EVENTS
+#define SM_REJECT_UNHANDLED_EVENTS (0U)
+#endif
+
+/**
+ * @brief Data cache line size in bytes
+ *
+ * The runtime context is aligned to this size so that all data touched on
+ * every tick shares one cache line.
+ * - Cortex-M7: 32 bytes
+ * - x86-64 / Cortex-A: 64 bytes
+ * - MCUs without data cache: any value (only costs alignment padding)
+ */
+#ifndef SM_CACHE_LINE_SIZE
+#define SM_CACHE_LINE_SIZE (64U)
+#endif
+
 /* =============================================================================
  * ERROR HANDLING CONFIGURATION
  * ===========================================================================*/
@@ -69,6 +168,8 @@
  * @brief Maximum number of recovery attempts for normal errors
  *
  * After this many failed recovery attempts, error escalates to critical.
+ * Must be between 1 and 255 (the recovery scheduler always makes at least
+ * one attempt).
  */
 #ifndef ERROR_MAX_RECOVERY_ATTEMPTS
 #define ERROR_MAX_RECOVERY_ATTEMPTS (3U)
@@ -104,6 +205,63 @@
 #define ERROR_HISTORY_SIZE (16U)
 #endif
 
+/**
+ * @brief Error reports allowed in a burst, per error code
+ *
+ * Token bucket size for ErrorHandler_Report() rate limiting. Repeats beyond
+ * the burst are counted and folded into one aggregated history entry.
+ * Critical errors are never rate limited. Set to 0 to disable.
+ */
+#ifndef ERROR_RATE_LIMIT_BURST
+#define ERROR_RATE_LIMIT_BURST (5U)
+#endif
+
+/**
+ * @brief Token refill period for error rate limiting in milliseconds
+ *
+ * One more report of a code is allowed per period (default: 10 per second).
+ */
+#ifndef ERROR_RATE_LIMIT_REFILL_MS
+#define ERROR_RATE_LIMIT_REFILL_MS (100U)
+#endif
+
+/**
+ * @brief Buckets per error-rate window
+ *
+ * Each window (1 s, 1 min, 1 h) slides in steps of window / buckets, so a
+ * rate covers between (buckets - 1) and buckets steps. Must divide 1000.
+ */
+#ifndef ERROR_RATE_BUCKETS
+#define ERROR_RATE_BUCKETS (10U)
+#endif
+
+/**
+ * @brief First delay between recovery attempts in milliseconds
+ *
+ * Default recovery policy is exponential backoff: after a failed attempt the
+ * next one is scheduled this long later, doubling on every further failure.
+ * Keep the whole schedule well inside the RECOVERY state timeout (2000 ms).
+ */
+#ifndef ERROR_RECOVERY_BASE_DELAY_MS
+#define ERROR_RECOVERY_BASE_DELAY_MS (100U)
+#endif
+
+/**
+ * @brief Upper bound for the recovery backoff delay in milliseconds
+ */
+#ifndef ERROR_RECOVERY_MAX_DELAY_MS
+#define ERROR_RECOVERY_MAX_DELAY_MS (1000U)
+#endif
+
+/**
+ * @brief Random spread applied to each backoff delay in percent (+/-)
+ *
+ * Keeps devices that failed together from retrying in lockstep.
+ */
+#ifndef ERROR_RECOVERY_JITTER_PERCENT
+#define ERROR_RECOVERY_JITTER_PERCENT (20U)
+#endif
+
 /* =============================================================================
  * DEBUG SYSTEM CONFIGURATION
  * ===========================================================================*/
@@ -153,6 +311,29 @@
 #define DEBUG_ENABLE_PERIODIC_MESSAGES (1U)
 #endif
 
+/**
+ * @brief Enable error debug messages
+ *
+ * Errors are still recorded by the error handler when disabled.
+ */
+#ifndef DEBUG_ENABLE_ERROR_MESSAGES
+#define DEBUG_ENABLE_ERROR_MESSAGES (1U)
+#endif
+
+/**
+ * @brief Enable warning debug messages
+ */
+#ifndef DEBUG_ENABLE_WARNING_MESSAGES
+#define DEBUG_ENABLE_WARNING_MESSAGES (1U)
+#endif
+
+/**
+ * @brief Enable info debug messages
+ */
+#ifndef DEBUG_ENABLE_INFO_MESSAGES
+#define DEBUG_ENABLE_INFO_MESSAGES (1U)
+#endif
+
 /**
  * @brief Interval for periodic debug messages in milliseconds
  *
@@ -211,17 +392,273 @@
 #define COMM_VERIFICATION_WINDOW_MS (50U)
 #endif
 
+/**
+ * @brief Sliding window of the communication circuit breakers in milliseconds
+ *
+ * Failure rates are computed over this window (see sm_comm_breaker.h).
+ */
+#ifndef COMM_BREAKER_WINDOW_MS
+#define COMM_BREAKER_WINDOW_MS (1000U)
+#endif
+
+/**
+ * @brief Number of time buckets in the breaker window
+ *
+ * The window slides in steps of COMM_BREAKER_WINDOW_MS / COMM_BREAKER_BUCKETS.
+ * Each bucket costs 4 bytes per channel.
+ */
+#ifndef COMM_BREAKER_BUCKETS
+#define COMM_BREAKER_BUCKETS (10U)
+#endif
+
+/**
+ * @brief Requests needed in the window before the failure rate is trusted
+ */
+#ifndef COMM_BREAKER_MIN_REQUESTS
+#define COMM_BREAKER_MIN_REQUESTS (5U)
+#endif
+
+/**
+ * @brief Failure rate in percent that opens a breaker
+ */
+#ifndef COMM_BREAKER_FAILURE_PERCENT
+#define COMM_BREAKER_FAILURE_PERCENT (50U)
+#endif
+
+/**
+ * @brief Time an open breaker fails fast before probing, in milliseconds
+ */
+#ifndef COMM_BREAKER_OPEN_MS
+#define COMM_BREAKER_OPEN_MS (500U)
+#endif
+
+/**
+ * @brief Trial requests allowed while a breaker is half-open
+ */
+#ifndef COMM_BREAKER_HALF_OPEN_PROBES
+#define COMM_BREAKER_HALF_OPEN_PROBES (1U)
+#endif
+
+/**
+ * @brief State machine instances (processes) on one event bus
+ *
+ * Each instance owns one mailbox in the shared region (see sm_event_bus.h).
+ */
+#ifndef EVENT_BUS_MAX_INSTANCES
+#define EVENT_BUS_MAX_INSTANCES (8U)
+#endif
+
+/**
+ * @brief Events buffered per event bus mailbox (power of 2, up to 4096)
+ *
+ * Each slot costs 8 bytes of shared memory per instance.
+ */
+#ifndef EVENT_BUS_RING_SIZE
+#define EVENT_BUS_RING_SIZE (64U)
+#endif
+
+/**
+ * @brief Worker threads started by WorkerPool_Init()
+ */
+#ifndef WORKER_POOL_THREADS
+#define WORKER_POOL_THREADS (2U)
+#endif
+
+/**
+ * @brief Jobs the worker pool holds at once (queued, running or undelivered)
+ *
+ * WorkerPool_Submit() fails when all are in use.
+ */
+#ifndef WORKER_POOL_QUEUE_SIZE
+#define WORKER_POOL_QUEUE_SIZE (16U)
+#endif
+
+/**
+ * @brief Render buffer of the metrics endpoint (bytes)
+ *
+ * Must hold one full exposition (sm_metrics.h); at SM_STATS_LEVEL 2
+ * that is about 30 KB for the default states. A scrape that does not fit
+ * gets HTTP 500.
+ */
+#ifndef METRICS_SERVER_BUFFER_SIZE
+#define METRICS_SERVER_BUFFER_SIZE (65536U)
+#endif
+
+/**
+ * @brief Lifetime of a metrics scrape connection (ms)
+ *
+ * A scrape not fully answered this long after it was accepted is closed,
+ * freeing its connection slot. Sockets are nonblocking, so a slow client
+ * never stalls App_Main_Task().
+ */
+#ifndef METRICS_SERVER_TIMEOUT_MS
+#define METRICS_SERVER_TIMEOUT_MS (50U)
+#endif
+
 /* =============================================================================
  * FEATURE FLAGS
  * ===========================================================================*/
 
 /**
- * @brief Enable statistics collection
+ * @brief Statistics granularity
+ *
+ * Each level adds to the one below and compiles away completely when not
+ * selected:
+ * - 0: none
+ * - 1: counters (StateMachine_GetStats(): transitions, events, timeouts,
+ *      state entries)
+ * - 2: plus histograms (event latency, state residency, task cadence jitter)
+ * - 3: plus the state x event dispatch matrix (FEATURE_TRANSITION_MATRIX),
+ *      the transition trace hook (FEATURE_TRANSITION_TRACE) and, by default,
+ *      the performance trace hooks (FEATURE_PERF_TRACE)
+ *
+ * Configurations that only set FEATURE_STATISTICS_ENABLED = 1 get level 2,
+ * the set that flag used to enable.
+ */
+#ifndef SM_STATS_LEVEL
+#if defined(FEATURE_STATISTICS_ENABLED) && (FEATURE_STATISTICS_ENABLED != 0)
+#define SM_STATS_LEVEL (2U)
+#else
+#define SM_STATS_LEVEL (0U)
+#endif
+#endif
+
+/**
+ * @brief Enable statistics collection (SM_STATS_LEVEL >= 1)
  *
- * Collects runtime statistics (transitions, errors, timing, etc.)
+ * Derived from SM_STATS_LEVEL; kept for code that tests the flag.
  */
 #ifndef FEATURE_STATISTICS_ENABLED
-#define FEATURE_STATISTICS_ENABLED (0U)
+#define FEATURE_STATISTICS_ENABLED ((SM_STATS_LEVEL >= 1U) ? 1U : 0U)
+#endif
+
+/**
+ * @brief Enable binary transition trace
+ *
+ * Compiles the transition trace ring hook into state transitions. Nothing is
+ * recorded until a buffer is attached with TransitionTrace_Init(). On at
+ * SM_STATS_LEVEL 3; may be set to 1 explicitly at lower levels.
+ */
+#ifndef FEATURE_TRANSITION_TRACE
+#define FEATURE_TRANSITION_TRACE ((SM_STATS_LEVEL >= 3U) ? 1U : 0U)
+#endif
+
+/**
+ * @brief Enable performance trace (state spans and callback timing)
+ *
+ * Compiles timing hooks around state callbacks. Nothing is measured until a
+ * buffer is attached with PerfTrace_Start(). Defaults to on at SM_STATS_LEVEL
+ * 3; may be set explicitly at any level.
+ */
+#ifndef FEATURE_PERF_TRACE
+#define FEATURE_PERF_TRACE ((SM_STATS_LEVEL >= 3U) ? 1U : 0U)
+#endif
+
+/**
+ * @brief Enable per-state execution budgets
+ *
+ * Times on_state (and the async action) of states with a budget and counts
+ * overruns. States without a budget cost one compare per tick.
+ */
+#ifndef FEATURE_STATE_BUDGETS
+#define FEATURE_STATE_BUDGETS (1U)
+#endif
+
+/**
+ * @brief Enable the state x event dispatch matrix
+ *
+ * Counts handled and ignored events per state and event, with the first and
+ * last tick each pair was seen. Costs STATE_MAX * EVENT_MAX * 16 bytes RAM
+ * and one counter increment per dispatched event. On at SM_STATS_LEVEL 3.
+ */
+#ifndef FEATURE_TRANSITION_MATRIX
+#define FEATURE_TRANSITION_MATRIX ((SM_STATS_LEVEL >= 3U) ? 1U : 0U)
+#endif
+
+/**
+ * @brief Enable sliding-window error rates (per error code and per state)
+ *
+ * Counts every ErrorHandler_Report() in 1 s / 1 min / 1 h windows for
+ * ErrorHandler_GetErrorRates(). Costs
+ * 3 * ERROR_RATE_BUCKETS * (ERROR_CODE_MAX + STATE_MAX + 1) words of RAM.
+ */
+#ifndef FEATURE_ERROR_RATES
+#define FEATURE_ERROR_RATES (1U)
+#endif
+
+/**
+ * @brief Enable transition observers (sm_observer.h)
+ *
+ * Compiles the observer fan-out into every transition (three loads while no
+ * observer is interested).
+ */
+#ifndef FEATURE_TRANSITION_OBSERVERS
+#define FEATURE_TRANSITION_OBSERVERS (1U)
+#endif
+
+/**
+ * @brief Enable the crash-persistent error/transition log hooks
+ *
+ * Compiles the append hooks into error history and transitions. Nothing is
+ * written until a region is attached with ErrorPersist_Attach().
+ */
+#ifndef FEATURE_ERROR_PERSIST
+#define FEATURE_ERROR_PERSIST (1U)
+#endif
+
+/**
+ * @brief Enable simulation support (virtual clock, event record/replay)
+ *
+ * Builds src/sim and makes the weak Platform_GetTimeMs() / GetTimeUs()
+ * defaults read the virtual clock. Set by CMake from ENABLE_SIMULATION,
+ * which is on for SM_PLATFORM SIMULATION only; set to 0 in target builds
+ * that do not compile src/sim.
+ */
+#ifndef FEATURE_SIMULATION
+#define FEATURE_SIMULATION (1U)
+#endif
+
+/**
+ * @brief Enable the shared-memory event bus between processes
+ *
+ * App_Main_Task() delivers events posted to this instance by other processes
+ * (one load per tick while no bus is open). Needs the POSIX extensions; set
+ * by CMake when ENABLE_EVENT_BUS and ENABLE_POSIX_EXTENSIONS are on.
+ */
+#ifndef FEATURE_EVENT_BUS
+#define FEATURE_EVENT_BUS (0U)
+#endif
+
+/**
+ * @brief Enable the worker pool for long-running state work
+ *
+ * App_Main_Task() delivers finished jobs (done event or error report) before
+ * the state machine runs. Needs the POSIX extensions; set by CMake when
+ * ENABLE_WORKER_POOL and ENABLE_POSIX_EXTENSIONS are on.
+ */
+#ifndef FEATURE_WORKER_POOL
+#define FEATURE_WORKER_POOL (0U)
+#endif
+
+/**
+ * @brief Enable the local metrics endpoint (HTTP over TCP or a Unix socket)
+ *
+ * App_Main_Task() answers pending scrapes (one load per tick while no
+ * endpoint is open). Needs the POSIX extensions; set by CMake when
+ * ENABLE_METRICS_SERVER and ENABLE_POSIX_EXTENSIONS are on.
+ */
+#ifndef FEATURE_METRICS_SERVER
+#define FEATURE_METRICS_SERVER (0U)
+#endif
+
+/**
+ * @brief Enable packed (uint8_t) storage of states, events and error codes
+ *
+ * Shrinks transition tables, the event queue and error records for
+ * memory-constrained deployments. The public enum API is unchanged.
+ */
+#ifndef FEATURE_PACKED_ENCODING
+#define FEATURE_PACKED_ENCODING (0U)
 #endif
 
 /**
@@ -241,8 +678,97 @@
 #error "SM_TASK_PERIOD_MS cannot be zero"
 #endif
 
-#if (ERROR_MAX_RECOVERY_ATTEMPTS == 0)
-#warning "ERROR_MAX_RECOVERY_ATTEMPTS is zero - no recovery will be attempted"
+#if (SM_CADENCE_DEADLINE_US < (SM_TASK_PERIOD_MS * 1000U))
+#error "SM_CADENCE_DEADLINE_US must be at least one task period"
+#endif
+
+#if (SM_STATS_LEVEL > 3)
+#error "SM_STATS_LEVEL must be between 0 and 3"
+#endif
+
+#if ((SM_STATS_LEVEL >= 1) ? 1 : 0) != ((FEATURE_STATISTICS_ENABLED != 0) ? 1 : 0)
+#error "FEATURE_STATISTICS_ENABLED contradicts SM_STATS_LEVEL (set only SM_STATS_LEVEL)"
+#endif
+
+#if (SM_STATS_LEVEL >= 3) && (!FEATURE_TRANSITION_MATRIX || !FEATURE_TRANSITION_TRACE)
+#error "SM_STATS_LEVEL 3 needs FEATURE_TRANSITION_MATRIX and FEATURE_TRANSITION_TRACE"
+#endif
+
+#if (HISTOGRAM_SUB_BITS < 1) || (HISTOGRAM_SUB_BITS > 8)
+#error "HISTOGRAM_SUB_BITS must be between 1 and 8"
+#endif
+
+#if (HISTOGRAM_MAX_BITS <= HISTOGRAM_SUB_BITS) || (HISTOGRAM_MAX_BITS > 32)
+#error "HISTOGRAM_MAX_BITS must be greater than HISTOGRAM_SUB_BITS and at most 32"
+#endif
+
+#if (ERROR_RATE_LIMIT_BURST > 255)
+#error "ERROR_RATE_LIMIT_BURST must not exceed 255"
+#endif
+
+#if (ERROR_RATE_LIMIT_REFILL_MS == 0) || (ERROR_RATE_LIMIT_REFILL_MS > 65535)
+#error "ERROR_RATE_LIMIT_REFILL_MS must be between 1 and 65535"
+#endif
+
+#if (ERROR_RATE_BUCKETS < 2) || ((1000 % ERROR_RATE_BUCKETS) != 0)
+#error "ERROR_RATE_BUCKETS must be at least 2 and divide 1000"
+#endif
+
+#if (ERROR_RECOVERY_JITTER_PERCENT > 100)
+#error "ERROR_RECOVERY_JITTER_PERCENT must not exceed 100"
+#endif
+
+#if (ERROR_MAX_RECOVERY_ATTEMPTS == 0) || (ERROR_MAX_RECOVERY_ATTEMPTS > 255)
+#error "ERROR_MAX_RECOVERY_ATTEMPTS must be between 1 and 255"
+#endif
+
+#if (SM_MAX_OBSERVERS == 0) || (SM_MAX_OBSERVERS > 32)
+#error "SM_MAX_OBSERVERS must be between 1 and 32"
+#endif
+
+#if (SM_MAX_STATES > 32) && FEATURE_TRANSITION_OBSERVERS
+#error "Transition observers support at most 32 states (state filters are 32-bit masks)"
+#endif
+
+#if (EVENT_BUS_MAX_INSTANCES == 0) || (EVENT_BUS_MAX_INSTANCES > 255)
+#error "EVENT_BUS_MAX_INSTANCES must be between 1 and 255"
+#endif
+
+#if (EVENT_BUS_RING_SIZE < 2) || (EVENT_BUS_RING_SIZE > 4096) || \
+    ((EVENT_BUS_RING_SIZE & (EVENT_BUS_RING_SIZE - 1)) != 0)
+#error "EVENT_BUS_RING_SIZE must be a power of 2 between 2 and 4096"
+#endif
+
+#if (WORKER_POOL_THREADS == 0) || (WORKER_POOL_THREADS > 64)
+#error "WORKER_POOL_THREADS must be between 1 and 64"
+#endif
+
+#if (WORKER_POOL_QUEUE_SIZE == 0) || (WORKER_POOL_QUEUE_SIZE > 256)
+#error "WORKER_POOL_QUEUE_SIZE must be between 1 and 256"
+#endif
+
+#if (METRICS_SERVER_BUFFER_SIZE < 1024)
+#error "METRICS_SERVER_BUFFER_SIZE must be at least 1024"
+#endif
+
+#if (METRICS_SERVER_TIMEOUT_MS == 0)
+#error "METRICS_SERVER_TIMEOUT_MS cannot be zero"
+#endif
+
+#if (COMM_BREAKER_BUCKETS == 0) || (COMM_BREAKER_BUCKETS > 255)
+#error "COMM_BREAKER_BUCKETS must be between 1 and 255"
+#endif
+
+#if (COMM_BREAKER_FAILURE_PERCENT == 0) || (COMM_BREAKER_FAILURE_PERCENT > 100)
+#error "COMM_BREAKER_FAILURE_PERCENT must be between 1 and 100"
+#endif
+
+#if (COMM_BREAKER_HALF_OPEN_PROBES == 0) || (COMM_BREAKER_HALF_OPEN_PROBES > 255)
+#error "COMM_BREAKER_HALF_OPEN_PROBES must be between 1 and 255"
+#endif
+
+#if (SM_EVENT_QUEUE_SIZE == 0) || (SM_EVENT_QUEUE_SIZE > 255)
+#error "SM_EVENT_QUEUE_SIZE must be between 1 and 255"
 #endif
 
 #if (DEBUG_MAX_MESSAGE_LENGTH < 32)
@@ -8,6 +8,18 @@
  *
  * Multi-interface debug messaging system with runtime enable/disable
  * and minimal overhead when disabled.
+ *
+ * Every module (DebugModule_t) has a mask with one bit per message type.
+ * The DEBUG_* macros test the bit of the calling file's DEBUG_MODULE before
+ * anything else: a disabled message costs one load and one branch, and its
+ * arguments (StateMachine_StateToString(), ...) are never evaluated.
+ *
+ * @code
+ *   #define DEBUG_MODULE DEBUG_MODULE_COMM   // before the framework includes
+ *   #include "sm_framework/sm_framework.h"
+ *
+ *   Debug_SetModuleMask(DEBUG_MODULE_CORE, DEBUG_MSG_BIT(DEBUG_MSG_ERROR));
+ * @endcode
  */
 
 #ifndef SM_DEBUG_H
@@ -20,6 +32,27 @@ extern "C" {
 #include "sm_types.h"
 #include <stdarg.h>
 
+/**
+ * @brief Module of the DEBUG_* messages in this translation unit
+ */
+#ifndef DEBUG_MODULE
+#define DEBUG_MODULE DEBUG_MODULE_APP
+#endif
+
+/**
+ * @brief Message type masks per module (DEBUG_MSG_BIT() set = enabled)
+ *
+ * Read by the DEBUG_* macros without locking; change them only through the
+ * Debug_Enable*() / Debug_SetModuleMask() functions.
+ */
+extern volatile uint32_t g_debug_module_masks[DEBUG_MODULE_MAX];
+
+/**
+ * @brief True if messages of a type are enabled for a module
+ */
+#define DEBUG_IS_ENABLED(module, type) \
+    ((SM_ATOMIC_LOAD_RELAXED(&g_debug_module_masks[(module)]) & DEBUG_MSG_BIT(type)) != 0U)
+
 /* =============================================================================
  * DEBUG SYSTEM INITIALIZATION
  * ===========================================================================*/
@@ -30,7 +63,10 @@ extern "C" {
  * @param interface Communication interface to use for debug output
  * @return true if initialization successful, false otherwise
  *
- * @note Must be called before using any other debug functions
+ * @note Must be called before using any other debug functions. Module masks
+ *       start at the compile-time defaults, so messages sent before init
+ *       are still filtered the same way; Debug_Init() resets them to those
+ *       defaults.
  */
 bool Debug_Init(CommInterface_t interface);
 
@@ -49,7 +85,8 @@ bool Debug_Init(CommInterface_t interface);
  * @param ... Variable arguments for format string
  *
  * @note Messages are timestamped automatically
- * @note If message type is disabled, function returns immediately (low overhead)
+ * @note Filtered with the DEBUG_MODULE_APP mask; the arguments are evaluated
+ *       by the caller either way - prefer the DEBUG_* macros
  *
  * @example
  *   Debug_SendMessage(DEBUG_MSG_INFO, "Temperature: %d C", temp);
@@ -58,6 +95,19 @@ bool Debug_Init(CommInterface_t interface);
  */
 void Debug_SendMessage(DebugMessageType_t type, const char *format, ...);
 
+/**
+ * @brief Send a formatted debug message on behalf of a module
+ *
+ * Like Debug_SendMessage(), filtered with the mask of the given module.
+ * Used by the DEBUG_* macros after their own check.
+ *
+ * @param module Module the message belongs to
+ * @param type Message type
+ * @param format Printf-style format string
+ * @param ... Variable arguments for format string
+ */
+void Debug_SendModuleMessage(DebugModule_t module, DebugMessageType_t type, const char *format, ...);
+
 /**
  * @brief Send a raw debug message (already formatted)
  *
@@ -65,11 +115,14 @@ void Debug_SendMessage(DebugMessageType_t type, const char *format, ...);
  * @param message Pre-formatted message string
  *
  * @note Useful when message is already formatted or doesn't need timestamp
+ * @note Filtered with the DEBUG_MODULE_APP mask
  */
 void Debug_SendRawMessage(DebugMessageType_t type, const char *message);
 
 /* =============================================================================
  * MESSAGE TYPE CONTROL
+ *
+ * The Debug_Enable*() functions switch a message type in every module.
  * ===========================================================================*/
 
 /**
@@ -104,7 +157,8 @@ void Debug_EnablePeriodicMessages(bool enable);
  *
  * @param enable true to enable, false to disable
  *
- * @warning Disabling error messages not recommended
+ * @warning Disabling error messages not recommended; errors are still
+ *          recorded by the error handler
  */
 void Debug_EnableErrorMessages(bool enable);
 
@@ -123,17 +177,34 @@ void Debug_EnableWarningMessages(bool enable);
 void Debug_EnableInfoMessages(bool enable);
 
 /**
- * @brief Enable all message types
+ * @brief Enable all message types in all modules
  */
 void Debug_EnableAllMessages(void);
 
 /**
- * @brief Disable all message types
+ * @brief Disable all message types in all modules, errors included
  *
  * @note Use for production builds to minimize output
  */
 void Debug_DisableAllMessages(void);
 
+/**
+ * @brief Set the message type mask of one module
+ *
+ * @param module Module
+ * @param mask DEBUG_MSG_BIT() of each enabled type (DEBUG_MSG_ALL, 0, ...)
+ * @return true if set, false if module is invalid
+ */
+bool Debug_SetModuleMask(DebugModule_t module, uint32_t mask);
+
+/**
+ * @brief Get the message type mask of one module
+ *
+ * @param module Module
+ * @return Mask, 0 if module is invalid
+ */
+uint32_t Debug_GetModuleMask(DebugModule_t module);
+
 /* =============================================================================
  * PERIODIC STATUS MESSAGES
  * ===========================================================================*/
@@ -157,6 +228,16 @@ void Debug_ProcessPeriodic(void);
  */
 void Debug_SetPeriodicInterval(uint32_t interval_ms);
 
+/**
+ * @brief Get the time of the next periodic status message
+ *
+ * @param time_ms Filled with the time the next periodic message is due
+ * @return true if periodic messages are enabled (DEBUG_MODULE_CORE), false otherwise
+ *
+ * @note Used by fast-forward simulation drivers (see sm_sim.h)
+ */
+bool Debug_GetNextPeriodicTime(uint32_t *time_ms);
+
 /* =============================================================================
  * COMMUNICATION INTERFACE CONTROL
  * ===========================================================================*/
@@ -214,13 +295,27 @@ void Debug_SetFormatter(DebugFormatter_t formatter);
  * UTILITY MACROS
  * ===========================================================================*/
 
+/**
+ * @brief Debug message of this file's DEBUG_MODULE
+ *
+ * Arguments are evaluated only if the type is enabled for the module.
+ */
+#define DEBUG_MESSAGE(type, ...) \
+    do { \
+        if (DEBUG_IS_ENABLED(DEBUG_MODULE, (type))) { \
+            Debug_SendModuleMessage(DEBUG_MODULE, (type), __VA_ARGS__); \
+        } \
+    } while(0)
+
 /**
  * @brief Conditional debug message (only if condition is true)
+ *
+ * The condition is evaluated only if the type is enabled.
  */
 #define DEBUG_IF(condition, type, ...) \
     do { \
-        if (condition) { \
-            Debug_SendMessage(type, __VA_ARGS__); \
+        if (DEBUG_IS_ENABLED(DEBUG_MODULE, (type)) && (condition)) { \
+            Debug_SendModuleMessage(DEBUG_MODULE, (type), __VA_ARGS__); \
         } \
     } while(0)
 
@@ -228,16 +323,18 @@ void Debug_SetFormatter(DebugFormatter_t formatter);
  * @brief Debug message with function name
  */
 #define DEBUG_FUNC(type, ...) \
-    Debug_SendMessage(type, "%s(): " __VA_ARGS__, __func__)
+    DEBUG_MESSAGE(type, "%s(): " __VA_ARGS__, __func__)
 
 /**
  * @brief Debug assert (send error message if condition fails)
+ *
+ * The expression is always evaluated.
  */
 #if FEATURE_ASSERT_ENABLED
     #define DEBUG_ASSERT(expr) \
         do { \
             if (!(expr)) { \
-                Debug_SendMessage(DEBUG_MSG_ERROR, \
+                DEBUG_MESSAGE(DEBUG_MSG_ERROR, \
                     "ASSERT FAILED: %s at %s:%d", #expr, __FILE__, __LINE__); \
             } \
         } while(0)
@@ -260,26 +357,26 @@ void Debug_SetFormatter(DebugFormatter_t formatter);
 #endif
 
 #if DEBUG_LEVEL >= 1
-    #define DEBUG_ERROR(...) Debug_SendMessage(DEBUG_MSG_ERROR, __VA_ARGS__)
+    #define DEBUG_ERROR(...) DEBUG_MESSAGE(DEBUG_MSG_ERROR, __VA_ARGS__)
 #else
     #define DEBUG_ERROR(...) ((void)0)
 #endif
 
 #if DEBUG_LEVEL >= 2
-    #define DEBUG_WARNING(...) Debug_SendMessage(DEBUG_MSG_WARNING, __VA_ARGS__)
+    #define DEBUG_WARNING(...) DEBUG_MESSAGE(DEBUG_MSG_WARNING, __VA_ARGS__)
 #else
     #define DEBUG_WARNING(...) ((void)0)
 #endif
 
 #if DEBUG_LEVEL >= 3
-    #define DEBUG_INFO(...) Debug_SendMessage(DEBUG_MSG_INFO, __VA_ARGS__)
+    #define DEBUG_INFO(...) DEBUG_MESSAGE(DEBUG_MSG_INFO, __VA_ARGS__)
 #else
     #define DEBUG_INFO(...) ((void)0)
 #endif
 
 #if DEBUG_LEVEL >= 4
-    #define DEBUG_RUNTIME(...) Debug_SendMessage(DEBUG_MSG_RUNTIME, __VA_ARGS__)
-    #define DEBUG_INIT(...) Debug_SendMessage(DEBUG_MSG_INIT, __VA_ARGS__)
+    #define DEBUG_RUNTIME(...) DEBUG_MESSAGE(DEBUG_MSG_RUNTIME, __VA_ARGS__)
+    #define DEBUG_INIT(...) DEBUG_MESSAGE(DEBUG_MSG_INIT, __VA_ARGS__)
 #else
     #define DEBUG_RUNTIME(...) ((void)0)
     #define DEBUG_INIT(...) ((void)0)
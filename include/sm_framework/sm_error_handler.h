@@ -55,6 +55,33 @@ bool ErrorHandler_Init(void);
  */
 bool ErrorHandler_Report(ErrorLevel_t level, ErrorCode_t code);
 
+/**
+ * @brief Function pointer type for error report hook
+ *
+ * @param level Reported level
+ * @param code Reported code
+ */
+typedef void (*ErrorReportHook_t)(ErrorLevel_t level, ErrorCode_t code);
+
+/**
+ * @brief Set hook called at the start of every ErrorHandler_Report()
+ *
+ * Used by the event recorder (see sm_sim.h). Not cleared by
+ * ErrorHandler_Init().
+ *
+ * @param hook Hook function (NULL to remove)
+ *
+ * @note The hook runs in the caller's context (may be an ISR)
+ */
+void ErrorHandler_SetReportHook(ErrorReportHook_t hook);
+
+/**
+ * @brief Check whether an ErrorHandler_Report() call is in progress
+ *
+ * @return true while reporting (events posted now are report side effects)
+ */
+bool ErrorHandler_IsReporting(void);
+
 /**
  * @brief Handle minor error with auto-recovery
  *
@@ -98,13 +125,68 @@ void ErrorHandler_HandleCriticalError(ErrorCode_t code);
  * Called from RECOVERY state to attempt error recovery.
  * Implements recovery logic based on error code.
  *
- * @return true if recovery successful, false if recovery failed
+ * Attempts are scheduled by the recovery policy of the error code: before
+ * the next attempt is due this returns false at once, without calling the
+ * recovery handler or using up the retry budget.
  *
- * @note After ERROR_MAX_RECOVERY_ATTEMPTS failed attempts, error escalates
- *       to critical level.
+ * @return true if recovery successful, false if recovery failed or not due
+ *
+ * @note After the policy's max_attempts (ERROR_MAX_RECOVERY_ATTEMPTS by
+ *       default), ErrorHandler_IsRecoveryExhausted() reports true and the
+ *       error escalates to critical level.
  */
 bool ErrorHandler_AttemptRecovery(void);
 
+/**
+ * @brief Check whether the retry budget of the current error is used up
+ *
+ * @return true if no further recovery attempt will be made
+ */
+bool ErrorHandler_IsRecoveryExhausted(void);
+
+/**
+ * @brief Get the time of the next scheduled recovery attempt
+ *
+ * Lets a scheduler sleep (or a simulation skip ticks) until the attempt is due.
+ *
+ * @param time_ms Receives the deadline (Platform_GetTimeMs() time base)
+ * @return true if an attempt is scheduled, false if none is pending
+ */
+bool ErrorHandler_GetNextRecoveryTime(uint32_t *time_ms);
+
+/**
+ * @brief Set the recovery policy for an error code
+ *
+ * Defaults: RECOVERY_STRATEGY_BACKOFF, ERROR_MAX_RECOVERY_ATTEMPTS attempts,
+ * ERROR_RECOVERY_BASE_DELAY_MS doubling up to ERROR_RECOVERY_MAX_DELAY_MS,
+ * ERROR_RECOVERY_JITTER_PERCENT jitter.
+ *
+ * - IMMEDIATE: retry on the next tick (previous behavior)
+ * - FIXED: retry every delay_ms
+ * - BACKOFF: delay_ms, 2 * delay_ms, ... capped at max_delay_ms, +/- jitter
+ * - CIRCUIT_BREAKER: retry every delay_ms; after failure_threshold consecutive
+ *   failures (across errors) no attempt is made for open_ms, then a single
+ *   trial attempt decides whether it closes again. Attempts deferred while
+ *   open do not use the retry budget.
+ *
+ * @param code Error code
+ * @param policy Policy to copy
+ * @return true if set, false if invalid parameters
+ *
+ * @note Delays count against the RECOVERY state timeout (2000 ms), which
+ *       escalates to CRITICAL_ERROR when reached.
+ */
+bool ErrorHandler_SetRecoveryPolicy(ErrorCode_t code, const RecoveryPolicy_t *policy);
+
+/**
+ * @brief Get the recovery policy for an error code
+ *
+ * @param code Error code
+ * @param policy Receives the policy
+ * @return true if successful, false if invalid parameters
+ */
+bool ErrorHandler_GetRecoveryPolicy(ErrorCode_t code, RecoveryPolicy_t *policy);
+
 /**
  * @brief Clear current error
  *
@@ -138,7 +220,8 @@ bool ErrorHandler_GetCurrentError(ErrorInfo_t *error_info);
  *
  * @param index History index (0 = most recent, 1 = second most recent, etc.)
  * @param error_info Pointer to structure to fill with error information
- * @return true if successful, false if invalid index or NULL pointer
+ * @return true if successful, false if invalid index, NULL pointer, or the
+ *         entry is being overwritten
  *
  * @note History is circular buffer of size ERROR_HISTORY_SIZE
  */
@@ -151,6 +234,155 @@ bool ErrorHandler_GetHistoryError(uint8_t index, ErrorInfo_t *error_info);
  */
 uint8_t ErrorHandler_GetHistoryCount(void);
 
+/**
+ * @brief Read history entries newer than a sequence number
+ *
+ * Copies entries with seq >= since_seq, oldest first, so a monitor can poll
+ * incrementally: pass the seq of the last entry received + 1 next time.
+ * A gap in the returned sequence numbers means entries were overwritten
+ * before they were read.
+ *
+ * @param since_seq First sequence number wanted (0 or 1 = oldest available)
+ * @param buffer Output buffer
+ * @param max_entries Size of output buffer
+ * @return Number of entries copied
+ *
+ * @note LOCK-FREE: safe to call from another thread while errors are
+ *       reported. Stops early at an entry that is still being written.
+ */
+uint32_t ErrorHandler_ReadHistory(uint32_t since_seq, ErrorInfo_t *buffer, uint32_t max_entries);
+
+/**
+ * @brief Error history statistics
+ */
+typedef struct {
+    uint32_t total_logged;   /**< Entries logged since init (= last seq) */
+    uint32_t count;          /**< Entries currently held (up to ERROR_HISTORY_SIZE) */
+    uint32_t overwritten;    /**< Entries overwritten by newer ones */
+    uint32_t dropped;        /**< Entries dropped (concurrent writers lapped the ring) */
+} ErrorHistoryStats_t;
+
+/**
+ * @brief Get error history statistics
+ *
+ * @param stats Pointer to structure to fill
+ * @return true if successful, false if stats is NULL
+ */
+bool ErrorHandler_GetHistoryStats(ErrorHistoryStats_t *stats);
+
+/**
+ * @brief Get the number of reports of an error code since init
+ *
+ * Counts every ErrorHandler_Report(), including repeats suppressed by rate
+ * limiting. Never reset, so it can be exported as a monotonic counter.
+ *
+ * @param code Error code
+ * @return Reports since init (0 if code is invalid)
+ */
+uint32_t ErrorHandler_GetReportCount(ErrorCode_t code);
+
+/* =============================================================================
+ * RATE LIMITING
+ * ===========================================================================*/
+
+/**
+ * @brief Configure report rate limiting for an error code
+ *
+ * Each code has a token bucket: up to burst reports pass immediately, then
+ * one per refill_ms. Suppressed repeats skip history, logging and event
+ * posting; they are counted and folded into one history entry (count,
+ * first/last timestamp) with the next admitted report or by
+ * ErrorHandler_FlushSuppressed().
+ *
+ * @param code Error code to configure
+ * @param burst Bucket size (0 = no rate limiting)
+ * @param refill_ms Milliseconds per token (> 0)
+ * @return true if successful, false if invalid parameters
+ *
+ * @note Defaults: ERROR_RATE_LIMIT_BURST, ERROR_RATE_LIMIT_REFILL_MS.
+ *       Critical errors are never rate limited.
+ */
+bool ErrorHandler_SetRateLimit(ErrorCode_t code, uint8_t burst, uint16_t refill_ms);
+
+/**
+ * @brief Write aggregated history entries for storms that have ended
+ *
+ * A storm has ended when no repeat was suppressed for one refill period.
+ * Called by App_Main_Task(); costs one load when nothing is pending.
+ */
+void ErrorHandler_FlushSuppressed(void);
+
+/**
+ * @brief Check whether suppressed repeats are waiting to be flushed
+ *
+ * @return true if ErrorHandler_FlushSuppressed() has work to do
+ */
+bool ErrorHandler_HasPendingSuppressed(void);
+
+/**
+ * @brief Rate limiting statistics
+ */
+typedef struct {
+    uint32_t suppressed_total;                /**< Reports suppressed since init */
+    uint32_t suppressed[ERROR_CODE_MAX];      /**< Reports suppressed per code */
+    uint32_t pending;                         /**< Suppressed, not yet in history */
+    uint32_t aggregated_entries;              /**< History entries with count > 1 */
+} ErrorRateLimitStats_t;
+
+/**
+ * @brief Get rate limiting statistics
+ *
+ * @param stats Pointer to structure to fill
+ * @return true if successful, false if stats is NULL
+ */
+bool ErrorHandler_GetRateLimitStats(ErrorRateLimitStats_t *stats);
+
+/* =============================================================================
+ * ERROR RATES (FEATURE_ERROR_RATES)
+ * ===========================================================================*/
+
+/**
+ * @brief Error counts of one window
+ */
+typedef struct {
+    uint32_t window_ms;                       /**< Window length */
+    uint32_t total;                           /**< Reports in the window */
+    uint32_t by_code[ERROR_CODE_MAX];         /**< Reports per error code */
+    uint32_t by_state[STATE_MAX];             /**< Reports per state at report time */
+} ErrorRates_t;
+
+/**
+ * @brief Get the error counts of a sliding window
+ *
+ * Every ErrorHandler_Report() is counted, including reports suppressed by
+ * rate limiting. Lock-free: may be called from a monitoring thread while the
+ * state machine runs; a bucket rotated during the read is left out.
+ *
+ * @param window ERROR_RATE_WINDOW_1S, _1M or _1H
+ * @param rates Pointer to structure to fill
+ * @return true if successful, false if invalid parameters or
+ *         FEATURE_ERROR_RATES is disabled
+ */
+bool ErrorHandler_GetErrorRates(ErrorRateWindow_t window, ErrorRates_t *rates);
+
+/**
+ * @brief Get the error count of one code in a sliding window
+ *
+ * @param window ERROR_RATE_WINDOW_1S, _1M or _1H
+ * @param code Error code
+ * @return Reports in the window (0 if invalid parameters)
+ */
+uint32_t ErrorHandler_GetCodeRate(ErrorRateWindow_t window, ErrorCode_t code);
+
+/**
+ * @brief Get the error count of one state in a sliding window
+ *
+ * @param window ERROR_RATE_WINDOW_1S, _1M or _1H
+ * @param state State the errors were reported in
+ * @return Reports in the window (0 if invalid parameters)
+ */
+uint32_t ErrorHandler_GetStateRate(ErrorRateWindow_t window, StateMachineState_t state);
+
 /* =============================================================================
  * STRING CONVERSION UTILITIES
  * ===========================================================================*/
@@ -186,6 +418,10 @@ const char *ErrorHandler_LevelToString(ErrorLevel_t level);
  * by requiring COMM_VERIFICATION_COUNT good messages within
  * COMM_VERIFICATION_WINDOW_MS.
  *
+ * Fails fast without counting while the circuit breaker of the debug
+ * interface is open (see sm_comm_breaker.h). Each successful verification
+ * is recorded as a breaker success, which closes a half-open breaker.
+ *
  * @return true if channel verified, false if verification incomplete
  *
  * @note Call this function when a good message is received to increment counter
@@ -0,0 +1,235 @@
+/**
+ * @file sm_error_persist.h
+ * @brief Crash-persistent error and transition log
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Keeps the error history and the last transitions in a region that survives
+ * a reset or a crash: a no-init RAM section on a microcontroller, or a
+ * memory-mapped file on Linux (ErrorPersist_MapFile()).
+ *
+ * Memory layout (also the file layout):
+ * @code
+ *   ErrorPersistHeader_t                         64 bytes
+ *   ErrorPersistRecord_t[error_capacity]         errors + boot markers
+ *   ErrorPersistRecord_t[transition_capacity]    transitions
+ * @endcode
+ *
+ * Both rings are append-only. Each record carries its own sequence number and
+ * CRC, so appending is a single 16-byte write - no header update, no flush.
+ * A record torn by a crash fails its CRC and is ignored.
+ *
+ * ErrorHandler_Init() recovers the region: it finds the newest valid record
+ * of each ring, continues after it and appends a boot marker. Records of the
+ * previous run stay readable with ErrorPersist_Read() until overwritten.
+ *
+ * No-init RAM example (GCC, the linker script must keep .noinit unzeroed):
+ * @code
+ *   static uint8_t g_persist[ERROR_PERSIST_SIZE(32, 64)] __attribute__((section(".noinit")));
+ *   ErrorPersist_Attach(g_persist, sizeof(g_persist), 32, 64);
+ *   App_Main_Init(COMM_INTERFACE_UART);   // recovers the previous run
+ * @endcode
+ */
+
+#ifndef SM_ERROR_PERSIST_H
+#define SM_ERROR_PERSIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+
+/* =============================================================================
+ * LOG FORMAT
+ * ===========================================================================*/
+
+/** Log header magic ("SMPL") */
+#define ERROR_PERSIST_MAGIC    (0x4C504D53UL)
+
+/** Log format version */
+#define ERROR_PERSIST_VERSION  (1U)
+
+/** Region size needed for the given ring capacities */
+#define ERROR_PERSIST_SIZE(errors, transitions) \
+    (sizeof(ErrorPersistHeader_t) + (((errors) + (transitions)) * sizeof(ErrorPersistRecord_t)))
+
+/**
+ * @brief Record kinds
+ */
+typedef enum {
+    ERROR_PERSIST_EMPTY = 0,      /**< Never written */
+    ERROR_PERSIST_ERROR,          /**< Error history entry */
+    ERROR_PERSIST_BOOT,           /**< Start of a run (error ring) */
+    ERROR_PERSIST_TRANSITION,     /**< State transition */
+    ERROR_PERSIST_KIND_MAX
+} ErrorPersistKind_t;
+
+/**
+ * @brief Persistent record (16 bytes)
+ */
+typedef struct {
+    uint32_t seq;          /**< Sequence number in its ring (1, 2, ...) */
+    uint32_t timestamp;    /**< Platform_GetTimeMs() (run-relative) */
+    uint8_t kind;          /**< ErrorPersistKind_t */
+    uint8_t a;             /**< Error: level / transition: from state */
+    uint8_t b;             /**< Error: code / transition: to state */
+    uint8_t c;             /**< Error: state / transition: event */
+    uint16_t extra;        /**< Error: count / transition: exec count / boot: boot number (saturated) */
+    uint16_t crc;          /**< CRC-16/CCITT of the preceding 14 bytes */
+} ErrorPersistRecord_t;
+
+/**
+ * @brief Log header
+ */
+typedef struct {
+    uint32_t magic;                 /**< ERROR_PERSIST_MAGIC */
+    uint16_t version;               /**< ERROR_PERSIST_VERSION */
+    uint16_t record_size;           /**< sizeof(ErrorPersistRecord_t) */
+    uint32_t error_capacity;        /**< Records in the error ring */
+    uint32_t transition_capacity;   /**< Records in the transition ring */
+    uint32_t boot_count;            /**< Runs recovered from this region */
+    uint8_t reserved[42];           /**< Reserved (0) */
+    uint16_t crc;                   /**< CRC-16/CCITT of the preceding 62 bytes */
+} ErrorPersistHeader_t;
+
+/* Fixed on-disk layout for external readers */
+_Static_assert(sizeof(ErrorPersistRecord_t) == 16U, "ErrorPersistRecord_t must be 16 bytes");
+_Static_assert(sizeof(ErrorPersistHeader_t) == 64U, "ErrorPersistHeader_t must be 64 bytes");
+
+/**
+ * @brief Rings of the log
+ */
+typedef enum {
+    ERROR_PERSIST_RING_ERRORS = 0,     /**< Errors and boot markers */
+    ERROR_PERSIST_RING_TRANSITIONS,    /**< Transitions */
+    ERROR_PERSIST_RING_MAX
+} ErrorPersistRing_t;
+
+/**
+ * @brief What ErrorPersist_Recover() found from earlier runs
+ */
+typedef struct {
+    uint32_t boot_count;              /**< Runs recovered so far (this one included) */
+    uint32_t recovered_errors;        /**< Valid error records found */
+    uint32_t recovered_transitions;   /**< Valid transition records found */
+    uint32_t corrupt_records;         /**< Written records failing their CRC */
+    bool formatted;                   /**< Region was blank/invalid and was formatted */
+    bool has_last_error;              /**< last_error is valid */
+    ErrorPersistRecord_t last_error;  /**< Newest error of the previous run */
+} ErrorPersistInfo_t;
+
+/* =============================================================================
+ * PERSISTENCE API
+ * ===========================================================================*/
+
+/**
+ * @brief Attach a persistent region
+ *
+ * Keeps the content if the header is valid and has the same geometry,
+ * otherwise formats the region. Attach before App_Main_Init() so that
+ * ErrorHandler_Init() recovers it; when attaching later, call
+ * ErrorPersist_Recover() yourself.
+ *
+ * @param memory Region to use (4-byte aligned)
+ * @param size Size of region in bytes (>= ERROR_PERSIST_SIZE())
+ * @param error_capacity Records in the error ring (>= 1)
+ * @param transition_capacity Records in the transition ring (>= 1)
+ * @return true if attached, false if invalid parameters
+ */
+bool ErrorPersist_Attach(void *memory, uint32_t size, uint32_t error_capacity,
+                         uint32_t transition_capacity);
+
+/**
+ * @brief Detach the region (its content is left intact)
+ */
+void ErrorPersist_Detach(void);
+
+/**
+ * @brief Check whether records are being appended
+ *
+ * @return true once an attached region has been recovered
+ */
+bool ErrorPersist_IsActive(void);
+
+/**
+ * @brief Scan the attached region and start appending after its newest records
+ *
+ * Called by ErrorHandler_Init(). Appends a boot marker to the error ring.
+ *
+ * @param info Filled with what was found (can be NULL)
+ * @return true if a region was recovered, false if none is attached
+ */
+bool ErrorPersist_Recover(ErrorPersistInfo_t *info);
+
+/**
+ * @brief Get the result of the last recovery
+ *
+ * @param info Pointer to structure to fill
+ * @return true if a region was recovered, false otherwise
+ */
+bool ErrorPersist_GetInfo(ErrorPersistInfo_t *info);
+
+/**
+ * @brief Append an error record (called for every error history entry)
+ *
+ * Safe from several reporters at once; does nothing if inactive.
+ *
+ * @param error Error to persist
+ */
+void ErrorPersist_RecordError(const ErrorInfo_t *error);
+
+/**
+ * @brief Append a transition record (called by the state machine)
+ *
+ * @param from Previous state
+ * @param to New state
+ * @param event Triggering event
+ * @param exec_count Executions of the previous state
+ */
+void ErrorPersist_RecordTransition(StateMachineState_t from, StateMachineState_t to,
+                                   StateMachineEvent_t event, uint32_t exec_count);
+
+/**
+ * @brief Copy the newest valid records of a ring, oldest first
+ *
+ * Includes records of earlier runs (separated by ERROR_PERSIST_BOOT markers
+ * in the error ring).
+ *
+ * @param ring Ring to read
+ * @param records Output buffer
+ * @param max_records Size of output buffer
+ * @return Number of records copied
+ */
+uint32_t ErrorPersist_Read(ErrorPersistRing_t ring, ErrorPersistRecord_t *records,
+                           uint32_t max_records);
+
+/**
+ * @brief Map a persistent log file and attach it (POSIX only)
+ *
+ * Creates the file if needed; an existing log with the same geometry is kept
+ * for recovery. Writes reach the file through the page cache, so records
+ * survive a crash of the process without any fsync.
+ *
+ * @param path File path
+ * @param error_capacity Records in the error ring
+ * @param transition_capacity Records in the transition ring
+ * @return true if mapped and attached
+ *
+ * @note Available when built with ENABLE_POSIX_EXTENSIONS.
+ */
+bool ErrorPersist_MapFile(const char *path, uint32_t error_capacity,
+                          uint32_t transition_capacity);
+
+/**
+ * @brief Detach and unmap a file mapped with ErrorPersist_MapFile()
+ */
+void ErrorPersist_UnmapFile(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_ERROR_PERSIST_H */
@@ -0,0 +1,244 @@
+/**
+ * @file sm_event_bus.h
+ * @brief Shared-memory event bus between state machine processes (Linux/POSIX)
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Lets separate processes (e.g. acquisition, processing, comms), each running
+ * its own state machine, post events to each other without sockets or
+ * serialization. Every instance owns a mailbox in one shared memory region:
+ *
+ * @code
+ *   EventBusHeader_t                                   64 bytes
+ *   EventBusMailbox_t[instances]                       one per instance
+ *     producer line (tail)  | consumer line (head, waiting, stats)
+ *     EventBusSlot_t[EVENT_BUS_RING_SIZE]              8 bytes each
+ * @endcode
+ *
+ * A mailbox is a bounded lock-free multi-producer / single-consumer ring:
+ * posting claims a slot with one compare-and-swap and publishes it with a
+ * release store of the slot sequence number. A full mailbox rejects the post.
+ *
+ * Wakeup uses one eventfd per instance, written only when the receiver is
+ * blocked in EventBus_Wait() - a receiver that ticks normally just drains its
+ * mailbox at the start of App_Main_Task() (FEATURE_EVENT_BUS). The eventfds
+ * are created with the bus and inherited by processes forked afterwards.
+ * Processes that open a named bus with EventBus_Open() have no eventfds:
+ * they still send and receive, and EventBus_Wait() falls back to polling.
+ *
+ * Typical use:
+ * @code
+ *   EventBus_Create(NULL, 3);          // memfd, before forking the workers
+ *   if (fork() == 0) {
+ *       EventBus_Attach(APP_ACQUISITION);
+ *       App_Main_Init(COMM_INTERFACE_UART);
+ *       ...
+ *       StateMachine_PostEventTo(APP_PROCESSING, EVENT_DATA_READY);
+ *   }
+ * @endcode
+ */
+
+#ifndef SM_EVENT_BUS_H
+#define SM_EVENT_BUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+
+/* =============================================================================
+ * BUS FORMAT
+ * ===========================================================================*/
+
+/** Bus header magic ("SMEB") */
+#define EVENT_BUS_MAGIC    (0x42454D53UL)
+
+/** Bus format version */
+#define EVENT_BUS_VERSION  (1U)
+
+/** Instance ID of a process that has not attached */
+#define EVENT_BUS_NO_INSTANCE (0xFFU)
+
+/**
+ * @brief Mailbox slot (8 bytes)
+ */
+typedef struct {
+    volatile uint32_t seq;     /**< Ring position this slot is ready for */
+    uint8_t event;             /**< StateMachineEvent_t */
+    uint8_t source;            /**< Sending instance (EVENT_BUS_NO_INSTANCE if unattached) */
+    uint16_t reserved;         /**< Reserved (0) */
+} EventBusSlot_t;
+
+/**
+ * @brief Mailbox of one instance
+ *
+ * Producers and the consumer write separate cache lines.
+ */
+typedef struct {
+    SM_CACHE_ALIGNED volatile uint32_t tail;   /**< Next position to claim (producers) */
+    volatile uint32_t rejected;                /**< Posts refused because the ring was full */
+    SM_CACHE_ALIGNED volatile uint32_t head;   /**< Next position to read (consumer) */
+    volatile uint32_t waiting;                 /**< Consumer blocked in EventBus_Wait() */
+    volatile uint32_t owner_pid;               /**< Attached process (0 = none) */
+    volatile uint32_t received;                /**< Events taken out of the mailbox */
+    SM_CACHE_ALIGNED EventBusSlot_t slots[EVENT_BUS_RING_SIZE]; /**< Ring */
+} EventBusMailbox_t;
+
+/**
+ * @brief Bus header
+ */
+typedef struct {
+    uint32_t magic;            /**< EVENT_BUS_MAGIC */
+    uint16_t version;          /**< EVENT_BUS_VERSION */
+    uint16_t mailbox_size;     /**< sizeof(EventBusMailbox_t) */
+    uint32_t instances;        /**< Mailboxes on the bus */
+    uint32_t ring_size;        /**< EVENT_BUS_RING_SIZE */
+    uint8_t reserved[48];      /**< Reserved (0) */
+} EventBusHeader_t;
+
+_Static_assert(sizeof(EventBusSlot_t) == 8U, "EventBusSlot_t must be 8 bytes");
+_Static_assert(sizeof(EventBusHeader_t) == 64U, "EventBusHeader_t must be 64 bytes");
+
+/** Shared region size for the given number of instances */
+#define EVENT_BUS_SIZE(instances) \
+    (sizeof(EventBusHeader_t) + ((instances) * sizeof(EventBusMailbox_t)))
+
+/**
+ * @brief Event bus statistics of this process's mailbox
+ */
+typedef struct {
+    uint32_t posted;           /**< Events this process posted to other instances */
+    uint32_t post_failures;    /**< Posts refused (full mailbox, unknown instance) */
+    uint32_t received;         /**< Events taken out of this mailbox */
+    uint32_t delivered;        /**< Received events accepted by StateMachine_PostEvent() */
+    uint32_t dropped;          /**< Received events StateMachine_PostEvent() refused */
+    uint32_t rejected;         /**< Posts other processes could not place in this mailbox */
+    uint32_t wakeups;          /**< Returns from a blocking EventBus_Wait() */
+} EventBusStats_t;
+
+/* =============================================================================
+ * EVENT BUS API
+ * ===========================================================================*/
+
+/**
+ * @brief Create a bus and its wakeup eventfds
+ *
+ * @param name NULL for an anonymous memfd bus (shared with processes forked
+ *             afterwards), or a shm_open() name such as "/sm_bus" that
+ *             unrelated processes can open
+ * @param instances Number of mailboxes (1 to EVENT_BUS_MAX_INSTANCES)
+ * @return true if created
+ */
+bool EventBus_Create(const char *name, uint8_t instances);
+
+/**
+ * @brief Open a named bus created by another process
+ *
+ * No eventfds are available: EventBus_Wait() here polls the ring every
+ * millisecond, and posts from this process do not signal any receiver.
+ * Receivers on a named bus therefore wait in 1 ms slices, creator included,
+ * so they still notice such posts within about 1 ms.
+ *
+ * @param name shm_open() name passed to EventBus_Create()
+ * @return true if opened, false if missing or incompatible
+ */
+bool EventBus_Open(const char *name);
+
+/**
+ * @brief Claim the mailbox of this process
+ *
+ * @param instance Instance ID (0 to instances - 1)
+ * @return true if attached
+ */
+bool EventBus_Attach(uint8_t instance);
+
+/**
+ * @brief Detach and unmap the bus (the creator also removes a named bus)
+ */
+void EventBus_Close(void);
+
+/**
+ * @brief Get the instance ID of this process
+ *
+ * @return Instance ID, EVENT_BUS_NO_INSTANCE if not attached
+ */
+uint8_t EventBus_GetInstance(void);
+
+/**
+ * @brief Post an event into another instance's mailbox
+ *
+ * Lock-free, callable from any thread of any process on the bus.
+ *
+ * @param instance Receiving instance
+ * @param event Event to post
+ * @return true if queued, false if no bus, invalid instance/event or full
+ */
+bool EventBus_Post(uint8_t instance, StateMachineEvent_t event);
+
+/**
+ * @brief Take the oldest event out of this process's mailbox
+ *
+ * @param event Received event
+ * @param source Sending instance (can be NULL)
+ * @return true if an event was received, false if the mailbox is empty
+ */
+bool EventBus_Receive(StateMachineEvent_t *event, uint8_t *source);
+
+/**
+ * @brief Deliver pending mailbox events to the local state machine
+ *
+ * Called by App_Main_Task() when FEATURE_EVENT_BUS is enabled; costs one
+ * load while no bus is open. Stops when the local event queue is full and
+ * leaves the remaining events in the mailbox for the next poll, so a burst
+ * is delivered over several ticks instead of being lost. Events the state
+ * machine refuses for another reason are counted as dropped.
+ *
+ * @return Number of events taken out of the mailbox
+ */
+uint32_t EventBus_Poll(void);
+
+/**
+ * @brief Check whether this process's mailbox holds undelivered events
+ *
+ * For tickless loops: pending bus events require a tick.
+ *
+ * @return true if events are waiting for EventBus_Poll()
+ */
+bool EventBus_HasPending(void);
+
+/**
+ * @brief Block until this process's mailbox is not empty
+ *
+ * @param timeout_ms Maximum wait (0 = only check)
+ * @return true if events are pending, false on timeout
+ */
+bool EventBus_Wait(uint32_t timeout_ms);
+
+/**
+ * @brief Get event bus statistics
+ *
+ * @param stats Pointer to structure to fill
+ * @return true if attached, false otherwise
+ */
+bool EventBus_GetStats(EventBusStats_t *stats);
+
+/**
+ * @brief Post an event to a state machine instance, local or remote
+ *
+ * Posts locally with StateMachine_PostEvent() when instance is this
+ * process's own, otherwise through EventBus_Post().
+ *
+ * @param instance Receiving instance
+ * @param event Event to post
+ * @return true if queued
+ */
+bool StateMachine_PostEventTo(uint8_t instance, StateMachineEvent_t event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_EVENT_BUS_H */
@@ -23,7 +23,20 @@ extern "C" {
 #include "sm_platform.h"
 #include "sm_state_machine.h"
 #include "sm_error_handler.h"
+#include "sm_comm_breaker.h"
 #include "sm_debug.h"
+#include "sm_trace.h"
+#include "sm_perf_trace.h"
+#include "sm_histogram.h"
+#include "sm_cadence.h"
+#include "sm_metrics.h"
+#include "sm_error_persist.h"
+#include "sm_snapshot.h"
+#include "sm_observer.h"
+#include "sm_async.h"
+#include "sm_event_bus.h"
+#include "sm_worker_pool.h"
+#include "sm_metrics_server.h"
 
 /* =============================================================================
  * FRAMEWORK VERSION
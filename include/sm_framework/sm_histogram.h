@@ -0,0 +1,168 @@
+/**
+ * @file sm_histogram.h
+ * @brief Log-linear (HDR-style) histograms
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Fixed-memory histogram for latencies and durations where the tail matters
+ * more than the average. Values below 2^HISTOGRAM_SUB_BITS get one bucket
+ * each; above that every power of two is split into 2^HISTOGRAM_SUB_BITS
+ * linear buckets, so a bucket is at most 1 / 2^HISTOGRAM_SUB_BITS (12.5% by
+ * default) wide relative to its values:
+ *
+ * @code
+ *   0 1 2 .. 7 | 8 9 .. 15 | 16 18 .. 30 | 32 36 .. 60 | ...
+ * @endcode
+ *
+ * Recording is O(1) (one count-leading-zeros, no loops, no allocation).
+ * Values of 2^HISTOGRAM_MAX_BITS and above land in the last bucket; min, max
+ * and the sum stay exact.
+ *
+ * A histogram has a single writer. To combine threads or instances, let each
+ * record into its own histogram and add them with Histogram_Merge(), or send
+ * them as Histogram_Serialize() blobs and merge after Histogram_Deserialize().
+ *
+ * @code
+ *   static Histogram_t latency;
+ *   Histogram_Init(&latency);
+ *   Histogram_Record(&latency, elapsed_us);
+ *   p99 = Histogram_Percentile(&latency, 990U);
+ * @endcode
+ */
+
+#ifndef SM_HISTOGRAM_H
+#define SM_HISTOGRAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+
+/** Linear buckets per power of two */
+#define HISTOGRAM_SUB_COUNT   (1U << HISTOGRAM_SUB_BITS)
+
+/** Number of buckets */
+#define HISTOGRAM_BUCKETS     ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 1U) << HISTOGRAM_SUB_BITS)
+
+/** Largest value with its own bucket */
+#define HISTOGRAM_MAX_VALUE   ((uint32_t)((1ULL << HISTOGRAM_MAX_BITS) - 1U))
+
+/** Serialized histogram magic ("HG") */
+#define HISTOGRAM_MAGIC       (0x4748U)
+
+/** Serialized histogram format version */
+#define HISTOGRAM_VERSION     (1U)
+
+/** Serialized header (28 bytes) + CRC-32 (4 bytes) */
+#define HISTOGRAM_SERIALIZED_OVERHEAD (32U)
+
+/** Upper bound of a serialized histogram (6 bytes per non-empty bucket) */
+#define HISTOGRAM_SERIALIZED_MAX_SIZE (HISTOGRAM_SERIALIZED_OVERHEAD + (HISTOGRAM_BUCKETS * 6U))
+
+/**
+ * @brief Histogram
+ */
+typedef struct {
+    uint32_t counts[HISTOGRAM_BUCKETS];   /**< Values per bucket */
+    uint64_t sum;                         /**< Sum of all values */
+    uint32_t total;                       /**< Values recorded */
+    uint32_t min;                         /**< Smallest value (0 if empty) */
+    uint32_t max;                         /**< Largest value */
+} Histogram_t;
+
+/* =============================================================================
+ * HISTOGRAM API
+ * ===========================================================================*/
+
+/**
+ * @brief Clear a histogram
+ *
+ * @param histogram Histogram to clear
+ */
+void Histogram_Init(Histogram_t *histogram);
+
+/**
+ * @brief Record one value
+ *
+ * @param histogram Histogram
+ * @param value Value (unit chosen by the owner)
+ */
+void Histogram_Record(Histogram_t *histogram, uint32_t value);
+
+/**
+ * @brief Add all values of one histogram to another
+ *
+ * @param dest Histogram to add to
+ * @param src Histogram to add
+ * @return true if merged, false on NULL or saturating counters
+ */
+bool Histogram_Merge(Histogram_t *dest, const Histogram_t *src);
+
+/**
+ * @brief Value at a percentile
+ *
+ * @param histogram Histogram
+ * @param per_mille Percentile in 1/1000 (500 = median, 990 = p99, 999 = p99.9)
+ * @return Upper bound of the bucket holding that rank (capped at max), 0 if empty
+ */
+uint32_t Histogram_Percentile(const Histogram_t *histogram, uint32_t per_mille);
+
+/**
+ * @brief Mean of the recorded values
+ *
+ * @param histogram Histogram
+ * @return Mean (0 if empty)
+ */
+uint32_t Histogram_Mean(const Histogram_t *histogram);
+
+/**
+ * @brief Bucket a value is counted in
+ *
+ * @param value Value
+ * @return Bucket index (0 to HISTOGRAM_BUCKETS - 1)
+ */
+uint32_t Histogram_BucketIndex(uint32_t value);
+
+/**
+ * @brief Smallest value counted in a bucket
+ *
+ * @param bucket Bucket index (HISTOGRAM_BUCKETS gives the end of the range)
+ * @return Lower bound
+ */
+uint32_t Histogram_BucketLower(uint32_t bucket);
+
+/**
+ * @brief Serialize a histogram (little-endian, empty buckets omitted)
+ *
+ * Layout:
+ * @code
+ *   magic u16 | version u8 | sub_bits u8 | max_bits u8 | reserved u8 |
+ *   entries u16 | total u32 | min u32 | max u32 | sum u64 |
+ *   entries x (bucket u16 | count u32) | crc32 u32
+ * @endcode
+ *
+ * @param histogram Histogram
+ * @param buffer Output buffer
+ * @param size Size of buffer (HISTOGRAM_SERIALIZED_MAX_SIZE is always enough)
+ * @return Bytes written, 0 if buffer is NULL or too small
+ */
+uint32_t Histogram_Serialize(const Histogram_t *histogram, uint8_t *buffer, uint32_t size);
+
+/**
+ * @brief Load a serialized histogram
+ *
+ * @param histogram Filled on success (unchanged on failure)
+ * @param data Blob from Histogram_Serialize()
+ * @param length Blob length
+ * @return true if loaded, false if corrupt or recorded with another bucket layout
+ */
+bool Histogram_Deserialize(Histogram_t *histogram, const uint8_t *data, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_HISTOGRAM_H */
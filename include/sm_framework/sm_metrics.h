@@ -0,0 +1,173 @@
+/**
+ * @file sm_metrics.h
+ * @brief OpenMetrics / Prometheus text exporter
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Renders the framework counters and histograms in the OpenMetrics text
+ * format into a caller-provided buffer - no allocation, no printf:
+ *
+ * @code
+ *   # TYPE sm_transitions counter
+ *   # HELP sm_transitions State transitions.
+ *   sm_transitions_total{instance="pump"} 42
+ *   # TYPE sm_event_latency_seconds histogram
+ *   sm_event_latency_seconds_bucket{instance="pump",le="0.000007"} 3
+ *   ...
+ *   # EOF
+ * @endcode
+ *
+ * Always exported: current state (stateset), ticks, error reports per code,
+ * rate-limited repeats per code, critical lock. From SM_STATS_LEVEL 1 also
+ * the event counters and state entries; from level 2 the event latency,
+ * state residency and task jitter histograms and deadline misses; with
+ * FEATURE_STATE_BUDGETS the budget overruns per state; with
+ * FEATURE_TRANSITION_MATRIX the handled / ignored events per state and event
+ * (non-zero pairs only).
+ *
+ * Histograms are exported with one bucket per power of two (the boundaries
+ * do not change between scrapes). Durations are in seconds.
+ *
+ * Application metrics go into the same exposition by rendering them with
+ * the same writer before Metrics_Finish():
+ *
+ * @code
+ *   MetricsWriter_t writer;
+ *   Metrics_WriterInit(&writer, buffer, sizeof(buffer));
+ *   Metrics_RenderFramework(&writer, "instance=\"pump\"");
+ *   Metrics_Family(&writer, "app_rpm", "gauge", "Pump speed.");
+ *   Metrics_Sample(&writer, "app_rpm", NULL, NULL, NULL, rpm);
+ *   length = Metrics_Finish(&writer);
+ * @endcode
+ */
+
+#ifndef SM_METRICS_H
+#define SM_METRICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+#include "sm_histogram.h"
+
+/** Content type of the rendered text (HTTP Content-Type header) */
+#define METRICS_CONTENT_TYPE "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+/**
+ * @brief Text output buffer
+ */
+typedef struct {
+    char *buffer;       /**< Output buffer */
+    uint32_t size;      /**< Buffer size */
+    uint32_t length;    /**< Bytes written */
+    bool overflow;      /**< Set when the buffer was too small */
+} MetricsWriter_t;
+
+/* =============================================================================
+ * METRICS API
+ * ===========================================================================*/
+
+/**
+ * @brief Render the framework metrics into a buffer
+ *
+ * Shortcut for Metrics_WriterInit(), Metrics_RenderFramework() and
+ * Metrics_Finish().
+ *
+ * @param buffer Output buffer (NUL-terminated on success)
+ * @param size Size of buffer
+ * @param labels Labels added to every sample, e.g. "instance=\"pump\"" (NULL for none)
+ * @return Length of the text, 0 if the buffer is too small
+ */
+uint32_t Metrics_Render(char *buffer, uint32_t size, const char *labels);
+
+/**
+ * @brief Start writing into a buffer
+ *
+ * @param writer Writer
+ * @param buffer Output buffer
+ * @param size Size of buffer
+ */
+void Metrics_WriterInit(MetricsWriter_t *writer, char *buffer, uint32_t size);
+
+/**
+ * @brief Write all framework metric families
+ *
+ * @param writer Writer
+ * @param labels Labels added to every sample (NULL for none); written
+ *        verbatim, so values must already be escaped
+ */
+void Metrics_RenderFramework(MetricsWriter_t *writer, const char *labels);
+
+/**
+ * @brief Write a metric family header (# TYPE / # HELP)
+ *
+ * @param writer Writer
+ * @param name Family name (without _total)
+ * @param type "counter", "gauge", "histogram", "stateset", ...
+ * @param help Description
+ */
+void Metrics_Family(MetricsWriter_t *writer, const char *name, const char *type, const char *help);
+
+/**
+ * @brief Write one integer sample
+ *
+ * @param writer Writer
+ * @param name Sample name (with _total for counters)
+ * @param labels Common labels (NULL for none)
+ * @param key Extra label name (NULL for none)
+ * @param key_value Extra label value (escaped as needed)
+ * @param value Sample value
+ */
+void Metrics_Sample(MetricsWriter_t *writer, const char *name, const char *labels,
+                    const char *key, const char *key_value, uint64_t value);
+
+/**
+ * @brief Write the samples of a histogram
+ *
+ * @param writer Writer
+ * @param name Family name
+ * @param labels Common labels (NULL for none)
+ * @param key Extra label name (NULL for none)
+ * @param key_value Extra label value
+ * @param histogram Histogram
+ * @param units_per_second Histogram unit: 1000000 for us, 1000 for ms, 1 for s
+ */
+void Metrics_Histogram(MetricsWriter_t *writer, const char *name, const char *labels,
+                       const char *key, const char *key_value,
+                       const Histogram_t *histogram, uint32_t units_per_second);
+
+/**
+ * @brief Write the terminating "# EOF" line
+ *
+ * @param writer Writer
+ * @return Length of the text (NUL-terminated), 0 if the buffer was too small
+ */
+uint32_t Metrics_Finish(MetricsWriter_t *writer);
+
+#if FEATURE_TRANSITION_MATRIX
+/**
+ * @brief Render the transition matrix as a CSV heat map
+ *
+ * One row per state, one column per event:
+ * @code
+ *   state,INIT_COMPLETE,START,STOP,...
+ *   INIT,1,0,0,...
+ *   IDLE,0,412,3,...
+ * @endcode
+ *
+ * @param buffer Output buffer (NUL-terminated on success)
+ * @param size Size of buffer
+ * @param ignored false for handled events (hot transitions), true for ignored ones
+ * @return Length of the text, 0 if the buffer is too small
+ */
+uint32_t Metrics_RenderTransitionMatrix(char *buffer, uint32_t size, bool ignored);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_METRICS_H */
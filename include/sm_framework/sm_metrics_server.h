@@ -0,0 +1,101 @@
+/**
+ * @file sm_metrics_server.h
+ * @brief Local metrics endpoint: OpenMetrics over HTTP (TCP or Unix socket)
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Minimal HTTP/1.0 responder for Prometheus-style scrapers on Linux hosts.
+ * Every GET is answered with Metrics_Render() output; there is no thread -
+ * App_Main_Task() calls MetricsServer_Poll() between ticks
+ * (FEATURE_METRICS_SERVER), so the rendered values are consistent and the
+ * framework state is never read concurrently.
+ *
+ * @code
+ *   MetricsServer_OpenTcp(9464);                  // 127.0.0.1 only
+ *   MetricsServer_SetLabels("instance=\"pump\"");
+ *   // curl http://127.0.0.1:9464/metrics
+ *
+ *   MetricsServer_OpenUnix("/run/sm/metrics.sock");
+ *   // curl --unix-socket /run/sm/metrics.sock http://localhost/metrics
+ * @endcode
+ *
+ * Sockets are nonblocking and never stall the tick: each poll reads and
+ * sends only what is ready, so a slow client is continued on later polls.
+ * The cost on the tick is the render (once per scrape) plus a few system
+ * calls per open connection. Up to METRICS_SERVER_MAX_PER_POLL scrapes are
+ * in progress at once; one not answered within METRICS_SERVER_TIMEOUT_MS
+ * of being accepted is closed.
+ */
+
+#ifndef SM_METRICS_SERVER_H
+#define SM_METRICS_SERVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+
+/** Scrapes in progress at once (connection slots) */
+#define METRICS_SERVER_MAX_PER_POLL (4U)
+
+/* =============================================================================
+ * METRICS SERVER API
+ * ===========================================================================*/
+
+/**
+ * @brief Listen on a loopback TCP port
+ *
+ * Closes any endpoint opened before.
+ *
+ * @param port TCP port on 127.0.0.1 (0 = any free port, see MetricsServer_GetPort())
+ * @return true if listening
+ */
+bool MetricsServer_OpenTcp(uint16_t port);
+
+/**
+ * @brief Listen on a Unix domain socket
+ *
+ * A stale socket file at path is replaced; any other existing file makes
+ * the call fail. Closes any endpoint opened before.
+ *
+ * @param path Socket path
+ * @return true if listening
+ */
+bool MetricsServer_OpenUnix(const char *path);
+
+/**
+ * @brief Stop listening (removes the Unix socket file)
+ */
+void MetricsServer_Close(void);
+
+/**
+ * @brief Set the labels added to every sample
+ *
+ * @param labels e.g. "instance=\"pump\"" (NULL for none); must stay valid
+ */
+void MetricsServer_SetLabels(const char *labels);
+
+/**
+ * @brief Accept new scrapes and advance open ones (called by App_Main_Task())
+ *
+ * Never blocks.
+ *
+ * @return Number of responses completed in this call
+ */
+uint32_t MetricsServer_Poll(void);
+
+/**
+ * @brief Get the TCP port being listened on
+ *
+ * @return Port, 0 if not listening on TCP
+ */
+uint16_t MetricsServer_GetPort(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_METRICS_SERVER_H */
@@ -0,0 +1,127 @@
+/**
+ * @file sm_observer.h
+ * @brief Transition observers (publish/subscribe)
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Metrics, logging or persistence code can watch every state transition
+ * without touching the state machine. Up to SM_MAX_OBSERVERS callbacks are
+ * kept in a fixed array; each has a filter on the triggering event, the state
+ * being left and the state being entered.
+ *
+ * Filters are compiled into per-event and per-state bitmasks of observers
+ * when they change. A transition ANDs three words to find the interested
+ * observers, so an observer that does not match a transition costs nothing.
+ *
+ * @code
+ *   ObserverFilter_t filter;
+ *   Observer_FilterAll(&filter);
+ *   filter.to_states = OBSERVER_STATE_BIT(STATE_RECOVERY) | OBSERVER_STATE_BIT(STATE_CRITICAL_ERROR);
+ *   handle = Observer_Subscribe(OnFault, NULL, &filter);
+ * @endcode
+ */
+
+#ifndef SM_OBSERVER_H
+#define SM_OBSERVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+
+/** Handle returned when no observer slot is free */
+#define OBSERVER_INVALID_HANDLE (0xFFU)
+
+/** Bit of a state in ObserverFilter_t from_states / to_states */
+#define OBSERVER_STATE_BIT(state) (1UL << (uint32_t)(state))
+
+/**
+ * @brief Transition passed to observers
+ */
+typedef struct {
+    StateMachineState_t from;      /**< State left */
+    StateMachineState_t to;        /**< State entered */
+    StateMachineEvent_t event;     /**< Triggering event (EVENT_NONE for forced) */
+    uint32_t exec_count;           /**< Executions of the state left */
+} ObserverTransition_t;
+
+/**
+ * @brief Observer callback
+ *
+ * Runs in the state machine task after the new state is set and before its
+ * on_entry. May post events; must not block.
+ *
+ * @param transition The transition
+ * @param context Pointer given to Observer_Subscribe()
+ */
+typedef void (*Observer_t)(const ObserverTransition_t *transition, void *context);
+
+/**
+ * @brief Which transitions an observer wants (all three must match)
+ */
+typedef struct {
+    uint32_t events[SM_EVENT_MASK_WORDS];   /**< Triggering events (SM_EVENT_MASK_SET) */
+    uint32_t from_states;                   /**< States left (OBSERVER_STATE_BIT) */
+    uint32_t to_states;                     /**< States entered (OBSERVER_STATE_BIT) */
+} ObserverFilter_t;
+
+/* =============================================================================
+ * OBSERVER API
+ * ===========================================================================*/
+
+/**
+ * @brief Remove all observers (called by StateMachine_Init())
+ */
+void Observer_Init(void);
+
+/**
+ * @brief Fill a filter that matches every transition
+ *
+ * @param filter Filter to fill
+ */
+void Observer_FilterAll(ObserverFilter_t *filter);
+
+/**
+ * @brief Register an observer
+ *
+ * @param observer Callback
+ * @param context Passed back to the callback (can be NULL)
+ * @param filter Transitions to observe (NULL = all)
+ * @return Handle, OBSERVER_INVALID_HANDLE if all SM_MAX_OBSERVERS slots are used
+ *
+ * @warning Call from the state machine task (not concurrently with ticks)
+ */
+uint8_t Observer_Subscribe(Observer_t observer, void *context, const ObserverFilter_t *filter);
+
+/**
+ * @brief Change the filter of an observer
+ *
+ * @param handle Handle from Observer_Subscribe()
+ * @param filter New filter (NULL = all)
+ * @return true if changed, false if the handle is invalid
+ */
+bool Observer_SetFilter(uint8_t handle, const ObserverFilter_t *filter);
+
+/**
+ * @brief Remove an observer (also allowed from inside an observer callback)
+ *
+ * @param handle Handle from Observer_Subscribe()
+ * @return true if removed, false if the handle is invalid
+ */
+bool Observer_Unsubscribe(uint8_t handle);
+
+/**
+ * @brief Call the observers interested in a transition (called by the state machine)
+ *
+ * @param transition The transition
+ */
+void Observer_Notify(const ObserverTransition_t *transition);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_OBSERVER_H */
@@ -0,0 +1,171 @@
+/**
+ * @file sm_perf_trace.h
+ * @brief State residency and callback timing trace (Chrome trace-event JSON)
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * While active, the state machine records:
+ * - one span per state visit (entry -> exit)
+ * - one slice per on_entry / on_state / on_exit callback
+ * - one instant per transition, named after the triggering event
+ *
+ * Events are stored as 12-byte binary records in a caller-provided buffer.
+ * JSON is only produced by PerfTrace_Flush(), in bulk, outside the tick.
+ * The output loads in chrome://tracing and ui.perfetto.dev.
+ *
+ * Timestamps come from Platform_GetTimeUs().
+ */
+
+#ifndef SM_PERF_TRACE_H
+#define SM_PERF_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+
+/* =============================================================================
+ * TRACE EVENTS
+ * ===========================================================================*/
+
+/**
+ * @brief Performance trace event kinds
+ */
+typedef enum {
+    PERF_TRACE_STATE_SPAN = 0,  /**< Time spent in a state */
+    PERF_TRACE_ON_ENTRY,        /**< on_entry callback */
+    PERF_TRACE_ON_STATE,        /**< on_state callback */
+    PERF_TRACE_ON_EXIT,         /**< on_exit callback */
+    PERF_TRACE_TRANSITION,      /**< Transition instant */
+    PERF_TRACE_KIND_MAX
+} PerfTraceKind_t;
+
+/**
+ * @brief Buffered trace event (12 bytes)
+ */
+typedef struct {
+    uint32_t ts_us;       /**< Start time (Platform_GetTimeUs()) */
+    uint32_t dur_us;      /**< Duration (0 for instants) */
+    uint8_t kind;         /**< PerfTraceKind_t */
+    uint8_t state;        /**< State (transition: new state) */
+    uint8_t event;        /**< Transition: triggering event */
+    uint8_t from;         /**< Transition: previous state */
+} PerfTraceEvent_t;
+
+/**
+ * @brief Output function for PerfTrace_Flush()
+ *
+ * @param data JSON text
+ * @param length Length of data in bytes
+ * @param context User context passed to PerfTrace_Start()
+ * @return Number of bytes written
+ */
+typedef uint32_t (*PerfTraceWriter_t)(const char *data, uint32_t length, void *context);
+
+/* =============================================================================
+ * TRACE API
+ * ===========================================================================*/
+
+/**
+ * @brief Start tracing
+ *
+ * @param events Event buffer
+ * @param capacity Number of events the buffer holds
+ * @param writer Output function for flushed JSON
+ * @param context User context for writer (e.g. a FILE *)
+ * @return true if started, false if invalid parameters
+ *
+ * @note If the buffer fills up, further events are dropped and counted
+ *       (see PerfTrace_GetDropped()); call PerfTrace_Flush() between ticks
+ *       often enough to keep up.
+ */
+bool PerfTrace_Start(PerfTraceEvent_t *events, uint32_t capacity,
+                     PerfTraceWriter_t writer, void *context);
+
+/**
+ * @brief Close the open state span, flush everything and end the JSON document
+ */
+void PerfTrace_Stop(void);
+
+/**
+ * @brief Convert buffered events to JSON and pass them to the writer
+ *
+ * @return Number of events flushed
+ *
+ * @warning Call from the state machine task (not concurrently with ticks)
+ */
+uint32_t PerfTrace_Flush(void);
+
+/**
+ * @brief Get the number of events dropped because the buffer was full
+ *
+ * @return Dropped events since PerfTrace_Start()
+ */
+uint32_t PerfTrace_GetDropped(void);
+
+/**
+ * @brief Check whether tracing is active
+ *
+ * @return true between PerfTrace_Start() and PerfTrace_Stop()
+ */
+bool PerfTrace_IsActive(void);
+
+/**
+ * @brief Writer for stdio files (context is a FILE *)
+ */
+uint32_t PerfTrace_WriteFile(const char *data, uint32_t length, void *context);
+
+/* =============================================================================
+ * INSTRUMENTATION HOOKS (called by the state machine)
+ * ===========================================================================*/
+
+/**
+ * @brief Begin a callback slice
+ *
+ * @return Start time, or 0 when tracing is inactive
+ */
+uint32_t PerfTrace_SliceBegin(void);
+
+/**
+ * @brief End a callback slice
+ *
+ * @param kind PERF_TRACE_ON_ENTRY, PERF_TRACE_ON_STATE or PERF_TRACE_ON_EXIT
+ * @param state State owning the callback
+ * @param start_us Value returned by PerfTrace_SliceBegin()
+ */
+void PerfTrace_SliceEnd(PerfTraceKind_t kind, StateMachineState_t state, uint32_t start_us);
+
+/**
+ * @brief Record a transition (closes the span of the previous state)
+ *
+ * @param from Previous state
+ * @param to New state
+ * @param event Triggering event
+ */
+void PerfTrace_Transition(StateMachineState_t from, StateMachineState_t to,
+                          StateMachineEvent_t event);
+
+/**
+ * @brief Time a state callback
+ *
+ * Expands to a plain call when FEATURE_PERF_TRACE is disabled.
+ */
+#if FEATURE_PERF_TRACE
+#define PERF_TRACE_SLICE(kind, state, call)                         \
+    do {                                                            \
+        uint32_t perf_start_us_ = PerfTrace_SliceBegin();           \
+        call;                                                       \
+        PerfTrace_SliceEnd((kind), (state), perf_start_us_);        \
+    } while (0)
+#else
+#define PERF_TRACE_SLICE(kind, state, call) call
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_PERF_TRACE_H */
@@ -47,6 +47,21 @@ extern "C" {
  */
 uint32_t Platform_GetTimeMs(void);
 
+/**
+ * @brief Get high-resolution time in microseconds
+ *
+ * Used for profiling (callback timing, trace export) - not for timeouts.
+ *
+ * @return uint32_t Current time in microseconds (wraps at 32-bit limit)
+ *
+ * @note Implementation examples:
+ *   - Cortex-M: return DWT->CYCCNT / (SystemCoreClock / 1000000U);
+ *   - ESP32: return (uint32_t)esp_timer_get_time();
+ *   - RP2040: return time_us_32();
+ *   - Default: virtual simulation clock in microseconds (ms resolution)
+ */
+uint32_t Platform_GetTimeUs(void);
+
 /**
  * @brief Check if timeout has occurred (handles 32-bit wraparound)
  *
@@ -0,0 +1,264 @@
+/**
+ * @file sm_sim.h
+ * @brief Deterministic simulation clock and event record/replay API
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * The default (weak) Platform_GetTimeMs() reads the virtual clock declared
+ * here. By default the clock advances by 1 ms on every read, which is the
+ * classic simulation behavior. Setting the auto-increment to 0 makes time
+ * fully deterministic: it only moves when SimClock_AdvanceBy() or
+ * SimClock_AdvanceTo() is called.
+ *
+ * The recorder logs every StateMachine_PostEvent() and ErrorHandler_Report()
+ * with the tick and time it happened into a compact binary trace. The replayer re-runs a trace through
+ * StateMachine_Execute() on the virtual clock as fast as the CPU allows.
+ *
+ * The fast-forward driver runs long simulations (days of virtual time) by
+ * jumping over ticks in which nothing can happen, i.e. no pending event, no
+ * state entry, no state timeout or periodic message due, and a current state
+ * that is not flagged SM_STATE_FLAG_TIME_DEPENDENT.
+ *
+ * @note Replay requires the default platform timing (Platform_GetTimeMs()
+ *       must not be overridden).
+ */
+
+#ifndef SM_SIM_H
+#define SM_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_state_machine.h"
+
+/* =============================================================================
+ * VIRTUAL CLOCK
+ * ===========================================================================*/
+
+/**
+ * @brief Reset the virtual clock
+ *
+ * @param start_ms New current time in milliseconds
+ */
+void SimClock_Reset(uint32_t start_ms);
+
+/**
+ * @brief Get current virtual time without advancing it
+ *
+ * @return Current virtual time in milliseconds
+ */
+uint32_t SimClock_Now(void);
+
+/**
+ * @brief Read virtual time and apply the auto-increment
+ *
+ * @return Virtual time before the auto-increment was applied
+ *
+ * @note Used by the default Platform_GetTimeMs()
+ */
+uint32_t SimClock_Read(void);
+
+/**
+ * @brief Advance virtual time by a duration
+ *
+ * @param delta_ms Milliseconds to advance
+ */
+void SimClock_AdvanceBy(uint32_t delta_ms);
+
+/**
+ * @brief Advance virtual time to an absolute time
+ *
+ * @param time_ms Target time in milliseconds
+ *
+ * @note Time never moves backwards - targets in the past are ignored
+ *       (wraparound-safe for targets up to 2^31 ms ahead)
+ */
+void SimClock_AdvanceTo(uint32_t time_ms);
+
+/**
+ * @brief Set how far the clock advances on every SimClock_Read()
+ *
+ * @param step_ms Milliseconds per read (0 = deterministic, default 1)
+ */
+void SimClock_SetAutoIncrement(uint32_t step_ms);
+
+/* =============================================================================
+ * EVENT TRACE RECORD / REPLAY
+ * ===========================================================================*/
+
+/** Trace record flag: event was posted from inside StateMachine_Execute() */
+#define SIM_TRACE_FLAG_INTERNAL  SM_POST_FLAG_INTERNAL
+/** Trace record flag: event was accepted into the queue */
+#define SIM_TRACE_FLAG_ACCEPTED  SM_POST_FLAG_ACCEPTED
+/** Trace record flag: event was posted from inside ErrorHandler_Report() */
+#define SIM_TRACE_FLAG_ERROR     SM_POST_FLAG_ERROR
+/** Trace record flag: error report (event byte holds the ErrorCode_t) */
+#define SIM_TRACE_FLAG_REPORT    (0x40U)
+/** Trace record flag: end-of-trace marker */
+#define SIM_TRACE_FLAG_END       (0x80U)
+
+/** Size of the binary trace header in bytes */
+#define SIM_TRACE_HEADER_SIZE    (16U)
+
+/**
+ * @brief Binary event trace
+ *
+ * Header: "SMTR", version, reserved[3], start tick (u32), start time (u32).
+ * Records: LEB128 tick delta, LEB128 time delta, event (u8), flags (u8) -
+ * typically 4 bytes per event. Error report records (SIM_TRACE_FLAG_REPORT)
+ * carry the error code in the event byte and one extra ErrorLevel_t byte.
+ */
+typedef struct {
+    uint8_t *buffer;          /**< Trace storage (header + records) */
+    uint32_t capacity;        /**< Size of buffer in bytes */
+    uint32_t length;          /**< Bytes used */
+    uint32_t record_count;    /**< Number of records (including end marker) */
+    uint32_t last_tick;       /**< Tick of the previous record */
+    uint32_t last_time;       /**< Time of the previous record */
+    bool overflow;            /**< Buffer filled up - trace is truncated */
+} SimTrace_t;
+
+/**
+ * @brief Replay summary
+ */
+typedef struct {
+    uint32_t ticks;              /**< Ticks replayed (executed + skipped) */
+    uint32_t ticks_skipped;      /**< Idle ticks skipped in fast-forward mode */
+    uint32_t events_injected;    /**< External events re-posted */
+    uint32_t errors_injected;    /**< External error reports re-issued */
+    uint32_t internal_expected;  /**< Internal posts found in the trace */
+    uint32_t internal_observed;  /**< Internal posts seen during replay */
+    uint32_t end_time;           /**< Virtual time at end of replay */
+    StateMachineState_t final_state; /**< State at end of replay */
+} SimReplayResult_t;
+
+/**
+ * @brief Start recording events into a trace buffer
+ *
+ * Installs a post hook on the state machine and a report hook on the error
+ * handler. Start recording right after initialization so a replay starts
+ * from the same state.
+ *
+ * @param trace Trace to record into
+ * @param buffer Storage for the trace
+ * @param capacity Size of buffer in bytes (>= SIM_TRACE_HEADER_SIZE)
+ * @return true if recording started, false if invalid parameters
+ */
+bool SimTrace_StartRecording(SimTrace_t *trace, uint8_t *buffer, uint32_t capacity);
+
+/**
+ * @brief Stop recording and append the end-of-trace marker
+ */
+void SimTrace_StopRecording(void);
+
+/**
+ * @brief Attach an existing trace image (e.g. loaded from a file)
+ *
+ * @param trace Trace to initialize
+ * @param buffer Buffer holding the trace image
+ * @param length Number of valid bytes in buffer
+ * @return true if the header is valid, false otherwise
+ */
+bool SimTrace_Attach(SimTrace_t *trace, uint8_t *buffer, uint32_t length);
+
+/**
+ * @brief Replay a trace through StateMachine_Execute()
+ *
+ * Re-initializes the state machine on a deterministic virtual clock, runs
+ * the same number of ticks between events as recorded and re-posts every
+ * external event and error report. Error reports go through
+ * ErrorHandler_Report() so their side effects (history, counters, recovery
+ * events) are reproduced. Internal events and reports are regenerated by the
+ * state callbacks and only counted, so a mismatch indicates divergence from
+ * the recording.
+ *
+ * @param trace Recorded trace
+ * @param result Replay summary (can be NULL)
+ * @return true if the whole trace was replayed, false on a corrupt trace
+ *
+ * @note Leaves the virtual clock in deterministic mode (auto-increment 0)
+ */
+bool SimTrace_Replay(const SimTrace_t *trace, SimReplayResult_t *result);
+
+/**
+ * @brief Save a trace to a file
+ *
+ * @param trace Trace to save
+ * @param path File path
+ * @return true if written completely
+ */
+bool SimTrace_Save(const SimTrace_t *trace, const char *path);
+
+/**
+ * @brief Load a trace from a file
+ *
+ * @param trace Trace to initialize
+ * @param buffer Storage for the trace image
+ * @param capacity Size of buffer in bytes
+ * @param path File path
+ * @return true if loaded and header valid
+ */
+bool SimTrace_Load(SimTrace_t *trace, uint8_t *buffer, uint32_t capacity, const char *path);
+
+/**
+ * @brief Enable fast-forward during replay
+ *
+ * When enabled, SimTrace_Replay() skips idle ticks the same way as
+ * SimDriver_RunUntil(). Disabled by default.
+ *
+ * @param enable true to skip idle ticks
+ */
+void SimTrace_SetFastForward(bool enable);
+
+/* =============================================================================
+ * FAST-FORWARD DRIVER
+ * ===========================================================================*/
+
+/**
+ * @brief Fast-forward run summary
+ */
+typedef struct {
+    uint32_t ticks_executed;  /**< App_Main_Task() calls */
+    uint32_t ticks_skipped;   /**< Idle ticks jumped over */
+    uint32_t end_time;        /**< Virtual time at end of run */
+} SimDriverStats_t;
+
+/**
+ * @brief Get the number of upcoming ticks that can be skipped
+ *
+ * Ticks can be skipped while StateMachine_IsTickRequired() is false and no
+ * worker pool results or event bus events are waiting, up to the next state
+ * timeout or periodic debug message. A skipped tick is
+ * equivalent to an App_Main_Task() call that does nothing.
+ *
+ * @param max_ticks Upper bound for the result
+ * @return Number of ticks that can be skipped (0 = execute the next tick)
+ *
+ * @note Assumes the virtual clock advances SM_TASK_PERIOD_MS per tick
+ */
+uint32_t SimDriver_SkippableTicks(uint32_t max_ticks);
+
+/**
+ * @brief Run App_Main_Task() on the virtual clock until a given time
+ *
+ * Executes ticks one task period apart and jumps over idle stretches
+ * (see SimDriver_SkippableTicks()). Tick counters and timing-driven
+ * behavior (timeouts, periodic messages) match a tick-by-tick run.
+ *
+ * @param end_time_ms Virtual time to stop at
+ * @param stats Run summary, accumulated into (can be NULL)
+ *
+ * @note Switches the virtual clock to deterministic mode (auto-increment 0)
+ * @warning States whose on_state counts ticks or polls time must be flagged
+ *          SM_STATE_FLAG_TIME_DEPENDENT (see StateMachine_SetStateFlags())
+ */
+void SimDriver_RunUntil(uint32_t end_time_ms, SimDriverStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_SIM_H */
@@ -0,0 +1,143 @@
+/**
+ * @file sm_snapshot.h
+ * @brief Snapshot and restore of the complete state machine state
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * StateMachine_Snapshot() serializes the context (current/previous state,
+ * time in state, counters), the pending event queue, the state-specific data
+ * and the error handler (current error, history, recovery schedule) into a
+ * compact, versioned blob. StateMachine_Restore() resumes from it after
+ * StateMachine_Init() - in the same state, with the same pending events -
+ * instead of walking INIT -> IDLE again. The progress of a state's async
+ * action (sm_async.h) is not stored: it restarts from the beginning, as on
+ * entry into the state.
+ *
+ * Blob layout (little-endian, independent of struct layout and packing):
+ * @code
+ *   magic u32 | version u8 | STATE_MAX u8 | EVENT_MAX u8 | ERROR_CODE_MAX u8 |
+ *   length u32 | crc32 u32 | body (length - 16 bytes)
+ * @endcode
+ *
+ * Times that drive behavior (state entry, recovery deadline, minor error
+ * window) are stored relative to the snapshot and re-based on restore.
+ * Statistics, rate limiters, error rates and circuit breakers are not
+ * included - they restart empty.
+ */
+
+#ifndef SM_SNAPSHOT_H
+#define SM_SNAPSHOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+
+/* =============================================================================
+ * SNAPSHOT FORMAT
+ * ===========================================================================*/
+
+/** Snapshot magic ("SMSS") */
+#define SM_SNAPSHOT_MAGIC      (0x53534D53UL)
+
+/** Snapshot format version */
+#define SM_SNAPSHOT_VERSION    (1U)
+
+/** Size of the blob header */
+#define SM_SNAPSHOT_HEADER_SIZE (16U)
+
+/** Upper bound of a snapshot with the current configuration */
+#define SM_SNAPSHOT_MAX_SIZE \
+    (SM_SNAPSHOT_HEADER_SIZE + 64U + SM_EVENT_QUEUE_SIZE + ((ERROR_HISTORY_SIZE + 1U) * 21U))
+
+/* =============================================================================
+ * SNAPSHOT API
+ * ===========================================================================*/
+
+/**
+ * @brief Serialize the state machine into a buffer
+ *
+ * @param buffer Output buffer
+ * @param size Size of buffer (SM_SNAPSHOT_MAX_SIZE is always enough)
+ * @return Blob length in bytes, 0 if buffer is NULL or too small
+ *
+ * @warning Call from the state machine task (not concurrently with ticks)
+ */
+uint32_t StateMachine_Snapshot(uint8_t *buffer, uint32_t size);
+
+/**
+ * @brief Resume from a snapshot
+ *
+ * Call after StateMachine_Init() (or App_Main_Init()). No callbacks run: the
+ * next tick continues with on_state of the restored state, and its async
+ * action (if any) starts over.
+ *
+ * @param data Blob from StateMachine_Snapshot()
+ * @param length Blob length
+ * @return true if restored, false if the blob is invalid, corrupt or from an
+ *         incompatible build (the state machine is left unchanged)
+ */
+bool StateMachine_Restore(const uint8_t *data, uint32_t length);
+
+/* =============================================================================
+ * SERIALIZATION HELPERS (used by the snapshot sections)
+ * ===========================================================================*/
+
+/**
+ * @brief Snapshot output stream
+ */
+typedef struct {
+    uint8_t *data;        /**< Output buffer */
+    uint32_t size;        /**< Buffer size */
+    uint32_t length;      /**< Bytes written */
+    bool overflow;        /**< A write did not fit */
+} SnapshotWriter_t;
+
+/**
+ * @brief Snapshot input stream
+ */
+typedef struct {
+    const uint8_t *data;  /**< Input buffer */
+    uint32_t length;      /**< Bytes available */
+    uint32_t offset;      /**< Bytes consumed */
+    bool underflow;       /**< A read ran past the end */
+} SnapshotReader_t;
+
+void Snapshot_PutU8(SnapshotWriter_t *writer, uint8_t value);
+void Snapshot_PutU16(SnapshotWriter_t *writer, uint16_t value);
+void Snapshot_PutU32(SnapshotWriter_t *writer, uint32_t value);
+uint8_t Snapshot_GetU8(SnapshotReader_t *reader);
+uint16_t Snapshot_GetU16(SnapshotReader_t *reader);
+uint32_t Snapshot_GetU32(SnapshotReader_t *reader);
+
+/**
+ * @brief CRC-32 (IEEE 802.3) of a byte range
+ */
+uint32_t Snapshot_Crc32(const uint8_t *data, uint32_t length);
+
+/**
+ * @brief Write the error handler section (called by StateMachine_Snapshot())
+ *
+ * @param writer Output stream
+ * @param now Snapshot time (Platform_GetTimeMs())
+ */
+void ErrorHandler_SaveSnapshot(SnapshotWriter_t *writer, uint32_t now);
+
+/**
+ * @brief Read the error handler section (called by StateMachine_Restore())
+ *
+ * @param reader Input stream
+ * @param now Restore time (Platform_GetTimeMs())
+ * @param apply false to only validate, true to load
+ * @return true if the section is valid
+ */
+bool ErrorHandler_LoadSnapshot(SnapshotReader_t *reader, uint32_t now, bool apply);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_SNAPSHOT_H */
@@ -17,6 +17,7 @@ extern "C" {
 #endif
 
 #include "sm_types.h"
+#include "sm_histogram.h"
 
 /* =============================================================================
  * STATE MACHINE INITIALIZATION
@@ -74,15 +75,27 @@ void StateMachine_Reset(void);
  *
  * @param event Event to post
  * @return true if event posted successfully, false if event queue full
+ *         (or, with SM_REJECT_UNHANDLED_EVENTS, not handled in current state)
  *
  * @note THREAD-SAFE: This function uses critical sections and can be called
  *       from interrupts or different tasks.
  *
- * @warning Only ONE event can be pending at a time. If an event is already
- *          pending, this function returns false and the new event is dropped.
+ * @warning Up to SM_EVENT_QUEUE_SIZE events can be pending (default: one).
+ *          If the queue is full, this function returns false and the new
+ *          event is dropped.
  */
 bool StateMachine_PostEvent(StateMachineEvent_t event);
 
+/**
+ * @brief Check whether the event queue is full
+ *
+ * Lets forwarders (e.g. EventBus_Poll()) keep events in their own buffer
+ * instead of losing them to a full queue.
+ *
+ * @return true if StateMachine_PostEvent() would refuse any event now
+ */
+bool StateMachine_IsQueueFull(void);
+
 /* =============================================================================
  * STATE QUERIES
  * ===========================================================================*/
@@ -103,6 +116,17 @@ StateMachineState_t StateMachine_GetCurrentState(void);
  */
 StateMachineState_t StateMachine_GetPreviousState(void);
 
+/**
+ * @brief Get the visit number of the current state
+ *
+ * Changes on every state entry (also when the same state is re-entered),
+ * so work started in one visit can tell whether it still belongs to the
+ * current one.
+ *
+ * @return Visit number (wraps around)
+ */
+uint32_t StateMachine_GetStateVisit(void);
+
 /**
  * @brief Get time spent in current state
  *
@@ -119,6 +143,56 @@ uint32_t StateMachine_GetStateTime(void);
  */
 uint32_t StateMachine_GetExecutionCount(void);
 
+/**
+ * @brief Get number of StateMachine_Execute() calls since initialization
+ *
+ * @return Tick counter (wraps at 32-bit limit)
+ */
+uint32_t StateMachine_GetTickCount(void);
+
+/**
+ * @brief Check whether the next tick has work to do
+ *
+ * A tick is required when an event is pending, the current state was just
+ * entered, a critical lock must be applied, the current state is flagged
+ * SM_STATE_FLAG_TIME_DEPENDENT, or its async action can resume. Timeouts and
+ * async timers are not considered - see StateMachine_GetTimeoutDeadline() and
+ * StateMachine_GetAsyncWakeTime().
+ *
+ * @return true if the next StateMachine_Execute() call must not be skipped
+ *
+ * @note Used by fast-forward simulation drivers (see sm_sim.h)
+ */
+bool StateMachine_IsTickRequired(void);
+
+/**
+ * @brief Get the time at which the current state times out
+ *
+ * @param deadline_ms Filled with the timeout time (state entry + timeout)
+ * @return true if the current state has a timeout, false otherwise
+ */
+bool StateMachine_GetTimeoutDeadline(uint32_t *deadline_ms);
+
+/**
+ * @brief Get the time at which the current state's async action resumes
+ *
+ * @param wake_ms Filled with the wake time
+ * @return true if the async action is suspended in ASYNC_AWAIT_TIME()
+ */
+bool StateMachine_GetAsyncWakeTime(uint32_t *wake_ms);
+
+/**
+ * @brief Account for ticks skipped by a fast-forward driver
+ *
+ * Advances the tick and execution counters as if StateMachine_Execute() had
+ * run with nothing to do.
+ *
+ * @param ticks Number of skipped ticks
+ *
+ * @warning Only valid while StateMachine_IsTickRequired() returns false
+ */
+void StateMachine_SkipTicks(uint32_t ticks);
+
 /* =============================================================================
  * STRING CONVERSION UTILITIES
  * ===========================================================================*/
@@ -164,6 +238,18 @@ bool StateMachine_AddTransition(StateMachineState_t state,
                                  StateMachineEvent_t event,
                                  StateMachineState_t next_state);
 
+/**
+ * @brief Check whether a state has a transition for an event
+ *
+ * Constant-time lookup in the per-state handled-event bitset, which is kept
+ * in sync with the transition table.
+ *
+ * @param state State to query
+ * @param event Event to query
+ * @return true if the event triggers a transition in this state
+ */
+bool StateMachine_IsEventHandled(StateMachineState_t state, StateMachineEvent_t event);
+
 /**
  * @brief Set state timeout
  *
@@ -191,11 +277,154 @@ bool StateMachine_SetStateCallbacks(StateMachineState_t state,
                                      void (*on_state)(void),
                                      void (*on_exit)(void));
 
+/** Post hook flag: event was posted from inside StateMachine_Execute() */
+#define SM_POST_FLAG_INTERNAL (0x01U)
+/** Post hook flag: event was accepted into the queue */
+#define SM_POST_FLAG_ACCEPTED (0x02U)
+/** Post hook flag: event was posted from inside ErrorHandler_Report() */
+#define SM_POST_FLAG_ERROR (0x04U)
+
+/**
+ * @brief Function pointer type for event post hook
+ *
+ * @param event Event that was posted
+ * @param flags Combination of SM_POST_FLAG_* values
+ */
+typedef void (*StateMachinePostHook_t)(StateMachineEvent_t event, uint8_t flags);
+
+/**
+ * @brief Set hook called after every StateMachine_PostEvent()
+ *
+ * Used by the event recorder (see sm_sim.h).
+ *
+ * @param hook Hook function (NULL to remove)
+ *
+ * @note The hook runs in the caller's context (may be an ISR)
+ */
+void StateMachine_SetPostHook(StateMachinePostHook_t hook);
+
+/**
+ * @brief Check whether StateMachine_Execute() is running
+ *
+ * @return true inside StateMachine_Execute() (including callbacks)
+ */
+bool StateMachine_IsExecuting(void);
+
+/**
+ * @brief Set the async action of a state (see sm_async.h)
+ *
+ * The action runs in addition to on_state, restarting on every entry into
+ * the state.
+ *
+ * @param state State to configure
+ * @param action Async action (NULL to remove)
+ * @return true if successful, false if invalid state
+ */
+bool StateMachine_SetStateAsync(StateMachineState_t state, AsyncAction_t action);
+
+/**
+ * @brief Set state flags
+ *
+ * @param state State to configure
+ * @param flags Combination of SM_STATE_FLAG_* values
+ * @return true if successful, false if invalid state
+ *
+ * @note Declare SM_STATE_FLAG_TIME_DEPENDENT for every state whose on_state
+ *       counts ticks or polls time; fast-forward drivers skip ticks in all
+ *       other states.
+ */
+bool StateMachine_SetStateFlags(StateMachineState_t state, uint8_t flags);
+
+/* =============================================================================
+ * EXECUTION BUDGETS (if FEATURE_STATE_BUDGETS)
+ * ===========================================================================*/
+
+#if FEATURE_STATE_BUDGETS
+
+/**
+ * @brief Execution budget accounting of one state
+ */
+typedef struct {
+    uint32_t budget_us;        /**< Current budget (0 = none) */
+    uint32_t runs;             /**< Ticks measured against the budget */
+    uint32_t overruns;         /**< Ticks over budget */
+    uint32_t max_us;           /**< Longest measured tick */
+    uint32_t last_overrun_us;  /**< Duration of the most recent overrun */
+} StateBudgetStats_t;
+
+/**
+ * @brief Set the per-tick execution budget of a state
+ *
+ * on_state and the async action of the state are timed together with
+ * Platform_GetTimeUs() on every tick. A tick over budget is counted and, if
+ * the state has SM_STATE_FLAG_BUDGET_MINOR, reported as a MINOR error with
+ * ERROR_CODE_BUDGET_OVERRUN. The overrun cannot be interrupted - the budget
+ * is an early warning, not a watchdog.
+ *
+ * @param state State to configure
+ * @param budget_us Budget in microseconds (0 = none, no clock reads)
+ * @return true if successful, false if invalid state
+ */
+bool StateMachine_SetStateBudget(StateMachineState_t state, uint32_t budget_us);
+
+/**
+ * @brief Get the budget accounting of a state
+ *
+ * @param state State to query
+ * @param stats Filled with the counters
+ * @return true if successful, false if invalid state or stats is NULL
+ */
+bool StateMachine_GetBudgetStats(StateMachineState_t state, StateBudgetStats_t *stats);
+
+/**
+ * @brief Reset the budget accounting of all states (budgets are kept)
+ */
+void StateMachine_ResetBudgetStats(void);
+
+#endif /* FEATURE_STATE_BUDGETS */
+
+/* =============================================================================
+ * TRANSITION MATRIX (if FEATURE_TRANSITION_MATRIX)
+ * ===========================================================================*/
+
+#if FEATURE_TRANSITION_MATRIX
+
+/**
+ * @brief Dispatch counters of one (state, event) pair
+ *
+ * Timestamps are tick numbers (StateMachine_GetTickCount()), so counting
+ * needs no clock read; multiply by SM_TASK_PERIOD_MS for milliseconds.
+ */
+typedef struct {
+    uint32_t hits;         /**< Handled: transition taken or event awaited by the async action */
+    uint32_t ignored;      /**< Dispatched but not handled in this state */
+    uint32_t first_tick;   /**< Tick the pair was first seen */
+    uint32_t last_tick;    /**< Tick the pair was last seen */
+} TransitionMatrixCell_t;
+
+/**
+ * @brief Get the counters of a (state, event) pair
+ *
+ * @param state State the event was dispatched in
+ * @param event Event
+ * @param cell Filled with the counters
+ * @return true if successful, false if invalid parameters
+ */
+bool StateMachine_GetTransitionCell(StateMachineState_t state, StateMachineEvent_t event,
+                                    TransitionMatrixCell_t *cell);
+
+/**
+ * @brief Clear the transition matrix
+ */
+void StateMachine_ResetTransitionMatrix(void);
+
+#endif /* FEATURE_TRANSITION_MATRIX */
+
 /* =============================================================================
- * STATISTICS (if FEATURE_STATISTICS_ENABLED)
+ * STATISTICS (SM_STATS_LEVEL >= 1, histograms from level 2)
  * ===========================================================================*/
 
-#if FEATURE_STATISTICS_ENABLED
+#if SM_STATS_LEVEL >= 1
 
 /**
  * @brief State machine statistics
@@ -204,10 +433,16 @@ typedef struct {
     uint32_t total_transitions;        /**< Total number of state transitions */
     uint32_t total_events_posted;      /**< Total events posted */
     uint32_t total_events_dropped;     /**< Events dropped (queue full) */
+    uint32_t total_events_ignored;     /**< Events not handled in the current state */
     uint32_t total_timeouts;           /**< State timeouts occurred */
     uint32_t state_entry_counts[SM_MAX_STATES]; /**< Times each state entered */
     uint32_t max_execution_time_us;    /**< Maximum execution time */
     uint32_t avg_execution_time_us;    /**< Average execution time */
+    /* Level 2 and up; zero at level 1 */
+    CadenceStats_t cadence;            /**< App_Main_Task() interval and jitter (sm_cadence.h) */
+    uint32_t event_latency_p50_us;     /**< Post to dispatch latency, median */
+    uint32_t event_latency_p99_us;     /**< Post to dispatch latency, 99th percentile */
+    uint32_t event_latency_max_us;     /**< Post to dispatch latency, worst case */
 } StateMachineStats_t;
 
 /**
@@ -219,11 +454,38 @@ typedef struct {
 bool StateMachine_GetStats(StateMachineStats_t *stats);
 
 /**
- * @brief Reset statistics counters
+ * @brief Reset statistics counters (including the cadence monitor and histograms)
  */
 void StateMachine_ResetStats(void);
 
-#endif /* FEATURE_STATISTICS_ENABLED */
+#if SM_STATS_LEVEL >= 2
+
+/**
+ * @brief Get a copy of the event latency histogram
+ *
+ * Time from StateMachine_PostEvent() to the tick that dispatches the event,
+ * in microseconds (Platform_GetTimeUs()).
+ *
+ * @param histogram Filled with the histogram
+ * @return true if filled, false if histogram is NULL
+ */
+bool StateMachine_GetEventLatencyHistogram(Histogram_t *histogram);
+
+/**
+ * @brief Get a copy of the residency histogram of a state
+ *
+ * Time spent in the state per visit, in milliseconds, recorded when the
+ * next state is entered.
+ *
+ * @param state State
+ * @param histogram Filled with the histogram
+ * @return true if filled, false if state is invalid or histogram is NULL
+ */
+bool StateMachine_GetResidencyHistogram(StateMachineState_t state, Histogram_t *histogram);
+
+#endif /* SM_STATS_LEVEL >= 2 */
+
+#endif /* SM_STATS_LEVEL >= 1 */
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,151 @@
+/**
+ * @file sm_trace.h
+ * @brief Binary transition trace ring
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Every state transition is written as a fixed-size binary record into a
+ * ring in caller-provided memory. Recording costs a handful of stores and
+ * one release store of the write counter - no formatting, no locks.
+ *
+ * Memory layout (also the file layout of an mmap export):
+ * @code
+ *   TransitionTraceHeader_t   64 bytes
+ *   TransitionRecord_t[capacity]
+ * @endcode
+ *
+ * Readers (in-process or an external tool mapping the same memory) read
+ * write_count, copy records and read write_count again. Records with an index
+ * below (write_count - capacity) may have been overwritten and are discarded.
+ */
+
+#ifndef SM_TRACE_H
+#define SM_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+
+/* =============================================================================
+ * TRACE FORMAT
+ * ===========================================================================*/
+
+/** Trace header magic ("SMTT") */
+#define TRANSITION_TRACE_MAGIC    (0x54544D53UL)
+
+/** Trace format version */
+#define TRANSITION_TRACE_VERSION  (1U)
+
+/**
+ * @brief Transition record (16 bytes)
+ */
+typedef struct {
+    uint32_t seq;          /**< Record index (monotonic, wraps at 2^32) */
+    uint32_t timestamp;    /**< Platform_GetTimeMs() at transition */
+    uint32_t exec_count;   /**< Executions of the state being left */
+    uint8_t from;          /**< Previous state */
+    uint8_t to;            /**< New state */
+    uint8_t event;         /**< Triggering event (EVENT_NONE for forced) */
+    uint8_t reserved;      /**< Reserved (0) */
+} TransitionRecord_t;
+
+/**
+ * @brief Trace header (one cache line)
+ */
+typedef struct {
+    uint32_t magic;                 /**< TRANSITION_TRACE_MAGIC */
+    uint16_t version;               /**< TRANSITION_TRACE_VERSION */
+    uint16_t record_size;           /**< sizeof(TransitionRecord_t) */
+    uint32_t capacity;              /**< Records in the ring (power of two) */
+    volatile uint32_t write_count;  /**< Records written since init */
+    uint8_t reserved[48];           /**< Reserved (0) */
+} TransitionTraceHeader_t;
+
+/* Fixed on-disk layout for external readers */
+_Static_assert(sizeof(TransitionRecord_t) == 16U, "TransitionRecord_t must be 16 bytes");
+_Static_assert(sizeof(TransitionTraceHeader_t) == 64U, "TransitionTraceHeader_t must be 64 bytes");
+
+/* =============================================================================
+ * TRACE API
+ * ===========================================================================*/
+
+/**
+ * @brief Start tracing into a memory region
+ *
+ * Formats the region as header + ring. The capacity is the largest power of
+ * two that fits.
+ *
+ * @param memory Region to use (4-byte aligned)
+ * @param size Size of region in bytes
+ * @return true if tracing started, false if region too small (< 1 record)
+ */
+bool TransitionTrace_Init(void *memory, uint32_t size);
+
+/**
+ * @brief Stop tracing (the region is left intact for readers)
+ */
+void TransitionTrace_Stop(void);
+
+/**
+ * @brief Check whether tracing is active
+ *
+ * @return true if a region is attached
+ */
+bool TransitionTrace_IsActive(void);
+
+/**
+ * @brief Append a transition record
+ *
+ * Called by the state machine on every transition when
+ * FEATURE_TRANSITION_TRACE is enabled. Does nothing if tracing is inactive.
+ *
+ * @param from Previous state
+ * @param to New state
+ * @param event Triggering event
+ * @param exec_count Executions of the previous state
+ */
+void TransitionTrace_Record(StateMachineState_t from, StateMachineState_t to,
+                            StateMachineEvent_t event, uint32_t exec_count);
+
+/**
+ * @brief Copy records from the active trace
+ *
+ * @param since_seq First record index wanted (0 = oldest available)
+ * @param records Output buffer
+ * @param max_records Size of output buffer
+ * @param next_seq Filled with the index to pass next time (can be NULL)
+ * @return Number of records copied (records already overwritten are skipped)
+ */
+uint32_t TransitionTrace_Read(uint32_t since_seq, TransitionRecord_t *records,
+                              uint32_t max_records, uint32_t *next_seq);
+
+/**
+ * @brief Trace into a memory-mapped file (Linux)
+ *
+ * Creates (or truncates) the file and maps it shared, so an external tool can
+ * tail the trace while the process runs (see examples/trace_tail.c).
+ *
+ * @param path File path
+ * @param capacity Number of records (rounded down to a power of two)
+ * @return true if tracing started
+ *
+ * @note Only available with ENABLE_POSIX_EXTENSIONS
+ */
+bool TransitionTrace_MapFile(const char *path, uint32_t capacity);
+
+/**
+ * @brief Stop tracing and unmap the file created by TransitionTrace_MapFile()
+ *
+ * @note Only available with ENABLE_POSIX_EXTENSIONS
+ */
+void TransitionTrace_UnmapFile(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_TRACE_H */
@@ -24,6 +24,42 @@ extern "C" {
 /* Include user configuration */
 #include "sm_config.h"
 
+/* =============================================================================
+ * COMPILER HELPERS
+ * ===========================================================================*/
+
+/**
+ * @brief Align a type or variable to the data cache line size
+ *
+ * Expands to nothing on compilers without a known alignment attribute.
+ */
+#if defined(__GNUC__) || defined(__clang__) || defined(__CC_ARM)
+    #define SM_CACHE_ALIGNED __attribute__((aligned(SM_CACHE_LINE_SIZE)))
+#else
+    #define SM_CACHE_ALIGNED
+#endif
+
+/**
+ * @brief Acquire load / release store for data shared with other threads,
+ *        processes or ISRs
+ *
+ * Falls back to plain volatile accesses on compilers without __atomic
+ * builtins (sufficient on single-core MCUs).
+ */
+#if defined(__GNUC__) || defined(__clang__)
+    #define SM_HAS_ATOMIC_BUILTINS      (1U)
+    #define SM_ATOMIC_LOAD(ptr)         __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define SM_ATOMIC_LOAD_RELAXED(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+    #define SM_ATOMIC_STORE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+    #define SM_ATOMIC_FENCE()           __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+    #define SM_HAS_ATOMIC_BUILTINS      (0U)
+    #define SM_ATOMIC_LOAD(ptr)         (*(ptr))
+    #define SM_ATOMIC_LOAD_RELAXED(ptr) (*(ptr))
+    #define SM_ATOMIC_STORE(ptr, value) (*(ptr) = (value))
+    #define SM_ATOMIC_FENCE()
+#endif
+
 /* =============================================================================
  * STATE AND EVENT ENUMERATIONS
  * ===========================================================================*/
@@ -104,19 +140,64 @@ typedef enum {
     ERROR_CODE_HARDWARE_FAULT,       /**< Hardware fault detected */
     ERROR_CODE_WATCHDOG_RESET,       /**< Watchdog reset occurred */
     ERROR_CODE_MEMORY_CORRUPTION,    /**< Memory corruption detected */
+    ERROR_CODE_BUDGET_OVERRUN,       /**< State callback exceeded its execution budget */
     ERROR_CODE_MAX                   /**< Number of error codes (must be last) */
 } ErrorCode_t;
 
+/* =============================================================================
+ * STORAGE TYPES
+ * ===========================================================================*/
+
+/**
+ * @brief Storage types for states, events and error identifiers
+ *
+ * Used for table, queue and history fields. With FEATURE_PACKED_ENCODING they
+ * are uint8_t, otherwise the enum types themselves. Function parameters and
+ * return values always use the enum types.
+ */
+#if FEATURE_PACKED_ENCODING
+typedef uint8_t StateStorage_t;
+typedef uint8_t EventStorage_t;
+typedef uint8_t ErrorLevelStorage_t;
+typedef uint8_t ErrorCodeStorage_t;
+#else
+typedef StateMachineState_t StateStorage_t;
+typedef StateMachineEvent_t EventStorage_t;
+typedef ErrorLevel_t ErrorLevelStorage_t;
+typedef ErrorCode_t ErrorCodeStorage_t;
+#endif
+
+/**
+ * @brief Bitset with one bit per event (see SM_MAX_EVENTS)
+ */
+#define SM_EVENT_MASK_WORDS (((SM_MAX_EVENTS) + 31U) / 32U)
+
+/** Test whether event bit is set in an event mask */
+#define SM_EVENT_MASK_TEST(mask, event) \
+    ((((mask)[(uint32_t)(event) >> 5]) >> ((uint32_t)(event) & 31U)) & 1U)
+
+/** Set event bit in an event mask */
+#define SM_EVENT_MASK_SET(mask, event) \
+    ((mask)[(uint32_t)(event) >> 5] |= (1UL << ((uint32_t)(event) & 31U)))
+
+/* =============================================================================
+ * ERROR INFORMATION
+ * ===========================================================================*/
+
 /**
  * @brief Error information structure
  *
  * Stores detailed information about an error occurrence.
+ * Timestamp first so the narrow fields pack without padding.
  */
 typedef struct {
-    ErrorLevel_t level;          /**< Error severity level */
-    ErrorCode_t code;            /**< Specific error code */
-    uint32_t timestamp;          /**< Time when error occurred */
-    StateMachineState_t state;   /**< State when error occurred */
+    uint32_t timestamp;          /**< Time when error occurred (first, if aggregated) */
+    uint32_t last_timestamp;     /**< Time of the last aggregated repeat */
+    uint32_t seq;                /**< History sequence number (1, 2, ...; 0 = none) */
+    uint16_t count;              /**< Occurrences folded into this entry (rate limiting) */
+    ErrorLevelStorage_t level;   /**< Error severity level (ErrorLevel_t) */
+    ErrorCodeStorage_t code;     /**< Specific error code (ErrorCode_t) */
+    StateStorage_t state;        /**< State when error occurred (StateMachineState_t) */
     uint8_t retry_count;         /**< Number of recovery attempts */
     bool is_recovered;           /**< Recovery status */
 } ErrorInfo_t;
@@ -138,6 +219,26 @@ typedef enum {
     DEBUG_MSG_MAX            /**< Number of message types (must be last) */
 } DebugMessageType_t;
 
+/** Mask bit of a message type in a debug module mask */
+#define DEBUG_MSG_BIT(type)      ((uint32_t)1U << (uint32_t)(type))
+
+/** All message types */
+#define DEBUG_MSG_ALL            (DEBUG_MSG_BIT(DEBUG_MSG_MAX) - 1U)
+
+/**
+ * @brief Debug modules (each has its own message type mask)
+ *
+ * A source file selects its module by defining DEBUG_MODULE before
+ * including the framework headers; files that do not are DEBUG_MODULE_APP.
+ */
+typedef enum {
+    DEBUG_MODULE_APP = 0,    /**< Application code and app_main.c */
+    DEBUG_MODULE_CORE,       /**< State machine core and periodic status */
+    DEBUG_MODULE_ERROR,      /**< Error handler and recovery */
+    DEBUG_MODULE_COMM,       /**< Communication channels (circuit breakers) */
+    DEBUG_MODULE_MAX         /**< Number of modules (must be last) */
+} DebugModule_t;
+
 /**
  * @brief Communication interface types
  */
@@ -169,66 +270,230 @@ typedef struct {
  * @brief State transition definition
  */
 typedef struct {
-    StateMachineEvent_t event;   /**< Event that triggers transition */
-    StateMachineState_t next_state; /**< Target state */
+    EventStorage_t event;        /**< Event that triggers transition */
+    StateStorage_t next_state;   /**< Target state */
 } StateTransition_t;
 
+/** State flag: on_state must run on every tick (counts ticks, polls time) */
+#define SM_STATE_FLAG_TIME_DEPENDENT (0x01U)
+
+/** State flag: report execution budget overruns as MINOR errors (ERROR_CODE_BUDGET_OVERRUN) */
+#define SM_STATE_FLAG_BUDGET_MINOR   (0x02U)
+
+/**
+ * @brief What a suspended async state action waits for (see sm_async.h)
+ */
+typedef enum {
+    ASYNC_WAIT_NONE = 0,       /**< Not started - runs on the next tick */
+    ASYNC_WAIT_TICK,           /**< Resume on every tick (yield, await condition) */
+    ASYNC_WAIT_TIME,           /**< Resume once wake_time is reached */
+    ASYNC_WAIT_EVENT,          /**< Resume once wait_event has been dispatched */
+    ASYNC_WAIT_IO,             /**< Resume once *io_done is true */
+    ASYNC_WAIT_DONE            /**< Finished for this visit of the state */
+} AsyncWait_t;
+
+/**
+ * @brief Result of running an async state action
+ */
+typedef enum {
+    ASYNC_WAITING = 0,         /**< Suspended, see AsyncContext_t wait */
+    ASYNC_DONE                 /**< Reached ASYNC_END() */
+} AsyncStatus_t;
+
+/**
+ * @brief Resume state of an async state action (reset on every state entry)
+ */
+typedef struct {
+    uint32_t wake_time;             /**< ASYNC_WAIT_TIME deadline */
+    const volatile bool *io_done;   /**< ASYNC_WAIT_IO completion flag */
+    uint16_t resume_point;          /**< Line to continue at (0 = start) */
+    uint8_t wait;                   /**< AsyncWait_t */
+    uint8_t wait_event;             /**< ASYNC_WAIT_EVENT event */
+} AsyncContext_t;
+
+/**
+ * @brief Async state action (written with the sm_async.h macros)
+ */
+typedef AsyncStatus_t (*AsyncAction_t)(AsyncContext_t *async);
+
 /**
  * @brief State configuration
  *
  * FIXED: Uses SM_MAX_TRANSITIONS_PER_STATE constant instead of hardcoded 5
+ *
+ * Fields are ordered hot-first: everything read on every tick and on event
+ * dispatch sits at the start of the row, entry/exit data follows.
  */
 typedef struct {
-    StateMachineState_t state_id;                              /**< State identifier */
-    void (*on_entry)(void);                                     /**< Entry callback */
     void (*on_state)(void);                                     /**< State callback */
-    void (*on_exit)(void);                                      /**< Exit callback */
-    StateTransition_t transitions[SM_MAX_TRANSITIONS_PER_STATE]; /**< Transition table */
-    uint8_t transition_count;                                   /**< Number of transitions */
+    AsyncAction_t on_async;                                     /**< Async state action */
     uint32_t timeout_ms;                                        /**< State timeout */
+    uint32_t budget_us;                                         /**< on_state + async budget per tick (0 = none) */
+    uint32_t handled_events[SM_EVENT_MASK_WORDS];               /**< Events with a transition */
+    uint8_t transition_count;                                   /**< Number of transitions */
+    uint8_t flags;                                              /**< SM_STATE_FLAG_* */
+    StateTransition_t transitions[SM_MAX_TRANSITIONS_PER_STATE]; /**< Transition table */
+    void (*on_entry)(void);                                     /**< Entry callback */
+    void (*on_exit)(void);                                      /**< Exit callback */
+    StateMachineState_t state_id;                              /**< State identifier */
 } StateConfig_t;
 
+/**
+ * @brief Per-error-code token bucket for report rate limiting
+ */
+typedef struct {
+    uint32_t last_refill;         /**< Time tokens were last added */
+    uint32_t first_suppressed;    /**< Time of first suppressed repeat */
+    uint32_t last_suppressed;     /**< Time of last suppressed repeat */
+    uint32_t pending;             /**< Suppressed repeats not yet in history */
+    uint32_t suppressed_total;    /**< Suppressed repeats since init */
+    uint16_t refill_ms;           /**< Milliseconds per token */
+    uint8_t burst;                /**< Bucket size (0 = unlimited) */
+    uint8_t tokens;               /**< Tokens available */
+    ErrorLevelStorage_t level;    /**< Level of the suppressed repeats */
+    StateStorage_t state;         /**< State at the last suppressed repeat */
+} ErrorRateBucket_t;
+
+/**
+ * @brief Recovery scheduling strategies
+ */
+typedef enum {
+    RECOVERY_STRATEGY_IMMEDIATE = 0,   /**< Retry on the next tick */
+    RECOVERY_STRATEGY_FIXED,           /**< Retry after a fixed delay */
+    RECOVERY_STRATEGY_BACKOFF,         /**< Exponential backoff with jitter */
+    RECOVERY_STRATEGY_CIRCUIT_BREAKER, /**< Stop trying for a while after repeated failures */
+    RECOVERY_STRATEGY_MAX              /**< Number of strategies (must be last) */
+} RecoveryStrategy_t;
+
+/**
+ * @brief Per-error-code recovery policy
+ */
+typedef struct {
+    uint32_t delay_ms;            /**< Fixed delay / first backoff delay / breaker retry spacing */
+    uint32_t max_delay_ms;        /**< Backoff: delay cap */
+    uint32_t open_ms;             /**< Circuit breaker: time open before a trial attempt */
+    uint8_t strategy;             /**< RecoveryStrategy_t */
+    uint8_t max_attempts;         /**< Retry budget per error (ERROR_MAX_RECOVERY_ATTEMPTS) */
+    uint8_t jitter_percent;       /**< Backoff: random spread of each delay (+/- %) */
+    uint8_t failure_threshold;    /**< Circuit breaker: consecutive failures that open it */
+} RecoveryPolicy_t;
+
+/**
+ * @brief Per-error-code circuit breaker state (persists across errors)
+ */
+typedef struct {
+    uint32_t open_until;          /**< End of the open period */
+    uint8_t consecutive_failures; /**< Failed attempts since last success */
+    bool is_open;                 /**< Attempts deferred until open_until */
+} RecoveryBreaker_t;
+
+/**
+ * @brief Error-rate windows
+ */
+typedef enum {
+    ERROR_RATE_WINDOW_1S = 0,   /**< Last second */
+    ERROR_RATE_WINDOW_1M,       /**< Last minute */
+    ERROR_RATE_WINDOW_1H,       /**< Last hour */
+    ERROR_RATE_WINDOW_MAX       /**< Number of windows (must be last) */
+} ErrorRateWindow_t;
+
+/**
+ * @brief Bucketed error counters for all windows
+ *
+ * Each bucket is stamped with its epoch (time / bucket length); readers only
+ * sum buckets whose epoch lies inside the window, so idle periods need no
+ * clean-up and memory stays constant.
+ */
+typedef struct {
+    volatile uint32_t epoch[ERROR_RATE_WINDOW_MAX][ERROR_RATE_BUCKETS];
+    volatile uint32_t by_code[ERROR_RATE_WINDOW_MAX][ERROR_RATE_BUCKETS][ERROR_CODE_MAX];
+    volatile uint32_t by_state[ERROR_RATE_WINDOW_MAX][ERROR_RATE_BUCKETS][STATE_MAX];
+} ErrorRateCounters_t;
+
 /**
  * @brief Error handler context
  *
  * FIXED: Uses ERROR_HISTORY_SIZE constant instead of hardcoded 16
+ *
+ * Cold data: owned by the error handler and kept out of the state machine
+ * context so the history never shares cache lines with dispatch data.
  */
 typedef struct {
     ErrorInfo_t current_error;                 /**< Current active error */
-    ErrorInfo_t error_history[ERROR_HISTORY_SIZE]; /**< Error history buffer */
-    uint8_t history_index;                     /**< Circular buffer index */
+    ErrorInfo_t error_history[ERROR_HISTORY_SIZE]; /**< Error history ring */
+    volatile uint32_t history_claimed;         /**< Last sequence number handed out */
+    volatile uint32_t history_dropped;         /**< Entries dropped (slot busy or reused by a later lap) */
+    volatile uint32_t report_counts[ERROR_CODE_MAX]; /**< Reports per code since init */
+    ErrorRateBucket_t rate_limit[ERROR_CODE_MAX]; /**< Per-code report rate limiting */
+    uint32_t rate_limit_pending;               /**< Bit per code with pending repeats */
+    uint32_t rate_limit_aggregated;            /**< Aggregated entries written */
+    RecoveryPolicy_t recovery_policy[ERROR_CODE_MAX]; /**< Per-code recovery scheduling */
+    RecoveryBreaker_t recovery_breaker[ERROR_CODE_MAX]; /**< Per-code circuit breakers */
+    uint32_t recovery_next_time;               /**< Deadline of the next recovery attempt */
+    uint32_t recovery_jitter_seed;             /**< Backoff jitter PRNG state */
+    bool recovery_scheduled;                   /**< recovery_next_time is valid */
+#if FEATURE_ERROR_RATES
+    ErrorRateCounters_t rates;                 /**< Sliding-window error rates */
+#endif
     uint32_t minor_error_timestamp;            /**< Minor error tracking */
     uint8_t minor_good_message_count;          /**< Good message counter */
-    bool critical_lock_active;                 /**< Critical error lock flag */
 } ErrorHandler_t;
 
 /**
  * @brief State machine context
  *
- * FIXED: Added volatile qualifier for ISR-accessed field
+ * FIXED: Added volatile qualifier for ISR-accessed fields
  * Contains all runtime state for the state machine.
+ *
+ * Only data touched on every StateMachine_Execute() tick lives here, so the
+ * whole context fits in one cache line for small queue sizes. The error
+ * handler (history, current error) is kept in sm_error_handler.c.
  */
 typedef struct {
     StateMachineState_t current_state;     /**< Current active state */
-    StateMachineState_t previous_state;    /**< Previous state */
-    volatile StateMachineEvent_t pending_event; /**< Pending event (ISR-safe) */
     uint32_t state_entry_time;             /**< Time when state was entered */
+    uint32_t state_timeout_ms;             /**< Timeout of current state (0 = none) */
     uint32_t state_execution_count;        /**< Number of times state executed */
+    uint32_t tick_count;                   /**< StateMachine_Execute() calls */
+    volatile uint8_t queue_head;           /**< Index of oldest pending event */
+    volatile uint8_t queue_count;          /**< Number of pending events (ISR-safe) */
     bool state_changed;                    /**< State change flag */
-    ErrorHandler_t error_handler;          /**< Error handler context */
-} StateMachineContext_t;
+    volatile bool critical_lock_active;    /**< Critical error lock flag */
+    volatile EventStorage_t event_queue[SM_EVENT_QUEUE_SIZE]; /**< Pending events */
+    StateMachineState_t previous_state;    /**< Previous state (read on transitions only) */
+} SM_CACHE_ALIGNED StateMachineContext_t;
 
 /**
  * @brief Debug system configuration
  */
 typedef struct {
     CommInterface_t interface;         /**< Active communication interface */
-    bool enable_init_messages;         /**< Enable init messages */
-    bool enable_runtime_messages;      /**< Enable runtime messages */
-    bool enable_periodic_messages;     /**< Enable periodic messages */
     uint32_t periodic_last_time;       /**< Last periodic message time */
 } DebugConfig_t;
 
+/* =============================================================================
+ * CADENCE MONITOR TYPES
+ * ===========================================================================*/
+
+/**
+ * @brief Task cadence summary (see sm_cadence.h)
+ *
+ * Jitter is the distance of an App_Main_Task() interval from
+ * SM_TASK_PERIOD_MS; percentiles come from a log-linear histogram and are
+ * upper bucket bounds (at most 12.5% above the true value).
+ */
+typedef struct {
+    uint32_t intervals;            /**< Intervals measured */
+    uint32_t interval_min_us;      /**< Shortest interval */
+    uint32_t interval_max_us;      /**< Longest interval */
+    uint32_t interval_avg_us;      /**< Mean interval */
+    uint32_t jitter_p50_us;        /**< Median jitter */
+    uint32_t jitter_p99_us;        /**< 99th percentile jitter */
+    uint32_t jitter_p999_us;       /**< 99.9th percentile jitter */
+    uint32_t jitter_max_us;        /**< Largest jitter */
+    uint32_t deadline_misses;      /**< Intervals longer than SM_CADENCE_DEADLINE_US */
+} CadenceStats_t;
+
 /* =============================================================================
  * COMPILE-TIME VALIDATION
  * ===========================================================================*/
@@ -241,6 +506,20 @@ _Static_assert(STATE_MAX <= SM_MAX_STATES,
 _Static_assert(EVENT_MAX < 256,
     "EVENT_MAX exceeds 255 - consider using uint16_t for event type");
 
+/* Ensure the rate limiting pending mask has a bit per error code */
+_Static_assert(ERROR_CODE_MAX <= 32,
+    "ERROR_CODE_MAX exceeds 32 - widen ErrorHandler_t.rate_limit_pending");
+
+/* Ensure the handled-event bitset covers all events */
+_Static_assert(EVENT_MAX <= SM_MAX_EVENTS,
+    "EVENT_MAX exceeds SM_MAX_EVENTS - increase SM_MAX_EVENTS in configuration");
+
+#if FEATURE_PACKED_ENCODING
+/* Ensure packed storage can represent every identifier */
+_Static_assert(STATE_MAX <= 256 && ERROR_CODE_MAX <= 256 && ERROR_LEVEL_MAX <= 256,
+    "Identifiers exceed uint8_t range - disable FEATURE_PACKED_ENCODING");
+#endif
+
 /* Ensure error history size is reasonable */
 _Static_assert(ERROR_HISTORY_SIZE > 0 && ERROR_HISTORY_SIZE <= 255,
     "ERROR_HISTORY_SIZE must be between 1 and 255");
@@ -0,0 +1,160 @@
+/**
+ * @file sm_worker_pool.h
+ * @brief Worker thread pool for long-running state work (POSIX)
+ * @version 2.0.0
+ * @date 2025-12-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Heavy work (processing a data block, a calibration fit...) does not fit in
+ * one SM_TASK_PERIOD_MS tick. A state submits it as a job instead; one of
+ * WORKER_POOL_THREADS threads runs it while the state machine keeps ticking:
+ *
+ * @code
+ *   static ErrorCode_t ProcessBlock(void *arg)
+ *   {
+ *       return Filter_Run((Block_t *)arg) ? ERROR_CODE_NONE : ERROR_CODE_INVALID_DATA;
+ *   }
+ *
+ *   static void Processing_OnEntry(void)
+ *   {
+ *       g_job = WorkerPool_Submit(ProcessBlock, &g_block);
+ *   }
+ * @endcode
+ *
+ * Completions are delivered on the tick thread, at the start of
+ * App_Main_Task() (FEATURE_WORKER_POOL): a job returning ERROR_CODE_NONE posts
+ * its done event (EVENT_PROCESSING_DONE by default), any other code is passed
+ * to ErrorHandler_Report(). Neither happens if the submitting state has been
+ * left in the meantime (even if it was entered again since) or the job was
+ * cancelled - a late result cannot trigger a transition in an unrelated
+ * state or a later visit of the same one.
+ *
+ * The queue is bounded (WORKER_POOL_QUEUE_SIZE jobs, queued, running or
+ * awaiting delivery); a full pool rejects the submit. Jobs run concurrently
+ * with the state machine and must not call framework functions other than
+ * StateMachine_PostEvent().
+ */
+
+#ifndef SM_WORKER_POOL_H
+#define SM_WORKER_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sm_types.h"
+
+/** Job ID returned when a job could not be submitted */
+#define WORKER_JOB_INVALID (0UL)
+
+/**
+ * @brief Job function, run on a worker thread
+ *
+ * @param arg Pointer given at submit
+ * @return ERROR_CODE_NONE on success, otherwise the error to report
+ */
+typedef ErrorCode_t (*WorkerJob_t)(void *arg);
+
+/**
+ * @brief Worker pool statistics
+ */
+typedef struct {
+    uint32_t submitted;        /**< Jobs accepted */
+    uint32_t rejected;         /**< Submits refused (pool full or not running) */
+    uint32_t succeeded;        /**< Done events posted */
+    uint32_t failed;           /**< Errors reported */
+    uint32_t discarded;        /**< Results dropped (cancelled, owning visit over, or done event refused) */
+    uint32_t max_pending;      /**< Highest number of jobs in the pool at once */
+} WorkerPoolStats_t;
+
+/* =============================================================================
+ * WORKER POOL API
+ * ===========================================================================*/
+
+/**
+ * @brief Start the worker threads
+ *
+ * @return true if all WORKER_POOL_THREADS threads started (or already running)
+ */
+bool WorkerPool_Init(void);
+
+/**
+ * @brief Stop and join the worker threads
+ *
+ * Waits for running jobs to return; queued jobs and undelivered results are
+ * discarded.
+ */
+void WorkerPool_Shutdown(void);
+
+/**
+ * @brief Submit a job on behalf of the current state
+ *
+ * Same as WorkerPool_SubmitEx(job, arg, EVENT_PROCESSING_DONE, ERROR_LEVEL_NORMAL).
+ *
+ * @param job Job function
+ * @param arg Passed to the job (must stay valid until it completes)
+ * @return Job ID, WORKER_JOB_INVALID if the pool is full or not running
+ *
+ * @warning Call from the state machine task
+ */
+uint32_t WorkerPool_Submit(WorkerJob_t job, void *arg);
+
+/**
+ * @brief Submit a job with its own completion event and failure severity
+ *
+ * @param job Job function
+ * @param arg Passed to the job (must stay valid until it completes)
+ * @param done_event Posted when the job returns ERROR_CODE_NONE (EVENT_NONE = none)
+ * @param fail_level Severity reported when the job returns an error code
+ * @return Job ID, WORKER_JOB_INVALID if the pool is full or not running
+ *
+ * @warning Call from the state machine task
+ */
+uint32_t WorkerPool_SubmitEx(WorkerJob_t job, void *arg, StateMachineEvent_t done_event,
+                             ErrorLevel_t fail_level);
+
+/**
+ * @brief Cancel a job
+ *
+ * A queued job is removed; a running job finishes but its result is
+ * discarded.
+ *
+ * @param job_id ID from WorkerPool_Submit()
+ * @return true if the job was still in the pool
+ */
+bool WorkerPool_Cancel(uint32_t job_id);
+
+/**
+ * @brief Deliver finished jobs to the state machine
+ *
+ * Called by App_Main_Task() when FEATURE_WORKER_POOL is enabled; costs one
+ * load while nothing has finished. A done event that does not fit in the
+ * full event queue stays pending and is retried on the next poll.
+ *
+ * @return Number of results delivered (events posted or errors reported)
+ */
+uint32_t WorkerPool_Poll(void);
+
+/**
+ * @brief Check whether finished jobs are waiting for WorkerPool_Poll()
+ *
+ * For tickless loops: a pending completion requires a tick.
+ *
+ * @return true if results are pending
+ */
+bool WorkerPool_HasCompletions(void);
+
+/**
+ * @brief Get worker pool statistics
+ *
+ * @param stats Filled with the counters
+ * @return true if filled
+ */
+bool WorkerPool_GetStats(WorkerPoolStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SM_WORKER_POOL_H */
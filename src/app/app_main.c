@@ -28,9 +28,32 @@ bool App_Main_Init(CommInterface_t debug_interface)
 
 void App_Main_Task(void)
 {
+#if SM_STATS_LEVEL >= 2
+    /* Interval since the previous call (jitter, deadline misses) */
+    Cadence_Record();
+#endif
+
+#if FEATURE_EVENT_BUS
+    /* Queue events posted by other processes before this tick dispatches */
+    (void)EventBus_Poll();
+#endif
+
+#if FEATURE_WORKER_POOL
+    /* Finished background jobs become events / error reports on this thread */
+    (void)WorkerPool_Poll();
+#endif
+
+#if FEATURE_METRICS_SERVER
+    /* Answer pending scrapes between ticks, never inside a transition */
+    (void)MetricsServer_Poll();
+#endif
+    
     /* Execute state machine */
     StateMachine_Execute();
     
+    /* Write aggregated entries for error storms that have ended */
+    ErrorHandler_FlushSuppressed();
+    
     /* Process periodic debug messages */
     Debug_ProcessPeriodic();
 }
@@ -0,0 +1,99 @@
+/**
+ * @file sm_cadence.c
+ * @brief Task cadence monitor (interval, jitter, deadline misses)
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_cadence.h"
+#include "sm_framework/sm_platform.h"
+#include <string.h>
+
+#define PERIOD_US      ((uint32_t)SM_TASK_PERIOD_MS * 1000U)
+
+/**
+ * @brief Cadence monitor state
+ */
+typedef struct {
+    Histogram_t jitter;                    /**< Jitter histogram */
+    uint64_t interval_sum_us;              /**< For the mean */
+    uint32_t interval_min_us;              /**< Shortest interval */
+    uint32_t interval_max_us;              /**< Longest interval */
+    uint32_t deadline_misses;              /**< Intervals over the deadline */
+    uint32_t last_us;                      /**< Previous call */
+    bool have_last;                        /**< last_us is valid */
+} Cadence_t;
+
+static Cadence_t g_cadence;
+
+void Cadence_Reset(void)
+{
+    memset(&g_cadence, 0, sizeof(g_cadence));
+}
+
+void Cadence_Record(void)
+{
+    uint32_t now = Platform_GetTimeUs();
+    uint32_t interval;
+
+    if (!g_cadence.have_last) {
+        g_cadence.last_us = now;
+        g_cadence.have_last = true;
+        return;
+    }
+
+    interval = now - g_cadence.last_us;
+    g_cadence.last_us = now;
+
+    if (g_cadence.jitter.total == 0U || interval < g_cadence.interval_min_us) {
+        g_cadence.interval_min_us = interval;
+    }
+    if (interval > g_cadence.interval_max_us) {
+        g_cadence.interval_max_us = interval;
+    }
+    if (interval > SM_CADENCE_DEADLINE_US) {
+        g_cadence.deadline_misses++;
+    }
+    g_cadence.interval_sum_us += interval;
+    Histogram_Record(&g_cadence.jitter,
+                     (interval >= PERIOD_US) ? (interval - PERIOD_US) : (PERIOD_US - interval));
+}
+
+void Cadence_Resync(void)
+{
+    g_cadence.have_last = false;
+}
+
+bool Cadence_GetStats(CadenceStats_t *stats)
+{
+    uint32_t intervals = g_cadence.jitter.total;
+
+    if (stats == NULL) {
+        return false;
+    }
+
+    memset(stats, 0, sizeof(CadenceStats_t));
+    if (intervals == 0U) {
+        return true;
+    }
+
+    stats->intervals = intervals;
+    stats->interval_min_us = g_cadence.interval_min_us;
+    stats->interval_max_us = g_cadence.interval_max_us;
+    stats->interval_avg_us = (uint32_t)(g_cadence.interval_sum_us / intervals);
+    stats->jitter_p50_us = Histogram_Percentile(&g_cadence.jitter, 500U);
+    stats->jitter_p99_us = Histogram_Percentile(&g_cadence.jitter, 990U);
+    stats->jitter_p999_us = Histogram_Percentile(&g_cadence.jitter, 999U);
+    stats->jitter_max_us = g_cadence.jitter.max;
+    stats->deadline_misses = g_cadence.deadline_misses;
+    return true;
+}
+
+bool Cadence_GetHistogram(Histogram_t *histogram)
+{
+    if (histogram == NULL) {
+        return false;
+    }
+
+    *histogram = g_cadence.jitter;
+    return true;
+}
@@ -0,0 +1,337 @@
+/**
+ * @file sm_comm_breaker.c
+ * @brief Per-channel circuit breaker implementation
+ * @version 2.0.0
+ */
+
+#define DEBUG_MODULE DEBUG_MODULE_COMM
+
+#include "sm_framework/sm_comm_breaker.h"
+#include "sm_framework/sm_platform.h"
+#include "sm_framework/sm_debug.h"
+#include <string.h>
+
+/**
+ * @brief Breaker state of one channel
+ */
+typedef struct {
+    CommBreakerConfig_t config;                     /**< Thresholds */
+    uint32_t bucket_start;                          /**< Start of the current bucket */
+    uint32_t bucket_ms;                             /**< Bucket length */
+    uint32_t open_until;                            /**< End of the open period */
+    uint32_t trips;                                 /**< Times opened */
+    uint32_t rejected;                              /**< Requests failed fast */
+    uint16_t requests[COMM_BREAKER_BUCKETS];        /**< Requests per bucket */
+    uint16_t failures[COMM_BREAKER_BUCKETS];        /**< Failures per bucket */
+    uint8_t bucket;                                 /**< Current bucket index */
+    uint8_t state;                                  /**< CommBreakerState_t */
+    uint8_t probes;                                 /**< Trial requests handed out */
+} CommBreaker_t;
+
+static CommBreaker_t g_breakers[COMM_INTERFACE_MAX];
+
+/* Forward declarations */
+static void ResetBreaker(CommBreaker_t *breaker, uint32_t now);
+static void AdvanceWindow(CommBreaker_t *breaker, uint32_t now);
+static void UpdateOpenState(CommBreaker_t *breaker, uint32_t now);
+static CommBreakerState_t CurrentState(const CommBreaker_t *breaker, uint32_t now);
+static void Trip(CommBreaker_t *breaker, uint32_t now);
+static void WindowTotals(const CommBreaker_t *breaker, uint32_t now,
+                         uint32_t *requests, uint32_t *failures);
+static const char *ChannelName(CommInterface_t channel);
+
+void CommBreaker_Init(void)
+{
+    const CommBreakerConfig_t defaults = {
+        COMM_BREAKER_WINDOW_MS, COMM_BREAKER_OPEN_MS, COMM_BREAKER_MIN_REQUESTS,
+        COMM_BREAKER_FAILURE_PERCENT, COMM_BREAKER_HALF_OPEN_PROBES
+    };
+
+    for (uint32_t channel = 0; channel < COMM_INTERFACE_MAX; channel++) {
+        (void)CommBreaker_Configure((CommInterface_t)channel, &defaults);
+    }
+}
+
+bool CommBreaker_Configure(CommInterface_t channel, const CommBreakerConfig_t *config)
+{
+    CommBreaker_t *breaker;
+
+    if (channel >= COMM_INTERFACE_MAX || config == NULL || config->window_ms == 0U ||
+        config->failure_percent == 0U || config->failure_percent > 100U ||
+        config->half_open_probes == 0U) {
+        return false;
+    }
+
+    breaker = &g_breakers[channel];
+    Platform_EnterCritical();
+    memset(breaker, 0, sizeof(CommBreaker_t));
+    breaker->config = *config;
+    breaker->bucket_ms = (config->window_ms >= COMM_BREAKER_BUCKETS)
+                       ? (config->window_ms / COMM_BREAKER_BUCKETS) : 1U;
+    ResetBreaker(breaker, 0);  /* Empty window - its start time does not matter */
+    Platform_ExitCritical();
+    return true;
+}
+
+bool CommBreaker_AllowRequest(CommInterface_t channel)
+{
+    CommBreaker_t *breaker;
+    uint32_t now;
+    bool allowed = false;
+
+    if (channel >= COMM_INTERFACE_MAX) {
+        return true;
+    }
+
+    breaker = &g_breakers[channel];
+
+    /* Closed: no clock read or critical section on the common path */
+    if (breaker->state == (uint8_t)COMM_BREAKER_CLOSED) {
+        return true;
+    }
+
+    now = Platform_GetTimeMs();
+    Platform_EnterCritical();
+    UpdateOpenState(breaker, now);
+    if (breaker->state == (uint8_t)COMM_BREAKER_CLOSED) {
+        allowed = true;  /* Closed by another context meanwhile */
+    } else if (breaker->state == (uint8_t)COMM_BREAKER_HALF_OPEN &&
+               breaker->probes < breaker->config.half_open_probes) {
+        breaker->probes++;
+        allowed = true;
+    } else {
+        breaker->rejected++;
+    }
+    Platform_ExitCritical();
+
+    return allowed;
+}
+
+void CommBreaker_RecordSuccess(CommInterface_t channel)
+{
+    CommBreaker_t *breaker;
+    uint32_t now;
+    bool closed = false;
+
+    if (channel >= COMM_INTERFACE_MAX) {
+        return;
+    }
+
+    breaker = &g_breakers[channel];
+    now = Platform_GetTimeMs();
+
+    Platform_EnterCritical();
+    UpdateOpenState(breaker, now);
+    if (breaker->state == (uint8_t)COMM_BREAKER_HALF_OPEN) {
+        ResetBreaker(breaker, now);
+        closed = true;
+    } else if (breaker->state == (uint8_t)COMM_BREAKER_CLOSED) {
+        AdvanceWindow(breaker, now);
+        if (breaker->requests[breaker->bucket] < 0xFFFFU) {
+            breaker->requests[breaker->bucket]++;
+        }
+    } else {
+        /* Open: late result of a request started before opening */
+    }
+    Platform_ExitCritical();
+
+    if (closed) {
+        DEBUG_INFO("%s circuit breaker closed", ChannelName(channel));
+    }
+}
+
+void CommBreaker_RecordFailure(CommInterface_t channel)
+{
+    CommBreaker_t *breaker;
+    uint32_t requests;
+    uint32_t failures;
+    uint32_t now;
+    bool tripped = false;
+
+    if (channel >= COMM_INTERFACE_MAX) {
+        return;
+    }
+
+    breaker = &g_breakers[channel];
+    now = Platform_GetTimeMs();
+
+    Platform_EnterCritical();
+    UpdateOpenState(breaker, now);
+
+    switch ((CommBreakerState_t)breaker->state) {
+        case COMM_BREAKER_HALF_OPEN:
+            /* Trial failed - back to open */
+            Trip(breaker, now);
+            tripped = true;
+            break;
+
+        case COMM_BREAKER_OPEN:
+            /* Late result of a request started before opening */
+            break;
+
+        case COMM_BREAKER_CLOSED:
+        default:
+            AdvanceWindow(breaker, now);
+            if (breaker->requests[breaker->bucket] < 0xFFFFU) {
+                breaker->requests[breaker->bucket]++;
+                breaker->failures[breaker->bucket]++;
+            }
+
+            WindowTotals(breaker, now, &requests, &failures);
+            if (requests >= breaker->config.min_requests &&
+                (failures * 100U) >= (requests * breaker->config.failure_percent)) {
+                Trip(breaker, now);
+                tripped = true;
+            }
+            break;
+    }
+    Platform_ExitCritical();
+
+    if (tripped) {
+        DEBUG_WARNING("%s circuit breaker open for %lu ms", ChannelName(channel),
+                      (unsigned long)breaker->config.open_ms);
+    }
+}
+
+CommBreakerState_t CommBreaker_GetState(CommInterface_t channel)
+{
+    CommBreaker_t *breaker;
+
+    if (channel >= COMM_INTERFACE_MAX) {
+        return COMM_BREAKER_CLOSED;
+    }
+
+    breaker = &g_breakers[channel];
+    if (breaker->state == (uint8_t)COMM_BREAKER_CLOSED) {
+        return COMM_BREAKER_CLOSED;
+    }
+    return CurrentState(breaker, Platform_GetTimeMs());
+}
+
+bool CommBreaker_GetStats(CommInterface_t channel, CommBreakerStats_t *stats)
+{
+    const CommBreaker_t *breaker;
+    uint32_t now;
+
+    if (channel >= COMM_INTERFACE_MAX || stats == NULL) {
+        return false;
+    }
+
+    /* Read-only: buckets that slid out of the window are skipped, not cleared */
+    breaker = &g_breakers[channel];
+    now = Platform_GetTimeMs();
+    Platform_EnterCritical();
+    stats->state = CurrentState(breaker, now);
+    WindowTotals(breaker, now, &stats->window_requests, &stats->window_failures);
+    stats->trips = breaker->trips;
+    stats->rejected = breaker->rejected;
+    Platform_ExitCritical();
+    return true;
+}
+
+const char *CommBreaker_StateToString(CommBreakerState_t state)
+{
+    static const char *const state_strings[COMM_BREAKER_STATE_MAX] = {
+        "CLOSED", "OPEN", "HALF_OPEN"
+    };
+
+    if (state < COMM_BREAKER_STATE_MAX) {
+        return state_strings[state];
+    }
+    return "UNKNOWN";
+}
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+static void ResetBreaker(CommBreaker_t *breaker, uint32_t now)
+{
+    memset(breaker->requests, 0, sizeof(breaker->requests));
+    memset(breaker->failures, 0, sizeof(breaker->failures));
+    breaker->bucket = 0;
+    breaker->bucket_start = now;
+    breaker->state = (uint8_t)COMM_BREAKER_CLOSED;
+    breaker->probes = 0;
+}
+
+static void AdvanceWindow(CommBreaker_t *breaker, uint32_t now)
+{
+    uint32_t elapsed = (now - breaker->bucket_start) / breaker->bucket_ms;
+
+    if (elapsed == 0U) {
+        return;
+    }
+
+    /* Whole window passed - start over */
+    if (elapsed >= COMM_BREAKER_BUCKETS) {
+        memset(breaker->requests, 0, sizeof(breaker->requests));
+        memset(breaker->failures, 0, sizeof(breaker->failures));
+        breaker->bucket = 0;
+        breaker->bucket_start = now;
+        return;
+    }
+
+    /* Clear the buckets that slid out of the window */
+    for (uint32_t i = 0; i < elapsed; i++) {
+        breaker->bucket = (uint8_t)((breaker->bucket + 1U) % COMM_BREAKER_BUCKETS);
+        breaker->requests[breaker->bucket] = 0;
+        breaker->failures[breaker->bucket] = 0;
+    }
+    breaker->bucket_start += elapsed * breaker->bucket_ms;
+}
+
+static void UpdateOpenState(CommBreaker_t *breaker, uint32_t now)
+{
+    if (breaker->state == (uint8_t)COMM_BREAKER_OPEN &&
+        CurrentState(breaker, now) == COMM_BREAKER_HALF_OPEN) {
+        breaker->state = (uint8_t)COMM_BREAKER_HALF_OPEN;
+        breaker->probes = 0;
+    }
+}
+
+static CommBreakerState_t CurrentState(const CommBreaker_t *breaker, uint32_t now)
+{
+    if (breaker->state == (uint8_t)COMM_BREAKER_OPEN &&
+        (int32_t)(now - breaker->open_until) >= 0) {
+        return COMM_BREAKER_HALF_OPEN;
+    }
+    return (CommBreakerState_t)breaker->state;
+}
+
+static void Trip(CommBreaker_t *breaker, uint32_t now)
+{
+    breaker->state = (uint8_t)COMM_BREAKER_OPEN;
+    breaker->open_until = now + breaker->config.open_ms;
+    breaker->probes = 0;
+    breaker->trips++;
+}
+
+static void WindowTotals(const CommBreaker_t *breaker, uint32_t now,
+                         uint32_t *requests, uint32_t *failures)
+{
+    uint32_t elapsed = (now - breaker->bucket_start) / breaker->bucket_ms;
+
+    *requests = 0;
+    *failures = 0;
+    if (elapsed >= COMM_BREAKER_BUCKETS) {
+        return;  /* Whole window passed */
+    }
+
+    /* The `elapsed` buckets after the current one would be cleared by
+     * AdvanceWindow() - count the others */
+    for (uint32_t i = elapsed + 1U; i <= COMM_BREAKER_BUCKETS; i++) {
+        uint32_t index = (breaker->bucket + i) % COMM_BREAKER_BUCKETS;
+        *requests += breaker->requests[index];
+        *failures += breaker->failures[index];
+    }
+}
+
+static const char *ChannelName(CommInterface_t channel)
+{
+    static const char *const channel_strings[COMM_INTERFACE_MAX] = {
+        "UART", "SPI", "I2C", "USB", "RTT"
+    };
+
+    return channel_strings[channel];
+}
@@ -4,12 +4,33 @@
  * @version 2.0.0
  */
 
+#define DEBUG_MODULE DEBUG_MODULE_CORE
+
 #include "sm_framework/sm_framework.h"
 #include "sm_framework/sm_platform.h"
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
 
+/* Mask of each module before and after Debug_Init() */
+#define DEBUG_DEFAULT_MASK \
+    ((DEBUG_ENABLE_INIT_MESSAGES != 0 ? DEBUG_MSG_BIT(DEBUG_MSG_INIT) : 0U) | \
+     (DEBUG_ENABLE_RUNTIME_MESSAGES != 0 ? DEBUG_MSG_BIT(DEBUG_MSG_RUNTIME) : 0U) | \
+     (DEBUG_ENABLE_PERIODIC_MESSAGES != 0 ? DEBUG_MSG_BIT(DEBUG_MSG_PERIODIC) : 0U) | \
+     (DEBUG_ENABLE_ERROR_MESSAGES != 0 ? DEBUG_MSG_BIT(DEBUG_MSG_ERROR) : 0U) | \
+     (DEBUG_ENABLE_WARNING_MESSAGES != 0 ? DEBUG_MSG_BIT(DEBUG_MSG_WARNING) : 0U) | \
+     (DEBUG_ENABLE_INFO_MESSAGES != 0 ? DEBUG_MSG_BIT(DEBUG_MSG_INFO) : 0U))
+
+/* Message type masks per module (read lock-free by the DEBUG_* macros).
+ * Start at the default so errors and warnings raised before Debug_Init()
+ * are not dropped. */
+volatile uint32_t g_debug_module_masks[DEBUG_MODULE_MAX] = {
+    [DEBUG_MODULE_APP] = DEBUG_DEFAULT_MASK,
+    [DEBUG_MODULE_CORE] = DEBUG_DEFAULT_MASK,
+    [DEBUG_MODULE_ERROR] = DEBUG_DEFAULT_MASK,
+    [DEBUG_MODULE_COMM] = DEBUG_DEFAULT_MASK
+};
+
 /* Debug configuration */
 static DebugConfig_t g_debug_config;
 
@@ -17,19 +38,22 @@ static DebugConfig_t g_debug_config;
 static DebugFormatter_t g_custom_formatter = NULL;
 
 /* Forward declarations */
+static void SendMessage(DebugMessageType_t type, const char *format, va_list args);
 static void SendFormattedMessage(const DebugMessage_t *message);
 static uint32_t DefaultFormatter(DebugMessageType_t type, uint32_t timestamp,
                                   const char *message, char *buffer, uint32_t buffer_size);
+static void UpdateAllMasks(uint32_t set, uint32_t clear);
+static void EnableType(DebugMessageType_t type, bool enable);
 
 bool Debug_Init(CommInterface_t interface)
 {
     memset(&g_debug_config, 0, sizeof(DebugConfig_t));
     
     g_debug_config.interface = interface;
-    g_debug_config.enable_init_messages = (DEBUG_ENABLE_INIT_MESSAGES != 0);
-    g_debug_config.enable_runtime_messages = (DEBUG_ENABLE_RUNTIME_MESSAGES != 0);
-    g_debug_config.enable_periodic_messages = (DEBUG_ENABLE_PERIODIC_MESSAGES != 0);
     g_debug_config.periodic_last_time = Platform_GetTimeMs();
+    for (uint32_t module = 0; module < DEBUG_MODULE_MAX; module++) {
+        SM_ATOMIC_STORE(&g_debug_module_masks[module], DEBUG_DEFAULT_MASK);
+    }
     
     /* Initialize platform interface */
     switch (interface) {
@@ -50,28 +74,39 @@ bool Debug_Init(CommInterface_t interface)
 
 void Debug_SendMessage(DebugMessageType_t type, const char *format, ...)
 {
-    DebugMessage_t message;
     va_list args;
     
-    /* Filter disabled message types */
-    if (type == DEBUG_MSG_INIT && !g_debug_config.enable_init_messages) return;
-    if (type == DEBUG_MSG_RUNTIME && !g_debug_config.enable_runtime_messages) return;
-    if (type == DEBUG_MSG_PERIODIC && !g_debug_config.enable_periodic_messages) return;
+    /* Filter before formatting */
+    if (type >= DEBUG_MSG_MAX || !DEBUG_IS_ENABLED(DEBUG_MODULE_APP, type)) {
+        return;
+    }
     
-    /* Format message */
-    message.type = type;
-    message.timestamp = Platform_GetTimeMs();
     va_start(args, format);
-    vsnprintf(message.message, DEBUG_MAX_MESSAGE_LENGTH, format, args);
+    SendMessage(type, format, args);
     va_end(args);
+}
+
+void Debug_SendModuleMessage(DebugModule_t module, DebugMessageType_t type, const char *format, ...)
+{
+    va_list args;
     
-    /* Send */
-    SendFormattedMessage(&message);
+    if (module >= DEBUG_MODULE_MAX || type >= DEBUG_MSG_MAX || !DEBUG_IS_ENABLED(module, type)) {
+        return;
+    }
+    
+    va_start(args, format);
+    SendMessage(type, format, args);
+    va_end(args);
 }
 
 void Debug_SendRawMessage(DebugMessageType_t type, const char *message)
 {
     DebugMessage_t msg;
+    
+    if (type >= DEBUG_MSG_MAX || !DEBUG_IS_ENABLED(DEBUG_MODULE_APP, type)) {
+        return;
+    }
+    
     msg.type = type;
     msg.timestamp = Platform_GetTimeMs();
     strncpy(msg.message, message, DEBUG_MAX_MESSAGE_LENGTH - 1);
@@ -81,61 +116,88 @@ void Debug_SendRawMessage(DebugMessageType_t type, const char *message)
 
 void Debug_EnableInitMessages(bool enable)
 {
-    g_debug_config.enable_init_messages = enable;
+    EnableType(DEBUG_MSG_INIT, enable);
 }
 
 void Debug_EnableRuntimeMessages(bool enable)
 {
-    g_debug_config.enable_runtime_messages = enable;
+    EnableType(DEBUG_MSG_RUNTIME, enable);
 }
 
 void Debug_EnablePeriodicMessages(bool enable)
 {
-    g_debug_config.enable_periodic_messages = enable;
+    EnableType(DEBUG_MSG_PERIODIC, enable);
 }
 
 void Debug_EnableErrorMessages(bool enable)
 {
-    /* Always keep errors enabled for safety */
-    (void)enable;
+    EnableType(DEBUG_MSG_ERROR, enable);
 }
 
 void Debug_EnableWarningMessages(bool enable)
 {
-    (void)enable;  /* Not separately tracked in current implementation */
+    EnableType(DEBUG_MSG_WARNING, enable);
 }
 
 void Debug_EnableInfoMessages(bool enable)
 {
-    (void)enable;  /* Not separately tracked in current implementation */
+    EnableType(DEBUG_MSG_INFO, enable);
 }
 
 void Debug_EnableAllMessages(void)
 {
-    g_debug_config.enable_init_messages = true;
-    g_debug_config.enable_runtime_messages = true;
-    g_debug_config.enable_periodic_messages = true;
+    UpdateAllMasks(DEBUG_MSG_ALL, 0U);
 }
 
 void Debug_DisableAllMessages(void)
 {
-    g_debug_config.enable_init_messages = false;
-    g_debug_config.enable_runtime_messages = false;
-    g_debug_config.enable_periodic_messages = false;
+    UpdateAllMasks(0U, DEBUG_MSG_ALL);
+}
+
+bool Debug_SetModuleMask(DebugModule_t module, uint32_t mask)
+{
+    if (module >= DEBUG_MODULE_MAX) {
+        return false;
+    }
+
+    SM_ATOMIC_STORE(&g_debug_module_masks[module], mask & DEBUG_MSG_ALL);
+    return true;
+}
+
+uint32_t Debug_GetModuleMask(DebugModule_t module)
+{
+    if (module >= DEBUG_MODULE_MAX) {
+        return 0;
+    }
+
+    return SM_ATOMIC_LOAD(&g_debug_module_masks[module]);
 }
 
 void Debug_ProcessPeriodic(void)
 {
     uint32_t current_time = Platform_GetTimeMs();
     
-    if (!g_debug_config.enable_periodic_messages) {
+    if (!DEBUG_IS_ENABLED(DEBUG_MODULE_CORE, DEBUG_MSG_PERIODIC)) {
         return;
     }
     
     if ((current_time - g_debug_config.periodic_last_time) >= DEBUG_PERIODIC_INTERVAL_MS) {
-        Debug_SendMessage(DEBUG_MSG_PERIODIC, "State=%s Exec=%lu",
+#if SM_STATS_LEVEL >= 2
+        CadenceStats_t cadence;
+
+        (void)Cadence_GetStats(&cadence);
+        Debug_SendModuleMessage(DEBUG_MODULE_CORE, DEBUG_MSG_PERIODIC,
+                         "State=%s Exec=%lu Jitter p99=%luus max=%luus Miss=%lu",
+                         StateMachine_StateToString(StateMachine_GetCurrentState()),
+                         (unsigned long)StateMachine_GetExecutionCount(),
+                         (unsigned long)cadence.jitter_p99_us,
+                         (unsigned long)cadence.jitter_max_us,
+                         (unsigned long)cadence.deadline_misses);
+#else
+        Debug_SendModuleMessage(DEBUG_MODULE_CORE, DEBUG_MSG_PERIODIC, "State=%s Exec=%lu",
                          StateMachine_StateToString(StateMachine_GetCurrentState()),
                          (unsigned long)StateMachine_GetExecutionCount());
+#endif
         g_debug_config.periodic_last_time = current_time;
     }
 }
@@ -146,6 +208,16 @@ void Debug_SetPeriodicInterval(uint32_t interval_ms)
     (void)interval_ms;
 }
 
+bool Debug_GetNextPeriodicTime(uint32_t *time_ms)
+{
+    if (time_ms == NULL || !DEBUG_IS_ENABLED(DEBUG_MODULE_CORE, DEBUG_MSG_PERIODIC)) {
+        return false;
+    }
+
+    *time_ms = g_debug_config.periodic_last_time + DEBUG_PERIODIC_INTERVAL_MS;
+    return true;
+}
+
 bool Debug_SetInterface(CommInterface_t interface)
 {
     if (interface >= COMM_INTERFACE_MAX) {
@@ -166,6 +238,19 @@ void Debug_SetFormatter(DebugFormatter_t formatter)
     g_custom_formatter = formatter;
 }
 
+/**
+ * @brief Format and send (type already filtered)
+ */
+static void SendMessage(DebugMessageType_t type, const char *format, va_list args)
+{
+    DebugMessage_t message;
+    
+    message.type = type;
+    message.timestamp = Platform_GetTimeMs();
+    vsnprintf(message.message, DEBUG_MAX_MESSAGE_LENGTH, format, args);
+    SendFormattedMessage(&message);
+}
+
 static void SendFormattedMessage(const DebugMessage_t *message)
 {
     char formatted_buffer[DEBUG_BUFFER_SIZE];
@@ -211,3 +296,35 @@ static uint32_t DefaultFormatter(DebugMessageType_t type, uint32_t timestamp,
     return (uint32_t)snprintf(buffer, buffer_size, "[%lu] %s\n",
                              (unsigned long)timestamp, message);
 }
+
+/**
+ * @brief Set and clear type bits in every module mask
+ *
+ * Atomic per module, so an ISR may change masks while the main loop logs.
+ */
+static void UpdateAllMasks(uint32_t set, uint32_t clear)
+{
+    for (uint32_t module = 0; module < DEBUG_MODULE_MAX; module++) {
+#if SM_HAS_ATOMIC_BUILTINS
+        if (set != 0U) {
+            (void)__atomic_fetch_or(&g_debug_module_masks[module], set, __ATOMIC_RELAXED);
+        }
+        if (clear != 0U) {
+            (void)__atomic_fetch_and(&g_debug_module_masks[module], ~clear, __ATOMIC_RELAXED);
+        }
+#else
+        Platform_EnterCritical();
+        g_debug_module_masks[module] = (g_debug_module_masks[module] | set) & ~clear;
+        Platform_ExitCritical();
+#endif
+    }
+}
+
+static void EnableType(DebugMessageType_t type, bool enable)
+{
+    if (enable) {
+        UpdateAllMasks(DEBUG_MSG_BIT(type), 0U);
+    } else {
+        UpdateAllMasks(0U, DEBUG_MSG_BIT(type));
+    }
+}
@@ -4,8 +4,11 @@
  * @version 2.0.0
  */
 
+#define DEBUG_MODULE DEBUG_MODULE_ERROR
+
 #include "sm_framework/sm_framework.h"
 #include "sm_framework/sm_platform.h"
+#include "sm_framework/sm_snapshot.h"
 #include <string.h>
 
 /* Communication verification state */
@@ -15,40 +18,163 @@ static struct {
     bool is_verified;
 } g_comm_verification;
 
+/* Error handler context (cold data, kept out of the state machine context) */
+static ErrorHandler_t g_error_handler;
+
+#if FEATURE_ERROR_RATES
+/* Bucket length of each error-rate window */
+static const uint32_t g_rate_bucket_ms[ERROR_RATE_WINDOW_MAX] = {
+    1000U / ERROR_RATE_BUCKETS,
+    60000U / ERROR_RATE_BUCKETS,
+    3600000U / ERROR_RATE_BUCKETS
+};
+
+/* Epoch of a bucket that holds no data */
+#define RATE_EPOCH_INVALID (0xFFFFFFFFU)
+/* Epoch of a bucket being cleared for reuse */
+#define RATE_EPOCH_CLEARING (0xFFFFFFFEU)
+#endif
+
 /* Custom recovery handlers (optional advanced feature) */
 static ErrorRecoveryHandler_t g_recovery_handlers[ERROR_CODE_MAX];
 
+/* Report hook (event recorder) and ErrorHandler_Report() nesting depth */
+static ErrorReportHook_t g_report_hook = NULL;
+static volatile uint8_t g_report_depth = 0;
+
 /* Forward declarations */
-static void AddErrorToHistory(const ErrorInfo_t *error_info);
+static bool ReportError(ErrorLevel_t level, ErrorCode_t code);
+static uint32_t AddErrorToHistory(const ErrorInfo_t *error_info);
+static bool LockHistorySlot(ErrorInfo_t *entry, uint32_t seq);
+static bool ReadHistorySlot(uint32_t seq, ErrorInfo_t *error_info);
+static uint32_t AtomicIncrement(volatile uint32_t *value);
+static bool RateLimitAdmit(ErrorCode_t code, ErrorInfo_t *error_info);
+static void RefillBucket(ErrorRateBucket_t *bucket, uint32_t now);
+static bool RunRecoveryHandler(ErrorCode_t code);
+static uint32_t RecoveryDelay(const RecoveryPolicy_t *policy, RecoveryBreaker_t *breaker,
+                              uint8_t attempt, uint32_t now);
+static uint32_t NextJitterRandom(void);
+static void PutErrorInfo(SnapshotWriter_t *writer, const ErrorInfo_t *error_info);
+static bool GetErrorInfo(SnapshotReader_t *reader, ErrorInfo_t *error_info);
+#if FEATURE_ERROR_PERSIST
+static void RecoverPersistentLog(void);
+#endif
+#if FEATURE_ERROR_RATES
+static void CountErrorRate(ErrorCode_t code, StateMachineState_t state, uint32_t now);
+static bool ReadRateBucket(ErrorRateWindow_t window, uint32_t bucket, uint32_t current_epoch,
+                           const volatile uint32_t *counts, uint32_t *out, uint32_t n);
+#endif
 extern StateMachineContext_t g_sm_context;  /* From sm_state_machine.c */
 
 bool ErrorHandler_Init(void)
 {
-    memset(&g_sm_context.error_handler, 0, sizeof(ErrorHandler_t));
+    memset(&g_error_handler, 0, sizeof(ErrorHandler_t));
     memset(&g_comm_verification, 0, sizeof(g_comm_verification));
     memset(g_recovery_handlers, 0, sizeof(g_recovery_handlers));
+    CommBreaker_Init();
     
-    g_sm_context.error_handler.current_error.level = ERROR_LEVEL_NONE;
-    g_sm_context.error_handler.current_error.code = ERROR_CODE_NONE;
-    g_sm_context.error_handler.critical_lock_active = false;
+    g_error_handler.current_error.level = ERROR_LEVEL_NONE;
+    g_error_handler.current_error.code = ERROR_CODE_NONE;
+    g_sm_context.critical_lock_active = false;
+    
+    for (uint32_t code = 0; code < ERROR_CODE_MAX; code++) {
+        g_error_handler.rate_limit[code].burst = ERROR_RATE_LIMIT_BURST;
+        g_error_handler.rate_limit[code].tokens = ERROR_RATE_LIMIT_BURST;
+        g_error_handler.rate_limit[code].refill_ms = ERROR_RATE_LIMIT_REFILL_MS;
+        g_error_handler.recovery_policy[code].strategy = (uint8_t)RECOVERY_STRATEGY_BACKOFF;
+        g_error_handler.recovery_policy[code].max_attempts = ERROR_MAX_RECOVERY_ATTEMPTS;
+        g_error_handler.recovery_policy[code].delay_ms = ERROR_RECOVERY_BASE_DELAY_MS;
+        g_error_handler.recovery_policy[code].max_delay_ms = ERROR_RECOVERY_MAX_DELAY_MS;
+        g_error_handler.recovery_policy[code].jitter_percent = ERROR_RECOVERY_JITTER_PERCENT;
+        g_error_handler.recovery_policy[code].failure_threshold = ERROR_MAX_RECOVERY_ATTEMPTS;
+        g_error_handler.recovery_policy[code].open_ms = ERROR_RECOVERY_MAX_DELAY_MS;
+    }
+    g_error_handler.recovery_jitter_seed = 0x2545F491U;  /* Any non-zero value */
+#if FEATURE_ERROR_RATES
+    for (uint32_t window = 0; window < ERROR_RATE_WINDOW_MAX; window++) {
+        for (uint32_t bucket = 0; bucket < ERROR_RATE_BUCKETS; bucket++) {
+            g_error_handler.rates.epoch[window][bucket] = RATE_EPOCH_INVALID;
+        }
+    }
+#endif
+    
+#if FEATURE_ERROR_PERSIST
+    RecoverPersistentLog();
+#endif
     
     return true;
 }
 
 bool ErrorHandler_Report(ErrorLevel_t level, ErrorCode_t code)
+{
+    bool result;
+    
+    if (g_report_hook != NULL) {
+        g_report_hook(level, code);
+    }
+    
+    g_report_depth++;
+    result = ReportError(level, code);
+    g_report_depth--;
+    return result;
+}
+
+void ErrorHandler_SetReportHook(ErrorReportHook_t hook)
+{
+    g_report_hook = hook;
+}
+
+bool ErrorHandler_IsReporting(void)
+{
+    return g_report_depth != 0U;
+}
+
+/**
+ * @brief Body of ErrorHandler_Report()
+ */
+static bool ReportError(ErrorLevel_t level, ErrorCode_t code)
 {
     ErrorInfo_t error_info;
     
     /* Create error info */
-    error_info.level = level;
-    error_info.code = code;
+    error_info.level = (ErrorLevelStorage_t)level;
+    error_info.code = (ErrorCodeStorage_t)code;
     error_info.timestamp = Platform_GetTimeMs();
-    error_info.state = StateMachine_GetCurrentState();
+    error_info.last_timestamp = error_info.timestamp;
+    error_info.seq = 0;
+    error_info.count = 1;
+    error_info.state = (StateStorage_t)StateMachine_GetCurrentState();
     error_info.retry_count = 0;
     error_info.is_recovered = false;
     
+    if (code < ERROR_CODE_MAX) {
+        (void)AtomicIncrement(&g_error_handler.report_counts[code]);
+    }
+    
+#if FEATURE_ERROR_RATES
+    if (code < ERROR_CODE_MAX) {
+        CountErrorRate(code, StateMachine_GetCurrentState(), error_info.timestamp);
+    }
+#endif
+    
+    /* Channel failures feed the breaker, even when rate limited below */
+    if (code == ERROR_CODE_COMM_LOST || code == ERROR_CODE_COMM_CORRUPT) {
+        CommBreaker_RecordFailure(Debug_GetInterface());
+    }
+    
+    /* Error storms: suppressed repeats are only counted */
+    if (level != ERROR_LEVEL_CRITICAL && code < ERROR_CODE_MAX) {
+        if (!RateLimitAdmit(code, &error_info)) {
+            return true;
+        }
+    }
+    
     /* Add to history */
-    AddErrorToHistory(&error_info);
+    (void)AddErrorToHistory(&error_info);
+    if (error_info.count > 1U) {
+        DEBUG_WARNING("%s repeated %u times (rate limited)",
+                     ErrorHandler_CodeToString(code), (unsigned)error_info.count);
+    }
     
     /* Handle based on severity */
     switch (level) {
@@ -66,7 +192,7 @@ bool ErrorHandler_Report(ErrorLevel_t level, ErrorCode_t code)
 
 bool ErrorHandler_HandleMinorError(ErrorCode_t code)
 {
-    ErrorHandler_t *handler = &g_sm_context.error_handler;
+    ErrorHandler_t *handler = &g_error_handler;
     uint32_t current_time = Platform_GetTimeMs();
     
     /* Start timer if first minor error */
@@ -99,14 +225,16 @@ bool ErrorHandler_HandleMinorError(ErrorCode_t code)
 
 bool ErrorHandler_HandleNormalError(ErrorCode_t code)
 {
-    ErrorHandler_t *handler = &g_sm_context.error_handler;
+    ErrorHandler_t *handler = &g_error_handler;
     
     handler->current_error.level = ERROR_LEVEL_NORMAL;
-    handler->current_error.code = code;
+    handler->current_error.code = (ErrorCodeStorage_t)code;
     handler->current_error.timestamp = Platform_GetTimeMs();
-    handler->current_error.state = StateMachine_GetCurrentState();
+    handler->current_error.seq = SM_ATOMIC_LOAD(&handler->history_claimed);
+    handler->current_error.state = (StateStorage_t)StateMachine_GetCurrentState();
     handler->current_error.retry_count = 0;
     handler->current_error.is_recovered = false;
+    handler->recovery_scheduled = false;  /* First attempt is due at once */
     
     DEBUG_WARNING("Normal error reported: %s", ErrorHandler_CodeToString(code));
     StateMachine_PostEvent(EVENT_ERROR_NORMAL);
@@ -116,15 +244,16 @@ bool ErrorHandler_HandleNormalError(ErrorCode_t code)
 
 void ErrorHandler_HandleCriticalError(ErrorCode_t code)
 {
-    ErrorHandler_t *handler = &g_sm_context.error_handler;
+    ErrorHandler_t *handler = &g_error_handler;
     
     handler->current_error.level = ERROR_LEVEL_CRITICAL;
-    handler->current_error.code = code;
+    handler->current_error.code = (ErrorCodeStorage_t)code;
     handler->current_error.timestamp = Platform_GetTimeMs();
-    handler->current_error.state = StateMachine_GetCurrentState();
+    handler->current_error.seq = SM_ATOMIC_LOAD(&handler->history_claimed);
+    handler->current_error.state = (StateStorage_t)StateMachine_GetCurrentState();
     handler->current_error.retry_count = 0;
     handler->current_error.is_recovered = false;
-    handler->critical_lock_active = true;
+    g_sm_context.critical_lock_active = true;
     
     DEBUG_ERROR("CRITICAL ERROR: %s", ErrorHandler_CodeToString(code));
     StateMachine_PostEvent(EVENT_ERROR_CRITICAL);
@@ -132,57 +261,110 @@ void ErrorHandler_HandleCriticalError(ErrorCode_t code)
 
 bool ErrorHandler_AttemptRecovery(void)
 {
-    ErrorHandler_t *handler = &g_sm_context.error_handler;
+    ErrorHandler_t *handler = &g_error_handler;
+    const RecoveryPolicy_t *policy;
+    RecoveryBreaker_t *breaker;
+    ErrorCode_t code;
+    uint32_t now;
     
     if (handler->current_error.level == ERROR_LEVEL_NONE) {
         return true;  /* No error to recover from */
     }
     
+    code = (ErrorCode_t)handler->current_error.code;
+    policy = &handler->recovery_policy[code];
+    breaker = &handler->recovery_breaker[code];
+    now = Platform_GetTimeMs();
+    
+    /* Not due yet - nothing to do until the scheduled attempt */
+    if (handler->recovery_scheduled && (int32_t)(now - handler->recovery_next_time) < 0) {
+        return false;
+    }
+    
+    /* Breaker open - defer to the trial attempt without using the budget */
+    if (policy->strategy == (uint8_t)RECOVERY_STRATEGY_CIRCUIT_BREAKER &&
+        breaker->is_open && (int32_t)(now - breaker->open_until) < 0) {
+        handler->recovery_next_time = breaker->open_until;
+        handler->recovery_scheduled = true;
+        return false;
+    }
+    
     handler->current_error.retry_count++;
     
     /* Check retry limit */
-    if (handler->current_error.retry_count >= ERROR_MAX_RECOVERY_ATTEMPTS) {
+    if (handler->current_error.retry_count >= policy->max_attempts) {
         DEBUG_ERROR("Max recovery attempts exceeded");
+        handler->recovery_scheduled = false;
         return false;
     }
     
-    /* Try custom handler if registered */
-    if (g_recovery_handlers[handler->current_error.code] != NULL) {
-        return g_recovery_handlers[handler->current_error.code](handler->current_error.code);
+    if (RunRecoveryHandler(code)) {
+        breaker->consecutive_failures = 0;
+        breaker->is_open = false;
+        handler->recovery_scheduled = false;
+        return true;
     }
     
-    /* Default recovery logic */
-    switch (handler->current_error.code) {
-        case ERROR_CODE_COMM_LOST:
-            if (ErrorHandler_VerifyCommChannel()) {
-                handler->current_error.is_recovered = true;
-                return true;
-            }
-            break;
-            
-        case ERROR_CODE_TIMEOUT:
-            /* Timeout errors can usually retry */
-            handler->current_error.is_recovered = true;
-            return true;
-            
-        default:
-            /* Unknown error - cannot recover */
-            break;
+    /* Failed - schedule the next attempt */
+    handler->recovery_next_time = now + RecoveryDelay(policy, breaker,
+                                                      handler->current_error.retry_count, now);
+    handler->recovery_scheduled = true;
+    return false;
+}
+
+bool ErrorHandler_IsRecoveryExhausted(void)
+{
+    const ErrorInfo_t *error = &g_error_handler.current_error;
+    
+    return error->level != ERROR_LEVEL_NONE &&
+           error->retry_count >= g_error_handler.recovery_policy[error->code].max_attempts;
+}
+
+bool ErrorHandler_GetNextRecoveryTime(uint32_t *time_ms)
+{
+    if (time_ms == NULL || !g_error_handler.recovery_scheduled ||
+        g_error_handler.current_error.level == ERROR_LEVEL_NONE) {
+        return false;
     }
     
-    return false;
+    *time_ms = g_error_handler.recovery_next_time;
+    return true;
+}
+
+bool ErrorHandler_SetRecoveryPolicy(ErrorCode_t code, const RecoveryPolicy_t *policy)
+{
+    if (code >= ERROR_CODE_MAX || policy == NULL ||
+        policy->strategy >= (uint8_t)RECOVERY_STRATEGY_MAX ||
+        policy->max_attempts == 0U || policy->jitter_percent > 100U) {
+        return false;
+    }
+    
+    g_error_handler.recovery_policy[code] = *policy;
+    memset(&g_error_handler.recovery_breaker[code], 0, sizeof(RecoveryBreaker_t));
+    return true;
+}
+
+bool ErrorHandler_GetRecoveryPolicy(ErrorCode_t code, RecoveryPolicy_t *policy)
+{
+    if (code >= ERROR_CODE_MAX || policy == NULL) {
+        return false;
+    }
+    
+    *policy = g_error_handler.recovery_policy[code];
+    return true;
 }
 
 void ErrorHandler_ClearError(void)
 {
-    g_sm_context.error_handler.current_error.level = ERROR_LEVEL_NONE;
-    g_sm_context.error_handler.current_error.code = ERROR_CODE_NONE;
-    g_sm_context.error_handler.current_error.retry_count = 0;
+    g_error_handler.current_error.level = ERROR_LEVEL_NONE;
+    g_error_handler.current_error.code = ERROR_CODE_NONE;
+    g_error_handler.current_error.retry_count = 0;
+    g_error_handler.recovery_scheduled = false;
 }
 
 bool ErrorHandler_IsCriticalLock(void)
 {
-    return g_sm_context.error_handler.critical_lock_active;
+    return g_sm_context.critical_lock_active;
 }
 
 bool ErrorHandler_GetCurrentError(ErrorInfo_t *error_info)
@@ -191,36 +373,99 @@ bool ErrorHandler_GetCurrentError(ErrorInfo_t *error_info)
         return false;
     }
     
-    memcpy(error_info, &g_sm_context.error_handler.current_error, sizeof(ErrorInfo_t));
+    memcpy(error_info, &g_error_handler.current_error, sizeof(ErrorInfo_t));
     return true;
 }
 
 bool ErrorHandler_GetHistoryError(uint8_t index, ErrorInfo_t *error_info)
 {
-    if (error_info == NULL || index >= ERROR_HISTORY_SIZE) {
+    if (error_info == NULL || index >= ErrorHandler_GetHistoryCount()) {
         return false;
     }
     
-    uint8_t actual_index = (g_sm_context.error_handler.history_index + ERROR_HISTORY_SIZE - index - 1) % ERROR_HISTORY_SIZE;
-    memcpy(error_info, &g_sm_context.error_handler.error_history[actual_index], sizeof(ErrorInfo_t));
+    return ReadHistorySlot(SM_ATOMIC_LOAD(&g_error_handler.history_claimed) - index, error_info);
+}
+
+uint8_t ErrorHandler_GetHistoryCount(void)
+{
+    uint32_t total = SM_ATOMIC_LOAD(&g_error_handler.history_claimed);
+    
+    return (uint8_t)((total < ERROR_HISTORY_SIZE) ? total : ERROR_HISTORY_SIZE);
+}
+
+uint32_t ErrorHandler_ReadHistory(uint32_t since_seq, ErrorInfo_t *buffer, uint32_t max_entries)
+{
+    uint32_t last = SM_ATOMIC_LOAD(&g_error_handler.history_claimed);
+    uint32_t oldest = (last > ERROR_HISTORY_SIZE) ? (last - ERROR_HISTORY_SIZE + 1U) : 1U;
+    uint32_t copied = 0;
+    uint32_t seq;
+    
+    if (buffer == NULL) {
+        return 0;
+    }
+    
+    if ((int32_t)(since_seq - oldest) < 0) {
+        since_seq = oldest;
+    }
+    
+    for (seq = since_seq; (int32_t)(last - seq) >= 0 && copied < max_entries; seq++) {
+        if (ReadHistorySlot(seq, &buffer[copied])) {
+            copied++;
+        } else if ((int32_t)(SM_ATOMIC_LOAD(&g_error_handler.history_claimed) - seq) <
+                   (int32_t)ERROR_HISTORY_SIZE) {
+            break;  /* Still being written - resume here next time */
+        }
+        /* Otherwise overwritten (or dropped) - skip it */
+    }
+    
+    return copied;
+}
+
+bool ErrorHandler_GetHistoryStats(ErrorHistoryStats_t *stats)
+{
+    uint32_t total;
+    
+    if (stats == NULL) {
+        return false;
+    }
     
+    total = SM_ATOMIC_LOAD(&g_error_handler.history_claimed);
+    stats->total_logged = total;
+    stats->count = ErrorHandler_GetHistoryCount();
+    stats->overwritten = (total > ERROR_HISTORY_SIZE) ? (total - ERROR_HISTORY_SIZE) : 0U;
+    stats->dropped = SM_ATOMIC_LOAD(&g_error_handler.history_dropped);
     return true;
 }
 
-uint8_t ErrorHandler_GetHistoryCount(void)
+uint32_t ErrorHandler_GetReportCount(ErrorCode_t code)
 {
-    return ERROR_HISTORY_SIZE;  /* Full circular buffer */
+    if (code >= ERROR_CODE_MAX) {
+        return 0;
+    }
+    
+    return SM_ATOMIC_LOAD(&g_error_handler.report_counts[code]);
 }
 
 bool ErrorHandler_VerifyCommChannel(void)
 {
-    uint32_t current_time = Platform_GetTimeMs();
+    CommInterface_t channel = Debug_GetInterface();
+    CommBreakerState_t breaker_state = CommBreaker_GetState(channel);
+    uint32_t current_time;
+    
+    /* Channel known to be failing - fail fast */
+    if (breaker_state == COMM_BREAKER_OPEN) {
+        return false;
+    }
+    
+    current_time = Platform_GetTimeMs();
     
     /* Check if within verification window */
     if ((current_time - g_comm_verification.window_start_time) <= COMM_VERIFICATION_WINDOW_MS) {
         g_comm_verification.good_message_count++;
         if (g_comm_verification.good_message_count >= COMM_VERIFICATION_COUNT) {
             g_comm_verification.is_verified = true;
+            /* Counts toward the failure rate when closed, closes when half-open */
+            CommBreaker_RecordSuccess(channel);
             return true;
         }
     } else {
@@ -242,12 +487,269 @@ bool ErrorHandler_RegisterRecoveryHandler(ErrorCode_t code, ErrorRecoveryHandler
     return true;
 }
 
+bool ErrorHandler_SetRateLimit(ErrorCode_t code, uint8_t burst, uint16_t refill_ms)
+{
+    ErrorRateBucket_t *bucket;
+    
+    if (code >= ERROR_CODE_MAX || refill_ms == 0U) {
+        return false;
+    }
+    
+    bucket = &g_error_handler.rate_limit[code];
+    Platform_EnterCritical();
+    bucket->burst = burst;
+    bucket->tokens = burst;
+    bucket->refill_ms = refill_ms;
+    Platform_ExitCritical();
+    return true;
+}
+
+void ErrorHandler_FlushSuppressed(void)
+{
+    uint32_t pending_mask = g_error_handler.rate_limit_pending;
+    uint32_t now;
+    
+    if (pending_mask == 0U) {
+        return;
+    }
+    
+    now = Platform_GetTimeMs();
+    for (uint32_t code = 0; code < ERROR_CODE_MAX; code++) {
+        ErrorRateBucket_t *bucket = &g_error_handler.rate_limit[code];
+        ErrorInfo_t error_info;
+        bool flush = false;
+        
+        if ((pending_mask & ((uint32_t)1U << code)) == 0U) {
+            continue;
+        }
+        
+        Platform_EnterCritical();
+        if (bucket->pending > 0U && (now - bucket->last_suppressed) >= bucket->refill_ms) {
+            memset(&error_info, 0, sizeof(error_info));
+            error_info.timestamp = bucket->first_suppressed;
+            error_info.last_timestamp = bucket->last_suppressed;
+            error_info.count = (uint16_t)((bucket->pending < 0xFFFFU) ? bucket->pending : 0xFFFFU);
+            error_info.level = bucket->level;
+            error_info.code = (ErrorCodeStorage_t)code;
+            error_info.state = bucket->state;
+            bucket->pending = 0;
+            g_error_handler.rate_limit_pending &= ~((uint32_t)1U << code);
+            g_error_handler.rate_limit_aggregated++;
+            flush = true;
+        }
+        Platform_ExitCritical();
+        
+        if (flush) {
+            (void)AddErrorToHistory(&error_info);
+            DEBUG_WARNING("%s suppressed %u times (rate limited)",
+                         ErrorHandler_CodeToString((ErrorCode_t)code), (unsigned)error_info.count);
+        }
+    }
+}
+
+bool ErrorHandler_HasPendingSuppressed(void)
+{
+    return g_error_handler.rate_limit_pending != 0U;
+}
+
+bool ErrorHandler_GetRateLimitStats(ErrorRateLimitStats_t *stats)
+{
+    if (stats == NULL) {
+        return false;
+    }
+    
+    memset(stats, 0, sizeof(ErrorRateLimitStats_t));
+    Platform_EnterCritical();
+    for (uint32_t code = 0; code < ERROR_CODE_MAX; code++) {
+        stats->suppressed[code] = g_error_handler.rate_limit[code].suppressed_total;
+        stats->suppressed_total += g_error_handler.rate_limit[code].suppressed_total;
+        stats->pending += g_error_handler.rate_limit[code].pending;
+    }
+    stats->aggregated_entries = g_error_handler.rate_limit_aggregated;
+    Platform_ExitCritical();
+    return true;
+}
+
+bool ErrorHandler_GetErrorRates(ErrorRateWindow_t window, ErrorRates_t *rates)
+{
+#if FEATURE_ERROR_RATES
+    uint32_t current_epoch;
+    uint32_t codes[ERROR_CODE_MAX];
+    uint32_t states[STATE_MAX];
+    
+    if (window >= ERROR_RATE_WINDOW_MAX || rates == NULL) {
+        return false;
+    }
+    
+    memset(rates, 0, sizeof(ErrorRates_t));
+    rates->window_ms = g_rate_bucket_ms[window] * ERROR_RATE_BUCKETS;
+    current_epoch = Platform_GetTimeMs() / g_rate_bucket_ms[window];
+    
+    for (uint32_t bucket = 0; bucket < ERROR_RATE_BUCKETS; bucket++) {
+        if (ReadRateBucket(window, bucket, current_epoch,
+                           g_error_handler.rates.by_code[window][bucket], codes, ERROR_CODE_MAX) &&
+            ReadRateBucket(window, bucket, current_epoch,
+                           g_error_handler.rates.by_state[window][bucket], states, STATE_MAX)) {
+            for (uint32_t code = 0; code < ERROR_CODE_MAX; code++) {
+                rates->by_code[code] += codes[code];
+                rates->total += codes[code];
+            }
+            for (uint32_t state = 0; state < STATE_MAX; state++) {
+                rates->by_state[state] += states[state];
+            }
+        }
+    }
+    return true;
+#else
+    (void)window;
+    (void)rates;
+    return false;
+#endif
+}
+
+uint32_t ErrorHandler_GetCodeRate(ErrorRateWindow_t window, ErrorCode_t code)
+{
+#if FEATURE_ERROR_RATES
+    uint32_t current_epoch;
+    uint32_t count;
+    uint32_t total = 0;
+    
+    if (window >= ERROR_RATE_WINDOW_MAX || code >= ERROR_CODE_MAX) {
+        return 0;
+    }
+    
+    current_epoch = Platform_GetTimeMs() / g_rate_bucket_ms[window];
+    for (uint32_t bucket = 0; bucket < ERROR_RATE_BUCKETS; bucket++) {
+        if (ReadRateBucket(window, bucket, current_epoch,
+                           &g_error_handler.rates.by_code[window][bucket][code], &count, 1U)) {
+            total += count;
+        }
+    }
+    return total;
+#else
+    (void)window;
+    (void)code;
+    return 0;
+#endif
+}
+
+uint32_t ErrorHandler_GetStateRate(ErrorRateWindow_t window, StateMachineState_t state)
+{
+#if FEATURE_ERROR_RATES
+    uint32_t current_epoch;
+    uint32_t count;
+    uint32_t total = 0;
+    
+    if (window >= ERROR_RATE_WINDOW_MAX || state >= STATE_MAX) {
+        return 0;
+    }
+    
+    current_epoch = Platform_GetTimeMs() / g_rate_bucket_ms[window];
+    for (uint32_t bucket = 0; bucket < ERROR_RATE_BUCKETS; bucket++) {
+        if (ReadRateBucket(window, bucket, current_epoch,
+                           &g_error_handler.rates.by_state[window][bucket][state], &count, 1U)) {
+            total += count;
+        }
+    }
+    return total;
+#else
+    (void)window;
+    (void)state;
+    return 0;
+#endif
+}
+
+void ErrorHandler_SaveSnapshot(SnapshotWriter_t *writer, uint32_t now)
+{
+    ErrorHandler_t *handler = &g_error_handler;
+    ErrorInfo_t entries[ERROR_HISTORY_SIZE];
+    uint32_t claimed = SM_ATOMIC_LOAD(&handler->history_claimed);
+    uint32_t count;
+    
+    /* Current error */
+    PutErrorInfo(writer, &handler->current_error);
+    
+    /* History, oldest first */
+    count = ErrorHandler_ReadHistory(0, entries, ERROR_HISTORY_SIZE);
+    Snapshot_PutU32(writer, claimed);
+    Snapshot_PutU32(writer, SM_ATOMIC_LOAD(&handler->history_dropped));
+    Snapshot_PutU8(writer, (uint8_t)((count < 255U) ? count : 255U));
+    for (uint32_t i = 0; i < count && i < 255U; i++) {
+        PutErrorInfo(writer, &entries[i]);
+    }
+    
+    /* Minor error window and recovery schedule, relative to now */
+    Snapshot_PutU8(writer, (uint8_t)(handler->minor_error_timestamp != 0U));
+    Snapshot_PutU32(writer, now - handler->minor_error_timestamp);
+    Snapshot_PutU8(writer, handler->minor_good_message_count);
+    Snapshot_PutU8(writer, (uint8_t)handler->recovery_scheduled);
+    Snapshot_PutU32(writer, ((int32_t)(handler->recovery_next_time - now) > 0)
+                            ? (handler->recovery_next_time - now) : 0U);
+}
+
+bool ErrorHandler_LoadSnapshot(SnapshotReader_t *reader, uint32_t now, bool apply)
+{
+    ErrorHandler_t *handler = &g_error_handler;
+    ErrorInfo_t error_info;
+    uint32_t claimed;
+    uint32_t dropped;
+    uint32_t count;
+    uint32_t minor_age;
+    uint32_t recovery_delay;
+    bool minor_active;
+    uint8_t good_count;
+    bool scheduled;
+    
+    if (!GetErrorInfo(reader, &error_info)) {
+        return false;
+    }
+    if (apply) {
+        handler->current_error = error_info;
+    }
+    
+    claimed = Snapshot_GetU32(reader);
+    dropped = Snapshot_GetU32(reader);
+    count = Snapshot_GetU8(reader);
+    if (apply) {
+        memset(handler->error_history, 0, sizeof(handler->error_history));
+        handler->history_claimed = claimed;
+        handler->history_dropped = dropped;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!GetErrorInfo(reader, &error_info) || (claimed - error_info.seq) >= 0x80000000U) {
+            return false;
+        }
+        /* Keep what fits this build's history */
+        if (apply && (claimed - error_info.seq) < ERROR_HISTORY_SIZE) {
+            handler->error_history[(error_info.seq - 1U) % ERROR_HISTORY_SIZE] = error_info;
+        }
+    }
+    
+    minor_active = Snapshot_GetU8(reader) != 0U;
+    minor_age = Snapshot_GetU32(reader);
+    good_count = Snapshot_GetU8(reader);
+    scheduled = Snapshot_GetU8(reader) != 0U;
+    recovery_delay = Snapshot_GetU32(reader);
+    if (reader->underflow) {
+        return false;
+    }
+    
+    if (apply) {
+        handler->minor_error_timestamp = minor_active ? (now - minor_age) : 0U;
+        handler->minor_good_message_count = good_count;
+        handler->recovery_scheduled = scheduled;
+        handler->recovery_next_time = now + recovery_delay;
+    }
+    return true;
+}
+
 const char *ErrorHandler_CodeToString(ErrorCode_t code)
 {
-    static const char *error_strings[] = {
+    static const char *const error_strings[] = {
         "NONE", "TIMEOUT", "COMM_LOST", "COMM_CORRUPT", "INVALID_DATA",
         "BUFFER_OVERFLOW", "RESOURCE_UNAVAILABLE", "CALIBRATION_FAILED",
-        "HARDWARE_FAULT", "WATCHDOG_RESET", "MEMORY_CORRUPTION"
+        "HARDWARE_FAULT", "WATCHDOG_RESET", "MEMORY_CORRUPTION",
+        "BUDGET_OVERRUN"
     };
     
     if (code < ERROR_CODE_MAX) {
@@ -258,7 +760,7 @@ const char *ErrorHandler_CodeToString(ErrorCode_t code)
 
 const char *ErrorHandler_LevelToString(ErrorLevel_t level)
 {
-    static const char *level_strings[] = {
+    static const char *const level_strings[] = {
         "NONE", "MINOR", "NORMAL", "CRITICAL"
     };
     
@@ -268,13 +770,385 @@ const char *ErrorHandler_LevelToString(ErrorLevel_t level)
     return "UNKNOWN";
 }
 
-static void AddErrorToHistory(const ErrorInfo_t *error_info)
+static bool RunRecoveryHandler(ErrorCode_t code)
+{
+    /* Try custom handler if registered */
+    if (g_recovery_handlers[code] != NULL) {
+        return g_recovery_handlers[code](code);
+    }
+    
+    /* Default recovery logic */
+    switch (code) {
+        case ERROR_CODE_COMM_LOST:
+            if (ErrorHandler_VerifyCommChannel()) {
+                g_error_handler.current_error.is_recovered = true;
+                return true;
+            }
+            break;
+            
+        case ERROR_CODE_TIMEOUT:
+            /* Timeout errors can usually retry */
+            g_error_handler.current_error.is_recovered = true;
+            return true;
+            
+        default:
+            /* Unknown error - cannot recover */
+            break;
+    }
+    
+    return false;
+}
+
+static uint32_t RecoveryDelay(const RecoveryPolicy_t *policy, RecoveryBreaker_t *breaker,
+                              uint8_t attempt, uint32_t now)
+{
+    uint32_t delay = policy->delay_ms;
+    uint32_t spread;
+    
+    switch ((RecoveryStrategy_t)policy->strategy) {
+        case RECOVERY_STRATEGY_IMMEDIATE:
+            return 0;
+            
+        case RECOVERY_STRATEGY_BACKOFF:
+            /* delay_ms << (attempt - 1), capped without overflowing */
+            for (uint8_t i = 1U; i < attempt && delay < policy->max_delay_ms; i++) {
+                delay <<= 1;
+            }
+            if (delay > policy->max_delay_ms) {
+                delay = policy->max_delay_ms;
+            }
+            spread = (delay / 100U) * policy->jitter_percent;
+            if (spread > 0U) {
+                delay = delay - spread + (NextJitterRandom() % ((2U * spread) + 1U));
+            }
+            return delay;
+            
+        case RECOVERY_STRATEGY_CIRCUIT_BREAKER:
+            if (breaker->consecutive_failures < 0xFFU) {
+                breaker->consecutive_failures++;
+            }
+            if (breaker->consecutive_failures >= policy->failure_threshold) {
+                DEBUG_WARNING("Recovery circuit breaker open for %lu ms",
+                             (unsigned long)policy->open_ms);
+                breaker->is_open = true;
+                breaker->open_until = now + policy->open_ms;
+                return policy->open_ms;
+            }
+            return delay;
+            
+        case RECOVERY_STRATEGY_FIXED:
+        default:
+            return delay;
+    }
+}
+
+static uint32_t NextJitterRandom(void)
 {
+    /* xorshift32 - deterministic, so simulations replay identically */
+    uint32_t x = g_error_handler.recovery_jitter_seed;
+    
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_error_handler.recovery_jitter_seed = x;
+    return x;
+}
+
+#if FEATURE_ERROR_RATES
+static void CountErrorRate(ErrorCode_t code, StateMachineState_t state, uint32_t now)
+{
+    ErrorRateCounters_t *rates = &g_error_handler.rates;
+    uint32_t epochs[ERROR_RATE_WINDOW_MAX];
+    bool rotate[ERROR_RATE_WINDOW_MAX];
+    bool any_rotate = false;
+    
+    Platform_EnterCritical();
+    for (uint32_t window = 0; window < ERROR_RATE_WINDOW_MAX; window++) {
+        uint32_t epoch = now / g_rate_bucket_ms[window];
+        uint32_t bucket = epoch % ERROR_RATE_BUCKETS;
+        uint32_t current = rates->epoch[window][bucket];
+        
+        epochs[window] = epoch;
+        rotate[window] = false;
+        if (current == epoch) {
+            rates->by_code[window][bucket][code]++;
+            rates->by_state[window][bucket][state]++;
+        } else if (current != RATE_EPOCH_CLEARING) {
+            /* Bucket holds an older period - claim it for reuse. Readers
+             * reject it until the new epoch is published. */
+            SM_ATOMIC_STORE(&rates->epoch[window][bucket], RATE_EPOCH_CLEARING);
+            rotate[window] = true;
+            any_rotate = true;
+        } else {
+            /* Another context is clearing this bucket - the count is lost */
+        }
+    }
+    Platform_ExitCritical();
+    
+    if (!any_rotate) {
+        return;
+    }
+    
+    /* Clear outside the critical section (the claim keeps others out) */
+    for (uint32_t window = 0; window < ERROR_RATE_WINDOW_MAX; window++) {
+        uint32_t bucket = epochs[window] % ERROR_RATE_BUCKETS;
+        
+        if (!rotate[window]) {
+            continue;
+        }
+        for (uint32_t i = 0; i < ERROR_CODE_MAX; i++) {
+            rates->by_code[window][bucket][i] = 0;
+        }
+        for (uint32_t i = 0; i < STATE_MAX; i++) {
+            rates->by_state[window][bucket][i] = 0;
+        }
+    }
+    
+    Platform_EnterCritical();
+    for (uint32_t window = 0; window < ERROR_RATE_WINDOW_MAX; window++) {
+        uint32_t bucket = epochs[window] % ERROR_RATE_BUCKETS;
+        
+        if (rotate[window]) {
+            rates->by_code[window][bucket][code]++;
+            rates->by_state[window][bucket][state]++;
+            SM_ATOMIC_STORE(&rates->epoch[window][bucket], epochs[window]);
+        }
+    }
+    Platform_ExitCritical();
+}
+
+static bool ReadRateBucket(ErrorRateWindow_t window, uint32_t bucket, uint32_t current_epoch,
+                           const volatile uint32_t *counts, uint32_t *out, uint32_t n)
+{
+    uint32_t epoch = SM_ATOMIC_LOAD(&g_error_handler.rates.epoch[window][bucket]);
+    
+    /* Empty, being cleared, or outside the window (also covers clock wraparound) */
+    if (epoch == RATE_EPOCH_INVALID || epoch == RATE_EPOCH_CLEARING ||
+        (current_epoch - epoch) >= ERROR_RATE_BUCKETS) {
+        return false;
+    }
+    
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = counts[i];
+    }
+    
+    /* Rotated while copying - the bucket belongs to a newer period now */
+    SM_ATOMIC_FENCE();
+    return SM_ATOMIC_LOAD(&g_error_handler.rates.epoch[window][bucket]) == epoch;
+}
+#endif
+
+#if FEATURE_ERROR_PERSIST
+static void RecoverPersistentLog(void)
+{
+    ErrorPersistInfo_t info;
+    
+    if (!ErrorPersist_Recover(&info)) {
+        return;  /* No persistent region attached */
+    }
+    
+    DEBUG_INIT("Persistent log: boot %lu, %lu errors / %lu transitions recovered",
+               (unsigned long)info.boot_count, (unsigned long)info.recovered_errors,
+               (unsigned long)info.recovered_transitions);
+    if (info.has_last_error) {
+        DEBUG_WARNING("Previous run: %s error %s in %s",
+                      ErrorHandler_LevelToString((ErrorLevel_t)info.last_error.a),
+                      ErrorHandler_CodeToString((ErrorCode_t)info.last_error.b),
+                      StateMachine_StateToString((StateMachineState_t)info.last_error.c));
+    }
+}
+#endif
+
+static void PutErrorInfo(SnapshotWriter_t *writer, const ErrorInfo_t *error_info)
+{
+    Snapshot_PutU32(writer, error_info->timestamp);
+    Snapshot_PutU32(writer, error_info->last_timestamp);
+    Snapshot_PutU32(writer, error_info->seq);
+    Snapshot_PutU16(writer, error_info->count);
+    Snapshot_PutU8(writer, (uint8_t)error_info->level);
+    Snapshot_PutU8(writer, (uint8_t)error_info->code);
+    Snapshot_PutU8(writer, (uint8_t)error_info->state);
+    Snapshot_PutU8(writer, error_info->retry_count);
+    Snapshot_PutU8(writer, (uint8_t)error_info->is_recovered);
+}
+
+static bool GetErrorInfo(SnapshotReader_t *reader, ErrorInfo_t *error_info)
+{
+    uint8_t level;
+    uint8_t code;
+    uint8_t state;
+    
+    error_info->timestamp = Snapshot_GetU32(reader);
+    error_info->last_timestamp = Snapshot_GetU32(reader);
+    error_info->seq = Snapshot_GetU32(reader);
+    error_info->count = Snapshot_GetU16(reader);
+    level = Snapshot_GetU8(reader);
+    code = Snapshot_GetU8(reader);
+    state = Snapshot_GetU8(reader);
+    error_info->retry_count = Snapshot_GetU8(reader);
+    error_info->is_recovered = Snapshot_GetU8(reader) != 0U;
+    
+    if (reader->underflow || level >= (uint8_t)ERROR_LEVEL_MAX ||
+        code >= (uint8_t)ERROR_CODE_MAX || state >= (uint8_t)STATE_MAX) {
+        return false;
+    }
+    error_info->level = (ErrorLevelStorage_t)level;
+    error_info->code = (ErrorCodeStorage_t)code;
+    error_info->state = (StateStorage_t)state;
+    return true;
+}
+
+static uint32_t AddErrorToHistory(const ErrorInfo_t *error_info)
+{
+    ErrorHandler_t *handler = &g_error_handler;
+    ErrorInfo_t *entry;
+    uint32_t seq;
+    
     if (error_info == NULL) {
+        return 0;
+    }
+    
+    /* Claim a sequence number - each writer owns its slot (MPSC) */
+    seq = AtomicIncrement(&handler->history_claimed);
+    entry = &handler->error_history[(seq - 1U) % ERROR_HISTORY_SIZE];
+    
+    if (!LockHistorySlot(entry, seq)) {
+        (void)AtomicIncrement(&handler->history_dropped);
+        return 0;
+    }
+    
+    /* Slot is marked busy (seq 0) - fill it, then publish the sequence number */
+    entry->timestamp = error_info->timestamp;
+    entry->last_timestamp = error_info->last_timestamp;
+    entry->count = error_info->count;
+    entry->level = error_info->level;
+    entry->code = error_info->code;
+    entry->state = error_info->state;
+    entry->retry_count = error_info->retry_count;
+    entry->is_recovered = error_info->is_recovered;
+    SM_ATOMIC_STORE(&entry->seq, seq);
+    
+#if FEATURE_ERROR_PERSIST
+    ErrorPersist_RecordError(error_info);
+#endif
+    
+    return seq;
+}
+
+static bool RateLimitAdmit(ErrorCode_t code, ErrorInfo_t *error_info)
+{
+    ErrorRateBucket_t *bucket = &g_error_handler.rate_limit[code];
+    uint32_t now = error_info->timestamp;
+    bool admitted = true;
+    
+    if (bucket->burst == 0U) {
+        return true;
+    }
+    
+    Platform_EnterCritical();
+    RefillBucket(bucket, now);
+    if (bucket->tokens == 0U) {
+        /* Suppress: count only, no history, formatting or event */
+        if (bucket->pending == 0U) {
+            bucket->first_suppressed = now;
+        }
+        bucket->pending++;
+        bucket->suppressed_total++;
+        bucket->last_suppressed = now;
+        bucket->level = error_info->level;
+        bucket->state = error_info->state;
+        g_error_handler.rate_limit_pending |= ((uint32_t)1U << code);
+        admitted = false;
+    } else {
+        bucket->tokens--;
+        if (bucket->pending > 0U) {
+            /* Fold the suppressed repeats into this entry */
+            uint32_t count = bucket->pending + 1U;
+            error_info->count = (uint16_t)((count < 0xFFFFU) ? count : 0xFFFFU);
+            error_info->timestamp = bucket->first_suppressed;
+            bucket->pending = 0;
+            g_error_handler.rate_limit_pending &= ~((uint32_t)1U << code);
+            g_error_handler.rate_limit_aggregated++;
+        }
+    }
+    Platform_ExitCritical();
+    
+    return admitted;
+}
+
+static void RefillBucket(ErrorRateBucket_t *bucket, uint32_t now)
+{
+    uint32_t added = (now - bucket->last_refill) / bucket->refill_ms;
+    
+    if (added == 0U) {
         return;
     }
     
-    ErrorHandler_t *handler = &g_sm_context.error_handler;
-    memcpy(&handler->error_history[handler->history_index], error_info, sizeof(ErrorInfo_t));
-    handler->history_index = (handler->history_index + 1) % ERROR_HISTORY_SIZE;
+    if (added >= (uint32_t)(bucket->burst - bucket->tokens)) {
+        bucket->tokens = bucket->burst;
+        bucket->last_refill = now;
+    } else {
+        bucket->tokens = (uint8_t)(bucket->tokens + added);
+        bucket->last_refill += added * bucket->refill_ms;
+    }
+}
+
+static bool LockHistorySlot(ErrorInfo_t *entry, uint32_t seq)
+{
+    uint32_t previous = SM_ATOMIC_LOAD(&entry->seq);
+    bool locked;
+    
+    /* Busy on a later lap: a writer one lap behind is still filling it */
+    if (previous == 0U && seq > ERROR_HISTORY_SIZE) {
+        return false;
+    }
+    
+    /* Already published by a later lap: this writer stalled for a full lap */
+    if ((int32_t)(previous - seq) > 0) {
+        return false;
+    }
+    
+#if SM_HAS_ATOMIC_BUILTINS
+    locked = __atomic_compare_exchange_n(&entry->seq, &previous, 0U, false,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+#else
+    Platform_EnterCritical();
+    locked = (entry->seq == previous);
+    if (locked) {
+        entry->seq = 0;
+    }
+    Platform_ExitCritical();
+#endif
+    
+    /* Order the busy marker before the field stores */
+    SM_ATOMIC_FENCE();
+    return locked;
+}
+
+static bool ReadHistorySlot(uint32_t seq, ErrorInfo_t *error_info)
+{
+    const ErrorInfo_t *entry = &g_error_handler.error_history[(seq - 1U) % ERROR_HISTORY_SIZE];
+    
+    if (seq == 0U || SM_ATOMIC_LOAD(&entry->seq) != seq) {
+        return false;
+    }
+    
+    /* Copy, then confirm the writer did not reclaim the slot meanwhile */
+    *error_info = *entry;
+    SM_ATOMIC_FENCE();
+    return (SM_ATOMIC_LOAD(&entry->seq) == seq) && (error_info->seq == seq);
+}
+
+static uint32_t AtomicIncrement(volatile uint32_t *value)
+{
+#if SM_HAS_ATOMIC_BUILTINS
+    return __atomic_add_fetch(value, 1U, __ATOMIC_ACQ_REL);
+#else
+    uint32_t result;
+    
+    Platform_EnterCritical();
+    result = ++(*value);
+    Platform_ExitCritical();
+    return result;
+#endif
 }
@@ -0,0 +1,292 @@
+/**
+ * @file sm_error_persist.c
+ * @brief Crash-persistent error and transition log implementation
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_error_persist.h"
+#include "sm_framework/sm_platform.h"
+#include <stddef.h>
+#include <string.h>
+
+/* CRC covers everything before the crc field */
+#define RECORD_CRC_LENGTH  ((uint32_t)offsetof(ErrorPersistRecord_t, crc))
+#define HEADER_CRC_LENGTH  ((uint32_t)offsetof(ErrorPersistHeader_t, crc))
+
+/**
+ * @brief One append-only ring
+ */
+typedef struct {
+    ErrorPersistRecord_t *records;   /**< Ring storage */
+    uint32_t capacity;               /**< Records in the ring */
+    volatile uint32_t last_seq;      /**< Last sequence number handed out */
+} PersistRing_t;
+
+/* Attached region (header NULL when detached) */
+static ErrorPersistHeader_t *g_persist_header = NULL;
+static PersistRing_t g_rings[ERROR_PERSIST_RING_MAX];
+static ErrorPersistInfo_t g_persist_info;
+static volatile bool g_persist_active = false;
+
+/* Forward declarations */
+static uint16_t Crc16(const void *data, uint32_t length);
+static bool RecordValid(const ErrorPersistRecord_t *record);
+static void ScanRing(PersistRing_t *ring, uint32_t *valid, uint32_t *corrupt);
+static void Append(PersistRing_t *ring, uint32_t seq, ErrorPersistKind_t kind, uint32_t timestamp,
+                   uint8_t a, uint8_t b, uint8_t c, uint32_t extra);
+static uint32_t ClaimSeq(PersistRing_t *ring);
+
+bool ErrorPersist_Attach(void *memory, uint32_t size, uint32_t error_capacity,
+                         uint32_t transition_capacity)
+{
+    ErrorPersistHeader_t *header = (ErrorPersistHeader_t *)memory;
+    ErrorPersistRecord_t *records;
+
+    if (memory == NULL || error_capacity == 0U || transition_capacity == 0U ||
+        error_capacity > (UINT32_MAX / 2U) || transition_capacity > (UINT32_MAX / 2U) ||
+        size < ERROR_PERSIST_SIZE((uint64_t)error_capacity, (uint64_t)transition_capacity)) {
+        return false;
+    }
+
+    ErrorPersist_Detach();
+    memset(&g_persist_info, 0, sizeof(g_persist_info));
+
+    /* Keep the content only if it is a log with the same geometry */
+    if (header->magic != ERROR_PERSIST_MAGIC ||
+        header->version != ERROR_PERSIST_VERSION ||
+        header->record_size != sizeof(ErrorPersistRecord_t) ||
+        header->error_capacity != error_capacity ||
+        header->transition_capacity != transition_capacity ||
+        header->crc != Crc16(header, HEADER_CRC_LENGTH)) {
+        memset(header, 0, (size_t)ERROR_PERSIST_SIZE((uint64_t)error_capacity,
+                                                     (uint64_t)transition_capacity));
+        header->magic = ERROR_PERSIST_MAGIC;
+        header->version = ERROR_PERSIST_VERSION;
+        header->record_size = (uint16_t)sizeof(ErrorPersistRecord_t);
+        header->error_capacity = error_capacity;
+        header->transition_capacity = transition_capacity;
+        header->crc = Crc16(header, HEADER_CRC_LENGTH);
+        g_persist_info.formatted = true;
+    }
+
+    records = (ErrorPersistRecord_t *)(void *)(header + 1);
+    g_rings[ERROR_PERSIST_RING_ERRORS].records = records;
+    g_rings[ERROR_PERSIST_RING_ERRORS].capacity = error_capacity;
+    g_rings[ERROR_PERSIST_RING_TRANSITIONS].records = records + error_capacity;
+    g_rings[ERROR_PERSIST_RING_TRANSITIONS].capacity = transition_capacity;
+    g_persist_header = header;
+    return true;
+}
+
+void ErrorPersist_Detach(void)
+{
+    g_persist_active = false;
+    g_persist_header = NULL;
+}
+
+bool ErrorPersist_IsActive(void)
+{
+    return g_persist_active;
+}
+
+bool ErrorPersist_Recover(ErrorPersistInfo_t *info)
+{
+    ErrorPersistHeader_t *header = g_persist_header;
+    ErrorPersistRecord_t last_error;
+    uint32_t corrupt_errors = 0;
+    uint32_t corrupt_transitions = 0;
+    bool formatted = g_persist_info.formatted;
+
+    if (header == NULL) {
+        return false;
+    }
+
+    /* Stop appending while the rings are scanned */
+    g_persist_active = false;
+    memset(&g_persist_info, 0, sizeof(g_persist_info));
+    g_persist_info.formatted = formatted;
+
+    ScanRing(&g_rings[ERROR_PERSIST_RING_ERRORS], &g_persist_info.recovered_errors, &corrupt_errors);
+    ScanRing(&g_rings[ERROR_PERSIST_RING_TRANSITIONS], &g_persist_info.recovered_transitions,
+             &corrupt_transitions);
+    g_persist_info.corrupt_records = corrupt_errors + corrupt_transitions;
+
+    /* Newest error of the previous run (stop at its boot marker) */
+    for (uint32_t seq = g_rings[ERROR_PERSIST_RING_ERRORS].last_seq, n = 0;
+         seq != 0U && n < g_rings[ERROR_PERSIST_RING_ERRORS].capacity; seq--, n++) {
+        last_error = g_rings[ERROR_PERSIST_RING_ERRORS].records[(seq - 1U) %
+                                                                g_rings[ERROR_PERSIST_RING_ERRORS].capacity];
+        if (!RecordValid(&last_error) || last_error.seq != seq ||
+            last_error.kind == (uint8_t)ERROR_PERSIST_BOOT) {
+            break;
+        }
+        if (last_error.kind == (uint8_t)ERROR_PERSIST_ERROR) {
+            g_persist_info.last_error = last_error;
+            g_persist_info.has_last_error = true;
+            break;
+        }
+    }
+
+    /* Count this run - the only header write */
+    header->boot_count++;
+    header->crc = Crc16(header, HEADER_CRC_LENGTH);
+    g_persist_info.boot_count = header->boot_count;
+
+    Append(&g_rings[ERROR_PERSIST_RING_ERRORS], ClaimSeq(&g_rings[ERROR_PERSIST_RING_ERRORS]),
+           ERROR_PERSIST_BOOT, Platform_GetTimeMs(), 0, 0, 0, header->boot_count);
+    g_persist_active = true;
+
+    if (info != NULL) {
+        *info = g_persist_info;
+    }
+    return true;
+}
+
+bool ErrorPersist_GetInfo(ErrorPersistInfo_t *info)
+{
+    if (info == NULL || g_persist_header == NULL || !g_persist_active) {
+        return false;
+    }
+
+    *info = g_persist_info;
+    return true;
+}
+
+void ErrorPersist_RecordError(const ErrorInfo_t *error)
+{
+    PersistRing_t *ring = &g_rings[ERROR_PERSIST_RING_ERRORS];
+
+    if (!g_persist_active || error == NULL) {
+        return;
+    }
+
+    Append(ring, ClaimSeq(ring), ERROR_PERSIST_ERROR, error->timestamp, (uint8_t)error->level,
+           (uint8_t)error->code, (uint8_t)error->state, error->count);
+}
+
+void ErrorPersist_RecordTransition(StateMachineState_t from, StateMachineState_t to,
+                                   StateMachineEvent_t event, uint32_t exec_count)
+{
+    PersistRing_t *ring = &g_rings[ERROR_PERSIST_RING_TRANSITIONS];
+
+    if (!g_persist_active) {
+        return;
+    }
+
+    /* Single writer (the state machine task) */
+    ring->last_seq++;
+    Append(ring, ring->last_seq, ERROR_PERSIST_TRANSITION, Platform_GetTimeMs(),
+           (uint8_t)from, (uint8_t)to, (uint8_t)event, exec_count);
+}
+
+uint32_t ErrorPersist_Read(ErrorPersistRing_t ring_id, ErrorPersistRecord_t *records,
+                           uint32_t max_records)
+{
+    const PersistRing_t *ring;
+    uint32_t last;
+    uint32_t span;
+    uint32_t copied = 0;
+
+    if (ring_id >= ERROR_PERSIST_RING_MAX || records == NULL || g_persist_header == NULL) {
+        return 0;
+    }
+
+    ring = &g_rings[ring_id];
+    last = SM_ATOMIC_LOAD(&ring->last_seq);
+    span = (last < ring->capacity) ? last : ring->capacity;
+    if (span > max_records) {
+        span = max_records;
+    }
+
+    for (uint32_t seq = last - span + 1U; span > 0U; seq++, span--) {
+        ErrorPersistRecord_t record = ring->records[(seq - 1U) % ring->capacity];
+
+        /* Skip torn, empty and already-overwritten slots */
+        if (RecordValid(&record) && record.seq == seq) {
+            records[copied++] = record;
+        }
+    }
+    return copied;
+}
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+static uint16_t Crc16(const void *data, uint32_t length)
+{
+    /* CRC-16/CCITT-FALSE, nibble table */
+    static const uint16_t table[16] = {
+        0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+        0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU
+    };
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint16_t crc = 0xFFFFU;
+
+    for (uint32_t i = 0; i < length; i++) {
+        crc = (uint16_t)((uint16_t)(crc << 4) ^ table[(crc >> 12) ^ (bytes[i] >> 4)]);
+        crc = (uint16_t)((uint16_t)(crc << 4) ^ table[(crc >> 12) ^ (bytes[i] & 0x0FU)]);
+    }
+    return crc;
+}
+
+static bool RecordValid(const ErrorPersistRecord_t *record)
+{
+    return record->kind != (uint8_t)ERROR_PERSIST_EMPTY &&
+           record->kind < (uint8_t)ERROR_PERSIST_KIND_MAX &&
+           record->seq != 0U &&
+           record->crc == Crc16(record, RECORD_CRC_LENGTH);
+}
+
+static void ScanRing(PersistRing_t *ring, uint32_t *valid, uint32_t *corrupt)
+{
+    uint32_t newest = 0;
+
+    *valid = 0;
+    *corrupt = 0;
+    for (uint32_t i = 0; i < ring->capacity; i++) {
+        const ErrorPersistRecord_t *record = &ring->records[i];
+
+        if (RecordValid(record) && ((record->seq - 1U) % ring->capacity) == i) {
+            (*valid)++;
+            if (record->seq > newest) {
+                newest = record->seq;
+            }
+        } else if (record->kind != (uint8_t)ERROR_PERSIST_EMPTY) {
+            (*corrupt)++;
+        }
+    }
+    ring->last_seq = newest;
+}
+
+static void Append(PersistRing_t *ring, uint32_t seq, ErrorPersistKind_t kind, uint32_t timestamp,
+                   uint8_t a, uint8_t b, uint8_t c, uint32_t extra)
+{
+    ErrorPersistRecord_t record;
+
+    record.seq = seq;
+    record.timestamp = timestamp;
+    record.kind = (uint8_t)kind;
+    record.a = a;
+    record.b = b;
+    record.c = c;
+    record.extra = (uint16_t)((extra < 0xFFFFU) ? extra : 0xFFFFU);
+    record.crc = Crc16(&record, RECORD_CRC_LENGTH);
+
+    /* One 16-byte store; a crash in the middle leaves a bad CRC */
+    ring->records[(seq - 1U) % ring->capacity] = record;
+}
+
+static uint32_t ClaimSeq(PersistRing_t *ring)
+{
+#if SM_HAS_ATOMIC_BUILTINS
+    return __atomic_add_fetch(&ring->last_seq, 1U, __ATOMIC_ACQ_REL);
+#else
+    uint32_t seq;
+
+    Platform_EnterCritical();
+    seq = ++ring->last_seq;
+    Platform_ExitCritical();
+    return seq;
+#endif
+}
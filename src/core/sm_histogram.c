@@ -0,0 +1,260 @@
+/**
+ * @file sm_histogram.c
+ * @brief Log-linear (HDR-style) histograms
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_histogram.h"
+#include "sm_framework/sm_snapshot.h"
+#include <string.h>
+
+/* Forward declarations */
+static bool ReadBody(Histogram_t *histogram, SnapshotReader_t *reader);
+
+void Histogram_Init(Histogram_t *histogram)
+{
+    if (histogram != NULL) {
+        memset(histogram, 0, sizeof(Histogram_t));
+    }
+}
+
+void Histogram_Record(Histogram_t *histogram, uint32_t value)
+{
+    if (histogram->total == 0U || value < histogram->min) {
+        histogram->min = value;
+    }
+    if (value > histogram->max) {
+        histogram->max = value;
+    }
+    histogram->counts[Histogram_BucketIndex(value)]++;
+    histogram->sum += value;
+    histogram->total++;
+}
+
+bool Histogram_Merge(Histogram_t *dest, const Histogram_t *src)
+{
+    if (dest == NULL || src == NULL || (dest->total + src->total) < dest->total) {
+        return false;
+    }
+    if (src->total == 0U) {
+        return true;
+    }
+
+    for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        dest->counts[bucket] += src->counts[bucket];
+    }
+    if (dest->total == 0U || src->min < dest->min) {
+        dest->min = src->min;
+    }
+    if (src->max > dest->max) {
+        dest->max = src->max;
+    }
+    dest->sum += src->sum;
+    dest->total += src->total;
+    return true;
+}
+
+uint32_t Histogram_Percentile(const Histogram_t *histogram, uint32_t per_mille)
+{
+    uint32_t target;
+    uint32_t seen = 0;
+
+    if (histogram == NULL || histogram->total == 0U) {
+        return 0;
+    }
+
+    /* Rank of the value, at least the first one */
+    target = (uint32_t)(((uint64_t)histogram->total * per_mille + 999U) / 1000U);
+    if (target == 0U) {
+        target = 1U;
+    }
+
+    for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        seen += histogram->counts[bucket];
+        if (seen >= target) {
+            uint32_t upper;
+
+            /* The last bucket is open-ended */
+            if ((bucket + 1U) >= HISTOGRAM_BUCKETS) {
+                return histogram->max;
+            }
+            upper = Histogram_BucketLower(bucket + 1U) - 1U;
+            return (upper < histogram->max) ? upper : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+uint32_t Histogram_Mean(const Histogram_t *histogram)
+{
+    if (histogram == NULL || histogram->total == 0U) {
+        return 0;
+    }
+    return (uint32_t)(histogram->sum / histogram->total);
+}
+
+uint32_t Histogram_BucketIndex(uint32_t value)
+{
+    uint32_t msb = 0;
+
+    if (value > HISTOGRAM_MAX_VALUE) {
+        value = HISTOGRAM_MAX_VALUE;
+    }
+    if (value < HISTOGRAM_SUB_COUNT) {
+        return value;
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    msb = 31U - (uint32_t)__builtin_clz(value);
+#else
+    for (uint32_t v = value; v > 1U; v >>= 1) {
+        msb++;
+    }
+#endif
+
+    /* Power of two selects the group, the next HISTOGRAM_SUB_BITS bits the bucket */
+    return ((msb - HISTOGRAM_SUB_BITS + 1U) << HISTOGRAM_SUB_BITS) +
+           ((value >> (msb - HISTOGRAM_SUB_BITS)) & (HISTOGRAM_SUB_COUNT - 1U));
+}
+
+uint32_t Histogram_BucketLower(uint32_t bucket)
+{
+    uint32_t shift;
+
+    if (bucket < HISTOGRAM_SUB_COUNT) {
+        return bucket;
+    }
+    if (bucket >= HISTOGRAM_BUCKETS) {
+        return HISTOGRAM_MAX_VALUE;
+    }
+
+    shift = (bucket >> HISTOGRAM_SUB_BITS) - 1U;
+    return (HISTOGRAM_SUB_COUNT + (bucket & (HISTOGRAM_SUB_COUNT - 1U))) << shift;
+}
+
+uint32_t Histogram_Serialize(const Histogram_t *histogram, uint8_t *buffer, uint32_t size)
+{
+    SnapshotWriter_t writer = {buffer, size, 0, false};
+    uint16_t entries = 0;
+
+    if (histogram == NULL || buffer == NULL) {
+        return 0;
+    }
+
+    for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        if (histogram->counts[bucket] != 0U) {
+            entries++;
+        }
+    }
+
+    Snapshot_PutU16(&writer, (uint16_t)HISTOGRAM_MAGIC);
+    Snapshot_PutU8(&writer, (uint8_t)HISTOGRAM_VERSION);
+    Snapshot_PutU8(&writer, (uint8_t)HISTOGRAM_SUB_BITS);
+    Snapshot_PutU8(&writer, (uint8_t)HISTOGRAM_MAX_BITS);
+    Snapshot_PutU8(&writer, 0U);
+    Snapshot_PutU16(&writer, entries);
+    Snapshot_PutU32(&writer, histogram->total);
+    Snapshot_PutU32(&writer, histogram->min);
+    Snapshot_PutU32(&writer, histogram->max);
+    Snapshot_PutU32(&writer, (uint32_t)(histogram->sum & 0xFFFFFFFFUL));
+    Snapshot_PutU32(&writer, (uint32_t)(histogram->sum >> 32));
+
+    for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        if (histogram->counts[bucket] != 0U) {
+            Snapshot_PutU16(&writer, (uint16_t)bucket);
+            Snapshot_PutU32(&writer, histogram->counts[bucket]);
+        }
+    }
+    if (writer.overflow) {
+        return 0;
+    }
+
+    Snapshot_PutU32(&writer, Snapshot_Crc32(buffer, writer.length));
+    return writer.overflow ? 0U : writer.length;
+}
+
+bool Histogram_Deserialize(Histogram_t *histogram, const uint8_t *data, uint32_t length)
+{
+    SnapshotReader_t reader = {data, 0, 0, false};
+    SnapshotReader_t check;
+
+    if (histogram == NULL || data == NULL || length < HISTOGRAM_SERIALIZED_OVERHEAD) {
+        return false;
+    }
+
+    /* Checksum over everything before the trailing CRC */
+    reader.length = length - 4U;
+    check = (SnapshotReader_t){data, length, length - 4U, false};
+    if (Snapshot_GetU32(&check) != Snapshot_Crc32(data, length - 4U)) {
+        return false;
+    }
+
+    if (Snapshot_GetU16(&reader) != (uint16_t)HISTOGRAM_MAGIC ||
+        Snapshot_GetU8(&reader) != (uint8_t)HISTOGRAM_VERSION ||
+        Snapshot_GetU8(&reader) != (uint8_t)HISTOGRAM_SUB_BITS ||
+        Snapshot_GetU8(&reader) != (uint8_t)HISTOGRAM_MAX_BITS) {
+        return false;
+    }
+    (void)Snapshot_GetU8(&reader);
+
+    /* Validate on a copy of the stream, then load */
+    check = reader;
+    if (!ReadBody(NULL, &check)) {
+        return false;
+    }
+    return ReadBody(histogram, &reader);
+}
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+/**
+ * @brief Read entries and totals (histogram NULL = validate only)
+ */
+static bool ReadBody(Histogram_t *histogram, SnapshotReader_t *reader)
+{
+    uint16_t entries = Snapshot_GetU16(reader);
+    uint32_t total = Snapshot_GetU32(reader);
+    uint32_t min = Snapshot_GetU32(reader);
+    uint32_t max = Snapshot_GetU32(reader);
+    uint64_t sum = Snapshot_GetU32(reader);
+    uint32_t counted = 0;
+    int32_t previous = -1;
+
+    sum |= (uint64_t)Snapshot_GetU32(reader) << 32;
+
+    if (histogram != NULL) {
+        memset(histogram->counts, 0, sizeof(histogram->counts));
+    }
+
+    for (uint32_t i = 0; i < entries; i++) {
+        uint16_t bucket = Snapshot_GetU16(reader);
+        uint32_t count = Snapshot_GetU32(reader);
+
+        /* Ascending, in range, non-empty, no overflow of the total */
+        if ((int32_t)bucket <= previous || bucket >= HISTOGRAM_BUCKETS || count == 0U ||
+            (counted + count) < counted) {
+            return false;
+        }
+        previous = (int32_t)bucket;
+        counted += count;
+
+        if (histogram != NULL) {
+            histogram->counts[bucket] = count;
+        }
+    }
+
+    if (reader->underflow || reader->offset != reader->length || counted != total ||
+        (total != 0U && min > max)) {
+        return false;
+    }
+
+    if (histogram != NULL) {
+        histogram->total = total;
+        histogram->min = min;
+        histogram->max = max;
+        histogram->sum = sum;
+    }
+    return true;
+}
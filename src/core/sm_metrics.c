@@ -0,0 +1,406 @@
+/**
+ * @file sm_metrics.c
+ * @brief OpenMetrics / Prometheus text exporter
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_metrics.h"
+#include "sm_framework/sm_state_machine.h"
+#include "sm_framework/sm_error_handler.h"
+#include "sm_framework/sm_cadence.h"
+#include <string.h>
+
+/* Forward declarations */
+static void PutChar(MetricsWriter_t *writer, char c);
+static void PutString(MetricsWriter_t *writer, const char *text);
+static void PutEscaped(MetricsWriter_t *writer, const char *text);
+static void PutU64(MetricsWriter_t *writer, uint64_t value);
+static void PutScaled(MetricsWriter_t *writer, uint64_t value, uint32_t units_per_second);
+static bool PutLabels(MetricsWriter_t *writer, const char *labels, const char *key, const char *key_value);
+static void PutBucket(MetricsWriter_t *writer, const char *name, const char *labels, const char *key,
+                      const char *key_value, uint64_t le, uint32_t units_per_second, uint64_t count);
+#if FEATURE_TRANSITION_MATRIX
+static void PutMatrix(MetricsWriter_t *writer, const char *name, const char *labels, bool ignored);
+#endif
+
+uint32_t Metrics_Render(char *buffer, uint32_t size, const char *labels)
+{
+    MetricsWriter_t writer;
+
+    Metrics_WriterInit(&writer, buffer, size);
+    Metrics_RenderFramework(&writer, labels);
+    return Metrics_Finish(&writer);
+}
+
+void Metrics_WriterInit(MetricsWriter_t *writer, char *buffer, uint32_t size)
+{
+    writer->buffer = buffer;
+    writer->size = (buffer != NULL) ? size : 0U;
+    writer->length = 0;
+    writer->overflow = false;
+}
+
+void Metrics_RenderFramework(MetricsWriter_t *writer, const char *labels)
+{
+    StateMachineState_t current = StateMachine_GetCurrentState();
+    ErrorRateLimitStats_t limits;
+#if SM_STATS_LEVEL >= 1
+    StateMachineStats_t stats;
+#endif
+#if SM_STATS_LEVEL >= 2
+    Histogram_t histogram;
+#endif
+#if FEATURE_STATE_BUDGETS
+    StateBudgetStats_t budget;
+#endif
+
+    Metrics_Family(writer, "sm_state", "stateset", "Current state.");
+    for (uint32_t state = 0; state < STATE_MAX; state++) {
+        Metrics_Sample(writer, "sm_state", labels, "sm_state",
+                       StateMachine_StateToString((StateMachineState_t)state),
+                       (state == (uint32_t)current) ? 1U : 0U);
+    }
+
+    Metrics_Family(writer, "sm_ticks", "counter", "State machine ticks.");
+    Metrics_Sample(writer, "sm_ticks_total", labels, NULL, NULL, StateMachine_GetTickCount());
+
+    Metrics_Family(writer, "sm_critical_lock", "gauge", "1 while the critical error lock is active.");
+    Metrics_Sample(writer, "sm_critical_lock", labels, NULL, NULL, ErrorHandler_IsCriticalLock() ? 1U : 0U);
+
+    Metrics_Family(writer, "sm_errors", "counter", "Error reports per code.");
+    for (uint32_t code = 1; code < ERROR_CODE_MAX; code++) {
+        Metrics_Sample(writer, "sm_errors_total", labels, "code",
+                       ErrorHandler_CodeToString((ErrorCode_t)code),
+                       ErrorHandler_GetReportCount((ErrorCode_t)code));
+    }
+
+    (void)ErrorHandler_GetRateLimitStats(&limits);
+    Metrics_Family(writer, "sm_errors_suppressed", "counter", "Error reports suppressed by rate limiting.");
+    for (uint32_t code = 1; code < ERROR_CODE_MAX; code++) {
+        Metrics_Sample(writer, "sm_errors_suppressed_total", labels, "code",
+                       ErrorHandler_CodeToString((ErrorCode_t)code), limits.suppressed[code]);
+    }
+
+#if SM_STATS_LEVEL >= 1
+    (void)StateMachine_GetStats(&stats);
+
+    Metrics_Family(writer, "sm_transitions", "counter", "State transitions.");
+    Metrics_Sample(writer, "sm_transitions_total", labels, NULL, NULL, stats.total_transitions);
+    Metrics_Family(writer, "sm_events_posted", "counter", "Events accepted into the queue.");
+    Metrics_Sample(writer, "sm_events_posted_total", labels, NULL, NULL, stats.total_events_posted);
+    Metrics_Family(writer, "sm_events_dropped", "counter", "Events dropped because the queue was full.");
+    Metrics_Sample(writer, "sm_events_dropped_total", labels, NULL, NULL, stats.total_events_dropped);
+    Metrics_Family(writer, "sm_events_ignored", "counter", "Events not handled in the current state.");
+    Metrics_Sample(writer, "sm_events_ignored_total", labels, NULL, NULL, stats.total_events_ignored);
+    Metrics_Family(writer, "sm_state_timeouts", "counter", "State timeouts.");
+    Metrics_Sample(writer, "sm_state_timeouts_total", labels, NULL, NULL, stats.total_timeouts);
+
+    Metrics_Family(writer, "sm_state_entries", "counter", "Entries per state.");
+    for (uint32_t state = 0; state < STATE_MAX; state++) {
+        Metrics_Sample(writer, "sm_state_entries_total", labels, "state",
+                       StateMachine_StateToString((StateMachineState_t)state), stats.state_entry_counts[state]);
+    }
+#endif
+
+#if SM_STATS_LEVEL >= 2
+    Metrics_Family(writer, "sm_task_deadline_misses", "counter", "Task intervals over SM_CADENCE_DEADLINE_US.");
+    Metrics_Sample(writer, "sm_task_deadline_misses_total", labels, NULL, NULL, stats.cadence.deadline_misses);
+
+    Metrics_Family(writer, "sm_event_latency_seconds", "histogram", "Time from event post to dispatch.");
+    (void)StateMachine_GetEventLatencyHistogram(&histogram);
+    Metrics_Histogram(writer, "sm_event_latency_seconds", labels, NULL, NULL, &histogram, 1000000U);
+
+    Metrics_Family(writer, "sm_task_jitter_seconds", "histogram", "Deviation of the task interval from the period.");
+    (void)Cadence_GetHistogram(&histogram);
+    Metrics_Histogram(writer, "sm_task_jitter_seconds", labels, NULL, NULL, &histogram, 1000000U);
+
+    Metrics_Family(writer, "sm_state_residency_seconds", "histogram", "Time spent per state visit.");
+    for (uint32_t state = 0; state < STATE_MAX; state++) {
+        (void)StateMachine_GetResidencyHistogram((StateMachineState_t)state, &histogram);
+        Metrics_Histogram(writer, "sm_state_residency_seconds", labels, "state",
+                          StateMachine_StateToString((StateMachineState_t)state), &histogram, 1000U);
+    }
+#endif
+
+#if FEATURE_STATE_BUDGETS
+    Metrics_Family(writer, "sm_state_budget_overruns", "counter", "Ticks over the state execution budget.");
+    for (uint32_t state = 0; state < STATE_MAX; state++) {
+        (void)StateMachine_GetBudgetStats((StateMachineState_t)state, &budget);
+        Metrics_Sample(writer, "sm_state_budget_overruns_total", labels, "state",
+                       StateMachine_StateToString((StateMachineState_t)state), budget.overruns);
+    }
+#endif
+
+#if FEATURE_TRANSITION_MATRIX
+    Metrics_Family(writer, "sm_dispatch_handled", "counter", "Events handled per state and event.");
+    PutMatrix(writer, "sm_dispatch_handled_total", labels, false);
+    Metrics_Family(writer, "sm_dispatch_ignored", "counter", "Events ignored per state and event.");
+    PutMatrix(writer, "sm_dispatch_ignored_total", labels, true);
+#endif
+}
+
+void Metrics_Family(MetricsWriter_t *writer, const char *name, const char *type, const char *help)
+{
+    PutString(writer, "# TYPE ");
+    PutString(writer, name);
+    PutChar(writer, ' ');
+    PutString(writer, type);
+    PutString(writer, "\n# HELP ");
+    PutString(writer, name);
+    PutChar(writer, ' ');
+    PutString(writer, help);
+    PutChar(writer, '\n');
+}
+
+void Metrics_Sample(MetricsWriter_t *writer, const char *name, const char *labels,
+                    const char *key, const char *key_value, uint64_t value)
+{
+    PutString(writer, name);
+    if (PutLabels(writer, labels, key, key_value)) {
+        PutChar(writer, '}');
+    }
+    PutChar(writer, ' ');
+    PutU64(writer, value);
+    PutChar(writer, '\n');
+}
+
+void Metrics_Histogram(MetricsWriter_t *writer, const char *name, const char *labels,
+                       const char *key, const char *key_value,
+                       const Histogram_t *histogram, uint32_t units_per_second)
+{
+    uint64_t count = 0;
+    uint32_t bucket = 0;
+
+    /* One boundary per power of two; the last group is open-ended (+Inf) */
+    for (uint32_t group = 0; group < (HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS); group++) {
+        for (uint32_t i = 0; i < HISTOGRAM_SUB_COUNT; i++) {
+            count += histogram->counts[bucket++];
+        }
+        PutBucket(writer, name, labels, key, key_value,
+                  (1ULL << (group + HISTOGRAM_SUB_BITS)) - 1U, units_per_second, count);
+    }
+    PutBucket(writer, name, labels, key, key_value, UINT64_MAX, units_per_second, histogram->total);
+
+    PutString(writer, name);
+    PutString(writer, "_count");
+    if (PutLabels(writer, labels, key, key_value)) {
+        PutChar(writer, '}');
+    }
+    PutChar(writer, ' ');
+    PutU64(writer, histogram->total);
+    PutChar(writer, '\n');
+
+    PutString(writer, name);
+    PutString(writer, "_sum");
+    if (PutLabels(writer, labels, key, key_value)) {
+        PutChar(writer, '}');
+    }
+    PutChar(writer, ' ');
+    PutScaled(writer, histogram->sum, units_per_second);
+    PutChar(writer, '\n');
+}
+
+uint32_t Metrics_Finish(MetricsWriter_t *writer)
+{
+    PutString(writer, "# EOF\n");
+    if (writer->overflow || writer->length >= writer->size) {
+        writer->overflow = true;
+        return 0;
+    }
+
+    writer->buffer[writer->length] = '\0';
+    return writer->length;
+}
+
+#if FEATURE_TRANSITION_MATRIX
+uint32_t Metrics_RenderTransitionMatrix(char *buffer, uint32_t size, bool ignored)
+{
+    MetricsWriter_t writer;
+    TransitionMatrixCell_t cell;
+
+    Metrics_WriterInit(&writer, buffer, size);
+
+    PutString(&writer, "state");
+    for (uint32_t event = 1; event < EVENT_MAX; event++) {
+        PutChar(&writer, ',');
+        PutString(&writer, StateMachine_EventToString((StateMachineEvent_t)event));
+    }
+    PutChar(&writer, '\n');
+
+    for (uint32_t state = 0; state < STATE_MAX; state++) {
+        PutString(&writer, StateMachine_StateToString((StateMachineState_t)state));
+        for (uint32_t event = 1; event < EVENT_MAX; event++) {
+            (void)StateMachine_GetTransitionCell((StateMachineState_t)state, (StateMachineEvent_t)event, &cell);
+            PutChar(&writer, ',');
+            PutU64(&writer, ignored ? cell.ignored : cell.hits);
+        }
+        PutChar(&writer, '\n');
+    }
+
+    PutChar(&writer, '\0');
+    return writer.overflow ? 0U : (writer.length - 1U);
+}
+#endif
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+static void PutChar(MetricsWriter_t *writer, char c)
+{
+    if (writer->length < writer->size) {
+        writer->buffer[writer->length++] = c;
+    } else {
+        writer->overflow = true;
+    }
+}
+
+static void PutString(MetricsWriter_t *writer, const char *text)
+{
+    uint32_t length = (uint32_t)strlen(text);
+
+    if (length > (writer->size - writer->length)) {
+        writer->overflow = true;
+        return;
+    }
+    memcpy(&writer->buffer[writer->length], text, length);
+    writer->length += length;
+}
+
+/**
+ * @brief Label value with backslash, quote and newline escaped
+ */
+static void PutEscaped(MetricsWriter_t *writer, const char *text)
+{
+    for (; *text != '\0'; text++) {
+        if (*text == '\\' || *text == '"') {
+            PutChar(writer, '\\');
+            PutChar(writer, *text);
+        } else if (*text == '\n') {
+            PutString(writer, "\\n");
+        } else {
+            PutChar(writer, *text);
+        }
+    }
+}
+
+static void PutU64(MetricsWriter_t *writer, uint64_t value)
+{
+    char digits[20];
+    uint32_t count = 0;
+
+    do {
+        digits[count++] = (char)('0' + (char)(value % 10U));
+        value /= 10U;
+    } while (value != 0U);
+
+    while (count > 0U) {
+        PutChar(writer, digits[--count]);
+    }
+}
+
+/**
+ * @brief Decimal value / units_per_second without floating point
+ */
+static void PutScaled(MetricsWriter_t *writer, uint64_t value, uint32_t units_per_second)
+{
+    uint64_t fraction;
+    uint32_t width = 0;
+
+    if (units_per_second <= 1U) {
+        PutU64(writer, value);
+        return;
+    }
+
+    PutU64(writer, value / units_per_second);
+    PutChar(writer, '.');
+
+    /* Zero-padded fraction, as many digits as units_per_second has zeros */
+    for (uint32_t unit = units_per_second; unit > 1U; unit /= 10U) {
+        width++;
+    }
+    fraction = value % units_per_second;
+    for (uint32_t scale = units_per_second / 10U; width > 1U && fraction < scale; scale /= 10U) {
+        PutChar(writer, '0');
+        width--;
+    }
+    PutU64(writer, fraction);
+}
+
+/**
+ * @brief Open the label set if there are labels
+ * @return true if "{" was written (caller closes it)
+ */
+static bool PutLabels(MetricsWriter_t *writer, const char *labels, const char *key, const char *key_value)
+{
+    bool has_labels = (labels != NULL && labels[0] != '\0');
+
+    if (!has_labels && key == NULL) {
+        return false;
+    }
+
+    PutChar(writer, '{');
+    if (has_labels) {
+        PutString(writer, labels);
+    }
+    if (key != NULL) {
+        if (has_labels) {
+            PutChar(writer, ',');
+        }
+        PutString(writer, key);
+        PutString(writer, "=\"");
+        PutEscaped(writer, key_value);
+        PutChar(writer, '"');
+    }
+    return true;
+}
+
+/**
+ * @brief One cumulative histogram bucket (le = UINT64_MAX for +Inf)
+ */
+static void PutBucket(MetricsWriter_t *writer, const char *name, const char *labels, const char *key,
+                      const char *key_value, uint64_t le, uint32_t units_per_second, uint64_t count)
+{
+    PutString(writer, name);
+    PutString(writer, "_bucket");
+    PutChar(writer, PutLabels(writer, labels, key, key_value) ? ',' : '{');
+    PutString(writer, "le=\"");
+    if (le == UINT64_MAX) {
+        PutString(writer, "+Inf");
+    } else {
+        PutScaled(writer, le, units_per_second);
+    }
+    PutString(writer, "\"} ");
+    PutU64(writer, count);
+    PutChar(writer, '\n');
+}
+
+#if FEATURE_TRANSITION_MATRIX
+/**
+ * @brief Samples of the non-zero (state, event) pairs
+ */
+static void PutMatrix(MetricsWriter_t *writer, const char *name, const char *labels, bool ignored)
+{
+    TransitionMatrixCell_t cell;
+
+    for (uint32_t state = 0; state < STATE_MAX; state++) {
+        for (uint32_t event = 1; event < EVENT_MAX; event++) {
+            uint32_t count;
+
+            (void)StateMachine_GetTransitionCell((StateMachineState_t)state, (StateMachineEvent_t)event, &cell);
+            count = ignored ? cell.ignored : cell.hits;
+            if (count == 0U) {
+                continue;
+            }
+
+            PutString(writer, name);
+            (void)PutLabels(writer, labels, "state", StateMachine_StateToString((StateMachineState_t)state));
+            PutString(writer, ",event=\"");
+            PutString(writer, StateMachine_EventToString((StateMachineEvent_t)event));
+            PutString(writer, "\"} ");
+            PutU64(writer, count);
+            PutChar(writer, '\n');
+        }
+    }
+}
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @file sm_observer.c
+ * @brief Transition observer registry and fan-out
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_observer.h"
+#include <string.h>
+
+/**
+ * @brief Registered observer
+ */
+typedef struct {
+    Observer_t callback;          /**< NULL when the slot is free */
+    void *context;                /**< Callback context */
+    ObserverFilter_t filter;      /**< What it wants */
+} ObserverSlot_t;
+
+static ObserverSlot_t g_observers[SM_MAX_OBSERVERS];
+
+/* Observers interested in each event / source state / target state (bit = slot) */
+static uint32_t g_match_event[SM_MAX_EVENTS];
+static uint32_t g_match_from[SM_MAX_STATES];
+static uint32_t g_match_to[SM_MAX_STATES];
+
+/* Forward declarations */
+static void RebuildMatchMasks(void);
+
+void Observer_Init(void)
+{
+    memset(g_observers, 0, sizeof(g_observers));
+    RebuildMatchMasks();
+}
+
+void Observer_FilterAll(ObserverFilter_t *filter)
+{
+    if (filter == NULL) {
+        return;
+    }
+
+    memset(filter, 0, sizeof(ObserverFilter_t));
+    for (uint32_t event = 0; event < (uint32_t)EVENT_MAX; event++) {
+        SM_EVENT_MASK_SET(filter->events, event);
+    }
+    for (uint32_t state = 0; state < (uint32_t)STATE_MAX; state++) {
+        filter->from_states |= OBSERVER_STATE_BIT(state);
+        filter->to_states |= OBSERVER_STATE_BIT(state);
+    }
+}
+
+uint8_t Observer_Subscribe(Observer_t observer, void *context, const ObserverFilter_t *filter)
+{
+    if (observer == NULL) {
+        return OBSERVER_INVALID_HANDLE;
+    }
+
+    for (uint8_t handle = 0; handle < SM_MAX_OBSERVERS; handle++) {
+        if (g_observers[handle].callback == NULL) {
+            g_observers[handle].callback = observer;
+            g_observers[handle].context = context;
+            (void)Observer_SetFilter(handle, filter);
+            return handle;
+        }
+    }
+    return OBSERVER_INVALID_HANDLE;
+}
+
+bool Observer_SetFilter(uint8_t handle, const ObserverFilter_t *filter)
+{
+    if (handle >= SM_MAX_OBSERVERS || g_observers[handle].callback == NULL) {
+        return false;
+    }
+
+    if (filter != NULL) {
+        g_observers[handle].filter = *filter;
+    } else {
+        Observer_FilterAll(&g_observers[handle].filter);
+    }
+    RebuildMatchMasks();
+    return true;
+}
+
+bool Observer_Unsubscribe(uint8_t handle)
+{
+    if (handle >= SM_MAX_OBSERVERS || g_observers[handle].callback == NULL) {
+        return false;
+    }
+
+    g_observers[handle].callback = NULL;
+    RebuildMatchMasks();
+    return true;
+}
+
+void Observer_Notify(const ObserverTransition_t *transition)
+{
+    uint32_t match;
+
+    if (transition->event >= EVENT_MAX || transition->from >= STATE_MAX ||
+        transition->to >= STATE_MAX) {
+        return;
+    }
+
+    /* Interested observers: three loads and two ANDs */
+    match = g_match_event[transition->event] & g_match_from[transition->from] &
+            g_match_to[transition->to];
+
+    for (uint32_t handle = 0; match != 0U; handle++, match >>= 1) {
+        if ((match & 1U) != 0U) {
+            Observer_t callback = g_observers[handle].callback;
+
+            /* An earlier observer may have unsubscribed this one */
+            if (callback != NULL) {
+                callback(transition, g_observers[handle].context);
+            }
+        }
+    }
+}
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+static void RebuildMatchMasks(void)
+{
+    memset(g_match_event, 0, sizeof(g_match_event));
+    memset(g_match_from, 0, sizeof(g_match_from));
+    memset(g_match_to, 0, sizeof(g_match_to));
+
+    for (uint32_t handle = 0; handle < SM_MAX_OBSERVERS; handle++) {
+        const ObserverFilter_t *filter = &g_observers[handle].filter;
+        uint32_t bit = 1UL << handle;
+
+        if (g_observers[handle].callback == NULL) {
+            continue;
+        }
+        for (uint32_t event = 0; event < (uint32_t)EVENT_MAX; event++) {
+            if (SM_EVENT_MASK_TEST(filter->events, event) != 0U) {
+                g_match_event[event] |= bit;
+            }
+        }
+        for (uint32_t state = 0; state < (uint32_t)STATE_MAX; state++) {
+            if ((filter->from_states & OBSERVER_STATE_BIT(state)) != 0U) {
+                g_match_from[state] |= bit;
+            }
+            if ((filter->to_states & OBSERVER_STATE_BIT(state)) != 0U) {
+                g_match_to[state] |= bit;
+            }
+        }
+    }
+}
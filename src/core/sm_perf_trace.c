@@ -0,0 +1,287 @@
+/**
+ * @file sm_perf_trace.c
+ * @brief State residency and callback timing trace implementation
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_perf_trace.h"
+#include "sm_framework/sm_platform.h"
+#include "sm_framework/sm_state_machine.h"
+#include <stdio.h>
+#include <string.h>
+
+/* JSON staging buffer - handed to the writer when nearly full */
+#define PERF_TRACE_TEXT_SIZE    (1024U)
+#define PERF_TRACE_EVENT_TEXT   (192U)   /* Longest single JSON event */
+
+/* Chrome trace "threads" */
+#define PERF_TRACE_TID_STATES    (1U)
+#define PERF_TRACE_TID_CALLBACKS (2U)
+
+/**
+ * @brief Tracer state
+ */
+typedef struct {
+    PerfTraceEvent_t *events;    /**< Event buffer */
+    uint32_t capacity;           /**< Buffer size in events */
+    uint32_t count;              /**< Buffered events */
+    uint32_t dropped;            /**< Events lost because the buffer was full */
+    PerfTraceWriter_t writer;    /**< JSON output */
+    void *context;               /**< Writer context */
+    uint32_t start_us;           /**< Trace start time */
+    uint32_t span_start_us;      /**< Entry time of current state */
+    StateMachineState_t span_state; /**< Current state */
+    uint32_t last_end_us;        /**< End time of last flushed event (low 32 bits) */
+    uint64_t last_end_full_us;   /**< End time of last flushed event (extended, from start) */
+    bool active;                 /**< Tracing enabled */
+} PerfTracer_t;
+
+static PerfTracer_t g_perf_trace;
+
+static char g_text[PERF_TRACE_TEXT_SIZE];
+static uint32_t g_text_length = 0;
+
+static const char *const g_kind_names[PERF_TRACE_KIND_MAX] = {
+    "state", "on_entry", "on_state", "on_exit", "transition"
+};
+
+/* Forward declarations */
+static void Append(PerfTraceKind_t kind, StateMachineState_t state, uint32_t ts_us,
+                   uint32_t dur_us, StateMachineEvent_t event, StateMachineState_t from);
+static void WriteEvent(const PerfTraceEvent_t *event);
+static void WriteText(const char *text, uint32_t length);
+static void FlushText(void);
+static uint64_t ExtendTimestamp(const PerfTraceEvent_t *event);
+
+bool PerfTrace_Start(PerfTraceEvent_t *events, uint32_t capacity,
+                     PerfTraceWriter_t writer, void *context)
+{
+    static const char header[] =
+        "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"State\"}},\n"
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"Callbacks\"}}";
+
+    if (events == NULL || capacity == 0U || writer == NULL) {
+        return false;
+    }
+
+    memset(&g_perf_trace, 0, sizeof(g_perf_trace));
+    g_perf_trace.events = events;
+    g_perf_trace.capacity = capacity;
+    g_perf_trace.writer = writer;
+    g_perf_trace.context = context;
+    g_perf_trace.start_us = Platform_GetTimeUs();
+    g_perf_trace.span_start_us = g_perf_trace.start_us;
+    g_perf_trace.span_state = StateMachine_GetCurrentState();
+    g_perf_trace.last_end_us = g_perf_trace.start_us;
+    g_perf_trace.last_end_full_us = 0;  /* JSON timestamps are relative to start */
+
+    g_text_length = 0;
+    WriteText(header, (uint32_t)(sizeof(header) - 1U));
+
+    g_perf_trace.active = true;
+    return true;
+}
+
+void PerfTrace_Stop(void)
+{
+    static const char footer[] = "\n]}\n";
+    uint32_t now;
+
+    if (!g_perf_trace.active) {
+        return;
+    }
+
+    /* Close the span of the current state (flush first so it always fits) */
+    (void)PerfTrace_Flush();
+    now = Platform_GetTimeUs();
+    Append(PERF_TRACE_STATE_SPAN, g_perf_trace.span_state, g_perf_trace.span_start_us,
+           now - g_perf_trace.span_start_us, EVENT_NONE, g_perf_trace.span_state);
+
+    g_perf_trace.active = false;
+    (void)PerfTrace_Flush();
+    WriteText(footer, (uint32_t)(sizeof(footer) - 1U));
+    FlushText();
+}
+
+uint32_t PerfTrace_Flush(void)
+{
+    uint32_t flushed = g_perf_trace.count;
+
+    if (g_perf_trace.writer == NULL) {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < flushed; i++) {
+        WriteEvent(&g_perf_trace.events[i]);
+    }
+    g_perf_trace.count = 0;
+    FlushText();
+
+    return flushed;
+}
+
+uint32_t PerfTrace_GetDropped(void)
+{
+    return g_perf_trace.dropped;
+}
+
+bool PerfTrace_IsActive(void)
+{
+    return g_perf_trace.active;
+}
+
+uint32_t PerfTrace_WriteFile(const char *data, uint32_t length, void *context)
+{
+    if (context == NULL) {
+        return 0;
+    }
+    return (uint32_t)fwrite(data, 1, length, (FILE *)context);
+}
+
+uint32_t PerfTrace_SliceBegin(void)
+{
+    return g_perf_trace.active ? Platform_GetTimeUs() : 0U;
+}
+
+void PerfTrace_SliceEnd(PerfTraceKind_t kind, StateMachineState_t state, uint32_t start_us)
+{
+    uint32_t now;
+
+    if (!g_perf_trace.active) {
+        return;
+    }
+
+    now = Platform_GetTimeUs();
+
+    /* Slice began before tracing started - clip it to the trace start */
+    if ((now - start_us) > (now - g_perf_trace.start_us)) {
+        start_us = g_perf_trace.start_us;
+    }
+    Append(kind, state, start_us, now - start_us, EVENT_NONE, state);
+}
+
+void PerfTrace_Transition(StateMachineState_t from, StateMachineState_t to,
+                          StateMachineEvent_t event)
+{
+    uint32_t now;
+
+    if (!g_perf_trace.active) {
+        return;
+    }
+
+    now = Platform_GetTimeUs();
+    Append(PERF_TRACE_STATE_SPAN, from, g_perf_trace.span_start_us,
+           now - g_perf_trace.span_start_us, EVENT_NONE, from);
+    Append(PERF_TRACE_TRANSITION, to, now, 0, event, from);
+
+    g_perf_trace.span_start_us = now;
+    g_perf_trace.span_state = to;
+}
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+static void Append(PerfTraceKind_t kind, StateMachineState_t state, uint32_t ts_us,
+                   uint32_t dur_us, StateMachineEvent_t event, StateMachineState_t from)
+{
+    PerfTraceEvent_t *entry;
+
+    /* Buffer full - drop rather than format JSON inside the tick */
+    if (g_perf_trace.count >= g_perf_trace.capacity) {
+        g_perf_trace.dropped++;
+        return;
+    }
+
+    entry = &g_perf_trace.events[g_perf_trace.count++];
+    entry->ts_us = ts_us;
+    entry->dur_us = dur_us;
+    entry->kind = (uint8_t)kind;
+    entry->state = (uint8_t)state;
+    entry->event = (uint8_t)event;
+    entry->from = (uint8_t)from;
+}
+
+static void WriteEvent(const PerfTraceEvent_t *event)
+{
+    char text[PERF_TRACE_EVENT_TEXT];
+    uint64_t ts = ExtendTimestamp(event);
+    const char *state = StateMachine_StateToString((StateMachineState_t)event->state);
+    int length;
+
+    switch ((PerfTraceKind_t)event->kind) {
+        case PERF_TRACE_STATE_SPAN:
+            length = snprintf(text, sizeof(text),
+                ",\n{\"name\":\"%s\",\"cat\":\"state\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                "\"ts\":%llu,\"dur\":%lu}",
+                state, PERF_TRACE_TID_STATES, (unsigned long long)ts,
+                (unsigned long)event->dur_us);
+            break;
+
+        case PERF_TRACE_TRANSITION:
+            length = snprintf(text, sizeof(text),
+                ",\n{\"name\":\"%s\",\"cat\":\"transition\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,"
+                "\"tid\":%u,\"ts\":%llu,\"args\":{\"from\":\"%s\",\"to\":\"%s\"}}",
+                StateMachine_EventToString((StateMachineEvent_t)event->event),
+                PERF_TRACE_TID_STATES, (unsigned long long)ts,
+                StateMachine_StateToString((StateMachineState_t)event->from), state);
+            break;
+
+        case PERF_TRACE_ON_ENTRY:
+        case PERF_TRACE_ON_STATE:
+        case PERF_TRACE_ON_EXIT:
+            length = snprintf(text, sizeof(text),
+                ",\n{\"name\":\"%s\",\"cat\":\"callback\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                "\"ts\":%llu,\"dur\":%lu,\"args\":{\"state\":\"%s\"}}",
+                g_kind_names[event->kind], PERF_TRACE_TID_CALLBACKS,
+                (unsigned long long)ts, (unsigned long)event->dur_us, state);
+            break;
+
+        default:
+            return;
+    }
+
+    if (length > 0) {
+        WriteText(text, ((uint32_t)length < sizeof(text)) ? (uint32_t)length
+                                                         : (uint32_t)(sizeof(text) - 1U));
+    }
+}
+
+static void WriteText(const char *text, uint32_t length)
+{
+    if ((g_text_length + length) > sizeof(g_text)) {
+        FlushText();
+    }
+    if (length > sizeof(g_text)) {
+        (void)g_perf_trace.writer(text, length, g_perf_trace.context);
+        return;
+    }
+    memcpy(&g_text[g_text_length], text, length);
+    g_text_length += length;
+}
+
+static void FlushText(void)
+{
+    if (g_text_length > 0U && g_perf_trace.writer != NULL) {
+        (void)g_perf_trace.writer(g_text, g_text_length, g_perf_trace.context);
+    }
+    g_text_length = 0;
+}
+
+static uint64_t ExtendTimestamp(const PerfTraceEvent_t *event)
+{
+    /* Events are appended when they end, so end times never go backwards -
+     * extend them with unsigned forward deltas (handles the 32-bit
+     * microsecond wraparound every ~71 minutes and spans of any length up
+     * to that), then derive the start from the duration */
+    uint32_t end_us = event->ts_us + event->dur_us;
+
+    g_perf_trace.last_end_full_us += (uint64_t)(end_us - g_perf_trace.last_end_us);
+    g_perf_trace.last_end_us = end_us;
+
+    if (g_perf_trace.last_end_full_us < event->dur_us) {
+        return 0;
+    }
+    return g_perf_trace.last_end_full_us - event->dur_us;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file sm_snapshot.c
+ * @brief Snapshot serialization helpers
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_snapshot.h"
+
+void Snapshot_PutU8(SnapshotWriter_t *writer, uint8_t value)
+{
+    if (writer->length >= writer->size) {
+        writer->overflow = true;
+        return;
+    }
+    writer->data[writer->length++] = value;
+}
+
+void Snapshot_PutU16(SnapshotWriter_t *writer, uint16_t value)
+{
+    Snapshot_PutU8(writer, (uint8_t)(value & 0xFFU));
+    Snapshot_PutU8(writer, (uint8_t)(value >> 8));
+}
+
+void Snapshot_PutU32(SnapshotWriter_t *writer, uint32_t value)
+{
+    Snapshot_PutU16(writer, (uint16_t)(value & 0xFFFFU));
+    Snapshot_PutU16(writer, (uint16_t)(value >> 16));
+}
+
+uint8_t Snapshot_GetU8(SnapshotReader_t *reader)
+{
+    if (reader->offset >= reader->length) {
+        reader->underflow = true;
+        return 0;
+    }
+    return reader->data[reader->offset++];
+}
+
+uint16_t Snapshot_GetU16(SnapshotReader_t *reader)
+{
+    uint16_t low = Snapshot_GetU8(reader);
+
+    return (uint16_t)(low | (uint16_t)((uint16_t)Snapshot_GetU8(reader) << 8));
+}
+
+uint32_t Snapshot_GetU32(SnapshotReader_t *reader)
+{
+    uint32_t low = Snapshot_GetU16(reader);
+
+    return low | ((uint32_t)Snapshot_GetU16(reader) << 16);
+}
+
+uint32_t Snapshot_Crc32(const uint8_t *data, uint32_t length)
+{
+    /* Reflected polynomial 0xEDB88320, nibble table */
+    static const uint32_t table[16] = {
+        0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+        0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+        0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+        0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+    };
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0FU];
+        crc = (crc >> 4) ^ table[crc & 0x0FU];
+    }
+    return ~crc;
+}
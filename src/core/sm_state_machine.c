@@ -11,6 +11,8 @@
  * - Added thread-safe event posting with critical sections
  */
 
+#define DEBUG_MODULE DEBUG_MODULE_CORE
+
 #include "sm_framework/sm_framework.h"
 #include "sm_framework/sm_platform.h"
 #include <string.h>
@@ -23,7 +25,7 @@
 StateMachineContext_t g_sm_context;
 
 /** State transition table */
-static StateConfig_t g_state_table[SM_MAX_STATES];
+static SM_CACHE_ALIGNED StateConfig_t g_state_table[SM_MAX_STATES];
 
 /** State-specific persistent data (replaces static variables in callbacks) */
 static struct {
@@ -31,9 +33,58 @@ static struct {
     bool comm_started;             /**< Communication started flag */
 } g_state_data;
 
-#if FEATURE_STATISTICS_ENABLED
+/** Resume state of the current state's async action */
+static AsyncContext_t g_async;
+
+/** Incremented on every state entry - identifies the current visit */
+static volatile uint32_t g_state_visit = 0;
+
+/** Event post hook (event recorder) */
+static StateMachinePostHook_t g_post_hook = NULL;
+
+/** Set while StateMachine_Execute() runs (classifies internal posts) */
+static volatile bool g_in_execute = false;
+
+/** Set from on_exit until the new state is current (fast rejection would judge the old state) */
+static volatile bool g_in_transition = false;
+
+/* Statistics hooks: each compiles to nothing below its SM_STATS_LEVEL */
+#if SM_STATS_LEVEL >= 1
 /** Runtime statistics */
 static StateMachineStats_t g_stats;
+
+#define STATS_COUNT(field) (g_stats.field++)
+#else
+#define STATS_COUNT(field) ((void)0)
+#endif
+
+#if SM_STATS_LEVEL >= 2
+/** Post time of each queued event (parallel to event_queue) */
+static uint32_t g_post_time_us[SM_EVENT_QUEUE_SIZE];
+
+/** Post to dispatch latency (us) */
+static Histogram_t g_latency_hist;
+
+/** Time spent per visit of each state (ms) */
+static Histogram_t g_residency_hist[SM_MAX_STATES];
+
+#define STATS_RECORD(histogram, value) Histogram_Record(&(histogram), (value))
+#else
+#define STATS_RECORD(histogram, value) ((void)0)
+#endif
+
+#if FEATURE_STATE_BUDGETS
+/** Execution budget accounting per state */
+static StateBudgetStats_t g_budget_stats[SM_MAX_STATES];
+#endif
+
+#if FEATURE_TRANSITION_MATRIX
+/** Dispatch counters per (state, event) */
+static TransitionMatrixCell_t g_transition_matrix[STATE_MAX][EVENT_MAX];
+
+#define COUNT_DISPATCH(state, event, handled) CountDispatch((state), (event), (handled))
+#else
+#define COUNT_DISPATCH(state, event, handled) ((void)0)
 #endif
 
 /* =============================================================================
@@ -95,8 +146,17 @@ static void State_CriticalError_OnExit(void);
  * ===========================================================================*/
 
 static void InitializeStateTable(void);
-static void PerformStateTransition(StateMachineState_t new_state);
+static void RebuildEventMask(StateMachineState_t state);
+static void PerformStateTransition(StateMachineState_t new_state, StateMachineEvent_t event);
 static bool CheckStateTransition(StateMachineEvent_t event, StateMachineState_t *next_state);
+static bool DequeueEvent(StateMachineEvent_t *event);
+static bool IsAsyncReady(void);
+#if FEATURE_STATE_BUDGETS
+static void CheckBudget(StateMachineState_t state, uint32_t budget_us, uint32_t elapsed_us);
+#endif
+#if FEATURE_TRANSITION_MATRIX
+static void CountDispatch(StateMachineState_t state, StateMachineEvent_t event, bool handled);
+#endif
 
 /* =============================================================================
  * PUBLIC API IMPLEMENTATION
@@ -108,14 +168,22 @@ bool StateMachine_Init(void)
     memset(&g_sm_context, 0, sizeof(StateMachineContext_t));
     memset(&g_state_table, 0, sizeof(g_state_table));
     memset(&g_state_data, 0, sizeof(g_state_data));
+    memset(&g_async, 0, sizeof(g_async));
 
     /* Initialize context */
     g_sm_context.current_state = STATE_INIT;
     g_sm_context.previous_state = STATE_INIT;
-    g_sm_context.pending_event = EVENT_NONE;
+    g_sm_context.queue_head = 0;
+    g_sm_context.queue_count = 0;
     g_sm_context.state_entry_time = Platform_GetTimeMs();
     g_sm_context.state_execution_count = 0;
     g_sm_context.state_changed = false;
+    g_sm_context.critical_lock_active = false;
+    g_state_visit++;
+
+#if FEATURE_TRANSITION_OBSERVERS
+    Observer_Init();
+#endif
 
     /* Initialize error handler */
     if (!ErrorHandler_Init()) {
@@ -124,9 +192,18 @@ bool StateMachine_Init(void)
 
     /* Initialize state transition table */
     InitializeStateTable();
+    g_sm_context.state_timeout_ms = g_state_table[STATE_INIT].timeout_ms;
 
-#if FEATURE_STATISTICS_ENABLED
-    memset(&g_stats, 0, sizeof(g_stats));
+#if SM_STATS_LEVEL >= 1
+    StateMachine_ResetStats();
+#endif
+
+#if FEATURE_STATE_BUDGETS
+    memset(g_budget_stats, 0, sizeof(g_budget_stats));
+#endif
+
+#if FEATURE_TRANSITION_MATRIX
+    StateMachine_ResetTransitionMatrix();
 #endif
 
     DEBUG_INIT("State Machine initialized");
@@ -137,97 +214,183 @@ StateMachineState_t StateMachine_Execute(void)
 {
     StateConfig_t *current_state_config = NULL;
     StateMachineState_t next_state;
+    StateMachineEvent_t event;
+    uint32_t now;
+#if FEATURE_STATE_BUDGETS
+    uint32_t budget_us;
+    uint32_t work_us = 0;
+    uint32_t start_us = 0;
+#endif
+
+    g_sm_context.tick_count++;
 
     /* Check for critical error lock */
-    if (g_sm_context.error_handler.critical_lock_active) {
+    if (g_sm_context.critical_lock_active) {
         if (g_sm_context.current_state != STATE_CRITICAL_ERROR) {
-            PerformStateTransition(STATE_CRITICAL_ERROR);
+            PerformStateTransition(STATE_CRITICAL_ERROR, EVENT_NONE);
         }
         return g_sm_context.current_state;
     }
 
+    g_in_execute = true;
+
     current_state_config = &g_state_table[g_sm_context.current_state];
 
     /* Execute OnEntry callback on state change */
     if (g_sm_context.state_changed) {
         if (current_state_config->on_entry != NULL) {
-            current_state_config->on_entry();
+            PERF_TRACE_SLICE(PERF_TRACE_ON_ENTRY, g_sm_context.current_state,
+                             current_state_config->on_entry());
         }
         g_sm_context.state_changed = false;
-        g_sm_context.state_entry_time = Platform_GetTimeMs();
+        now = Platform_GetTimeMs();
+        STATS_RECORD(g_residency_hist[g_sm_context.previous_state], now - g_sm_context.state_entry_time);
+        g_sm_context.state_entry_time = now;
+        g_sm_context.state_timeout_ms = current_state_config->timeout_ms;
         g_sm_context.state_execution_count = 0;
     }
 
+#if FEATURE_STATE_BUDGETS
+    /* Clock read only for states with a budget */
+    budget_us = current_state_config->budget_us;
+    if (budget_us != 0U) {
+        start_us = Platform_GetTimeUs();
+    }
+#endif
+
     /* Execute OnState callback */
     if (current_state_config->on_state != NULL) {
-        current_state_config->on_state();
+        PERF_TRACE_SLICE(PERF_TRACE_ON_STATE, g_sm_context.current_state,
+                         current_state_config->on_state());
     }
     g_sm_context.state_execution_count++;
 
+#if FEATURE_STATE_BUDGETS
+    if (budget_us != 0U) {
+        work_us = Platform_GetTimeUs() - start_us;
+    }
+#endif
+
     /* Check for state timeout */
-    if (current_state_config->timeout_ms > 0) {
-        if (Platform_IsTimeout(g_sm_context.state_entry_time, current_state_config->timeout_ms)) {
+    if (g_sm_context.state_timeout_ms > 0) {
+        if (Platform_IsTimeout(g_sm_context.state_entry_time, g_sm_context.state_timeout_ms)) {
             DEBUG_WARNING("State %s timeout after %lu ms",
                          StateMachine_StateToString(g_sm_context.current_state),
-                         current_state_config->timeout_ms);
+                         (unsigned long)g_sm_context.state_timeout_ms);
             StateMachine_PostEvent(EVENT_TIMEOUT);
-#if FEATURE_STATISTICS_ENABLED
-            g_stats.total_timeouts++;
-#endif
+            STATS_COUNT(total_timeouts);
+        }
+    }
+
+    /* Process oldest pending event */
+    if (DequeueEvent(&event)) {
+        if (CheckStateTransition(event, &next_state)) {
+            COUNT_DISPATCH(g_sm_context.current_state, event, true);
+            PerformStateTransition(next_state, event);
+            STATS_COUNT(total_transitions);
+            STATS_COUNT(state_entry_counts[next_state]);
+        } else if (g_async.wait == (uint8_t)ASYNC_WAIT_EVENT && g_async.wait_event == (uint8_t)event) {
+            COUNT_DISPATCH(g_sm_context.current_state, event, true);
+            g_async.wait = (uint8_t)ASYNC_WAIT_TICK;
         }
     }
 
-    /* Process pending event */
-    if (g_sm_context.pending_event != EVENT_NONE) {
-        if (CheckStateTransition(g_sm_context.pending_event, &next_state)) {
-            PerformStateTransition(next_state);
-#if FEATURE_STATISTICS_ENABLED
-            g_stats.total_transitions++;
-            g_stats.state_entry_counts[next_state]++;
+    /* Resume the async action when what it awaits has happened (not after a transition) */
+    if (current_state_config->on_async != NULL && !g_sm_context.state_changed && IsAsyncReady()) {
+#if FEATURE_STATE_BUDGETS
+        if (budget_us != 0U) {
+            start_us = Platform_GetTimeUs();
+        }
 #endif
+        if (current_state_config->on_async(&g_async) == ASYNC_DONE) {
+            g_async.wait = (uint8_t)ASYNC_WAIT_DONE;
         }
-        g_sm_context.pending_event = EVENT_NONE;
+#if FEATURE_STATE_BUDGETS
+        if (budget_us != 0U) {
+            work_us += Platform_GetTimeUs() - start_us;
+        }
+#endif
     }
 
+#if FEATURE_STATE_BUDGETS
+    if (budget_us != 0U) {
+        CheckBudget(current_state_config->state_id, budget_us, work_us);
+    }
+#endif
+
+    g_in_execute = false;
     return g_sm_context.current_state;
 }
 
 bool StateMachine_PostEvent(StateMachineEvent_t event)
 {
     bool result = false;
+    bool handled = true;
+#if SM_STATS_LEVEL >= 2
+    uint32_t post_us;
+#endif
 
     /* Validate event */
     if (event >= EVENT_MAX || event == EVENT_NONE) {
         return false;
     }
 
-    /* THREAD-SAFE: Use critical section to protect pending_event */
+#if SM_STATS_LEVEL >= 2
+    /* Outside the critical section: the clock may be a slow call */
+    post_us = Platform_GetTimeUs();
+#endif
+
+    /* THREAD-SAFE: Use critical section to protect the event queue */
     Platform_EnterCritical();
     {
-        if (g_sm_context.pending_event != EVENT_NONE) {
-            /* Event queue full - drop new event */
-#if FEATURE_STATISTICS_ENABLED
-            g_stats.total_events_dropped++;
+#if SM_REJECT_UNHANDLED_EVENTS
+        /* Fast rejection: with an empty queue the current state dispatches it,
+         * unless a transition is under way (posted from on_exit) */
+        handled = g_in_transition || (g_sm_context.queue_count != 0U) ||
+                  (SM_EVENT_MASK_TEST(g_state_table[g_sm_context.current_state].handled_events, event) != 0U) ||
+                  (g_async.wait == (uint8_t)ASYNC_WAIT_EVENT && g_async.wait_event == (uint8_t)event);
 #endif
+        if (!handled) {
+            /* Not handled in current state - do not queue */
+            STATS_COUNT(total_events_ignored);
+            result = false;
+        } else if (g_sm_context.queue_count >= SM_EVENT_QUEUE_SIZE) {
+            /* Event queue full - drop new event */
+            STATS_COUNT(total_events_dropped);
             result = false;
         } else {
             /* Post event */
-            g_sm_context.pending_event = event;
-#if FEATURE_STATISTICS_ENABLED
-            g_stats.total_events_posted++;
+            uint32_t tail = (g_sm_context.queue_head + g_sm_context.queue_count) % SM_EVENT_QUEUE_SIZE;
+
+            g_sm_context.event_queue[tail] = (EventStorage_t)event;
+            g_sm_context.queue_count++;
+            STATS_COUNT(total_events_posted);
+#if SM_STATS_LEVEL >= 2
+            g_post_time_us[tail] = post_us;
 #endif
             result = true;
         }
     }
     Platform_ExitCritical();
 
+    if (g_post_hook != NULL) {
+        g_post_hook(event, (uint8_t)((result ? SM_POST_FLAG_ACCEPTED : 0U) |
+                                     (g_in_execute ? SM_POST_FLAG_INTERNAL : 0U) |
+                                     (ErrorHandler_IsReporting() ? SM_POST_FLAG_ERROR : 0U)));
+    }
+
     return result;
 }
 
+bool StateMachine_IsQueueFull(void)
+{
+    return g_sm_context.queue_count >= SM_EVENT_QUEUE_SIZE;
+}
+
 void StateMachine_Reset(void)
 {
     /* Cannot reset if critical error lock is active */
-    if (g_sm_context.error_handler.critical_lock_active) {
+    if (g_sm_context.critical_lock_active) {
         DEBUG_WARNING("Cannot reset - critical error lock active");
         return;
     }
@@ -239,7 +402,7 @@ void StateMachine_Reset(void)
     memset(&g_state_data, 0, sizeof(g_state_data));
 
     /* Transition to INIT */
-    PerformStateTransition(STATE_INIT);
+    PerformStateTransition(STATE_INIT, EVENT_NONE);
 
     DEBUG_INFO("State Machine reset to INIT");
 }
@@ -254,6 +417,11 @@ StateMachineState_t StateMachine_GetPreviousState(void)
     return g_sm_context.previous_state;
 }
 
+uint32_t StateMachine_GetStateVisit(void)
+{
+    return g_state_visit;
+}
+
 uint32_t StateMachine_GetStateTime(void)
 {
     return Platform_GetTimeMs() - g_sm_context.state_entry_time;
@@ -264,13 +432,65 @@ uint32_t StateMachine_GetExecutionCount(void)
     return g_sm_context.state_execution_count;
 }
 
+uint32_t StateMachine_GetTickCount(void)
+{
+    return g_sm_context.tick_count;
+}
+
+bool StateMachine_IsTickRequired(void)
+{
+    if (g_sm_context.critical_lock_active) {
+        return g_sm_context.current_state != STATE_CRITICAL_ERROR;
+    }
+
+    return (g_sm_context.queue_count != 0U) ||
+           g_sm_context.state_changed ||
+           ((g_state_table[g_sm_context.current_state].flags & SM_STATE_FLAG_TIME_DEPENDENT) != 0U) ||
+           (g_state_table[g_sm_context.current_state].on_async != NULL &&
+            g_async.wait != (uint8_t)ASYNC_WAIT_TIME && IsAsyncReady());
+}
+
+bool StateMachine_GetAsyncWakeTime(uint32_t *wake_ms)
+{
+    if (wake_ms == NULL || g_state_table[g_sm_context.current_state].on_async == NULL ||
+        g_async.wait != (uint8_t)ASYNC_WAIT_TIME) {
+        return false;
+    }
+
+    *wake_ms = g_async.wake_time;
+    return true;
+}
+
+bool StateMachine_GetTimeoutDeadline(uint32_t *deadline_ms)
+{
+    if (deadline_ms == NULL || g_sm_context.state_timeout_ms == 0U) {
+        return false;
+    }
+
+    *deadline_ms = g_sm_context.state_entry_time + g_sm_context.state_timeout_ms;
+    return true;
+}
+
+void StateMachine_SkipTicks(uint32_t ticks)
+{
+    g_sm_context.tick_count += ticks;
+    if (!g_sm_context.critical_lock_active) {
+        g_sm_context.state_execution_count += ticks;
+    }
+
+#if SM_STATS_LEVEL >= 2
+    /* The gap was intended - not a late task call */
+    Cadence_Resync();
+#endif
+}
+
 /* =============================================================================
  * STRING CONVERSION
  * ===========================================================================*/
 
 const char *StateMachine_StateToString(StateMachineState_t state)
 {
-    static const char *state_strings[] = {
+    static const char *const state_strings[] = {
         "INIT",
         "IDLE",
         "ACTIVE",
@@ -291,7 +511,7 @@ const char *StateMachine_StateToString(StateMachineState_t state)
 
 const char *StateMachine_EventToString(StateMachineEvent_t event)
 {
-    static const char *event_strings[] = {
+    static const char *const event_strings[] = {
         "NONE",
         "INIT_COMPLETE",
         "START",
@@ -335,13 +555,23 @@ bool StateMachine_AddTransition(StateMachineState_t state,
         return false;
     }
 
-    config->transitions[config->transition_count].event = event;
-    config->transitions[config->transition_count].next_state = next_state;
+    config->transitions[config->transition_count].event = (EventStorage_t)event;
+    config->transitions[config->transition_count].next_state = (StateStorage_t)next_state;
     config->transition_count++;
+    SM_EVENT_MASK_SET(config->handled_events, event);
 
     return true;
 }
 
+bool StateMachine_IsEventHandled(StateMachineState_t state, StateMachineEvent_t event)
+{
+    if (state >= STATE_MAX || event >= EVENT_MAX) {
+        return false;
+    }
+
+    return SM_EVENT_MASK_TEST(g_state_table[state].handled_events, event) != 0U;
+}
+
 bool StateMachine_SetStateTimeout(StateMachineState_t state, uint32_t timeout_ms)
 {
     if (state >= STATE_MAX) {
@@ -349,6 +579,11 @@ bool StateMachine_SetStateTimeout(StateMachineState_t state, uint32_t timeout_ms
     }
 
     g_state_table[state].timeout_ms = timeout_ms;
+
+    /* Keep the hot copy in sync when changing the active state */
+    if (state == g_sm_context.current_state) {
+        g_sm_context.state_timeout_ms = timeout_ms;
+    }
     return true;
 }
 
@@ -368,7 +603,88 @@ bool StateMachine_SetStateCallbacks(StateMachineState_t state,
     return true;
 }
 
-#if FEATURE_STATISTICS_ENABLED
+bool StateMachine_SetStateAsync(StateMachineState_t state, AsyncAction_t action)
+{
+    if (state >= STATE_MAX) {
+        return false;
+    }
+
+    g_state_table[state].on_async = action;
+
+    /* Start from the beginning when set for the active state */
+    if (state == g_sm_context.current_state) {
+        memset(&g_async, 0, sizeof(g_async));
+    }
+    return true;
+}
+
+bool StateMachine_SetStateFlags(StateMachineState_t state, uint8_t flags)
+{
+    if (state >= STATE_MAX) {
+        return false;
+    }
+
+    g_state_table[state].flags = flags;
+    return true;
+}
+
+#if FEATURE_STATE_BUDGETS
+bool StateMachine_SetStateBudget(StateMachineState_t state, uint32_t budget_us)
+{
+    if (state >= STATE_MAX) {
+        return false;
+    }
+
+    g_state_table[state].budget_us = budget_us;
+    return true;
+}
+
+bool StateMachine_GetBudgetStats(StateMachineState_t state, StateBudgetStats_t *stats)
+{
+    if (state >= STATE_MAX || stats == NULL) {
+        return false;
+    }
+
+    *stats = g_budget_stats[state];
+    stats->budget_us = g_state_table[state].budget_us;
+    return true;
+}
+
+void StateMachine_ResetBudgetStats(void)
+{
+    memset(g_budget_stats, 0, sizeof(g_budget_stats));
+}
+#endif
+
+#if FEATURE_TRANSITION_MATRIX
+bool StateMachine_GetTransitionCell(StateMachineState_t state, StateMachineEvent_t event,
+                                    TransitionMatrixCell_t *cell)
+{
+    if (state >= STATE_MAX || event >= EVENT_MAX || cell == NULL) {
+        return false;
+    }
+
+    *cell = g_transition_matrix[state][event];
+    return true;
+}
+
+void StateMachine_ResetTransitionMatrix(void)
+{
+    memset(g_transition_matrix, 0, sizeof(g_transition_matrix));
+}
+#endif
+
+void StateMachine_SetPostHook(StateMachinePostHook_t hook)
+{
+    g_post_hook = hook;
+}
+
+bool StateMachine_IsExecuting(void)
+{
+    return g_in_execute;
+}
+
+#if SM_STATS_LEVEL >= 1
 bool StateMachine_GetStats(StateMachineStats_t *stats)
 {
     if (stats == NULL) {
@@ -376,15 +692,219 @@ bool StateMachine_GetStats(StateMachineStats_t *stats)
     }
 
     memcpy(stats, &g_stats, sizeof(StateMachineStats_t));
+#if SM_STATS_LEVEL >= 2
+    (void)Cadence_GetStats(&stats->cadence);
+    stats->event_latency_p50_us = Histogram_Percentile(&g_latency_hist, 500U);
+    stats->event_latency_p99_us = Histogram_Percentile(&g_latency_hist, 990U);
+    stats->event_latency_max_us = g_latency_hist.max;
+#endif
     return true;
 }
 
 void StateMachine_ResetStats(void)
 {
     memset(&g_stats, 0, sizeof(g_stats));
+#if SM_STATS_LEVEL >= 2
+    Cadence_Reset();
+    Histogram_Init(&g_latency_hist);
+    for (uint32_t i = 0; i < SM_MAX_STATES; i++) {
+        Histogram_Init(&g_residency_hist[i]);
+    }
+#endif
 }
+
+#if SM_STATS_LEVEL >= 2
+
+bool StateMachine_GetEventLatencyHistogram(Histogram_t *histogram)
+{
+    if (histogram == NULL) {
+        return false;
+    }
+
+    *histogram = g_latency_hist;
+    return true;
+}
+
+bool StateMachine_GetResidencyHistogram(StateMachineState_t state, Histogram_t *histogram)
+{
+    if (state >= STATE_MAX || histogram == NULL) {
+        return false;
+    }
+
+    *histogram = g_residency_hist[state];
+    return true;
+}
+#endif /* SM_STATS_LEVEL >= 2 */
+#endif /* SM_STATS_LEVEL >= 1 */
+
+/* =============================================================================
+ * SNAPSHOT / RESTORE
+ * ===========================================================================*/
+
+uint32_t StateMachine_Snapshot(uint8_t *buffer, uint32_t size)
+{
+    SnapshotWriter_t writer = { buffer, size, SM_SNAPSHOT_HEADER_SIZE, false };
+    uint32_t length;
+    uint32_t now;
+    uint8_t head;
+    uint8_t count;
+
+    if (buffer == NULL || size < SM_SNAPSHOT_HEADER_SIZE) {
+        return 0;
+    }
+
+    now = Platform_GetTimeMs();
+
+    /* Context, time in state relative to now */
+    Snapshot_PutU32(&writer, now);
+    Snapshot_PutU8(&writer, (uint8_t)g_sm_context.current_state);
+    Snapshot_PutU8(&writer, (uint8_t)g_sm_context.previous_state);
+    Snapshot_PutU8(&writer, (uint8_t)((g_sm_context.state_changed ? 0x01U : 0x00U) |
+                                      (g_sm_context.critical_lock_active ? 0x02U : 0x00U)));
+    Snapshot_PutU32(&writer, now - g_sm_context.state_entry_time);
+    Snapshot_PutU32(&writer, g_sm_context.state_timeout_ms);
+    Snapshot_PutU32(&writer, g_sm_context.state_execution_count);
+    Snapshot_PutU32(&writer, g_sm_context.tick_count);
+
+    /* Pending events, oldest first (consistent against ISR posts) */
+    Platform_EnterCritical();
+    head = g_sm_context.queue_head;
+    count = g_sm_context.queue_count;
+    Snapshot_PutU8(&writer, count);
+    for (uint32_t i = 0; i < count; i++) {
+        Snapshot_PutU8(&writer, (uint8_t)g_sm_context.event_queue[(head + i) % SM_EVENT_QUEUE_SIZE]);
+    }
+    Platform_ExitCritical();
+
+    /* State-specific data */
+    Snapshot_PutU32(&writer, g_state_data.init_step_count);
+    Snapshot_PutU8(&writer, (uint8_t)g_state_data.comm_started);
+
+    ErrorHandler_SaveSnapshot(&writer, now);
+    if (writer.overflow) {
+        return 0;
+    }
+
+    /* Header last: length and CRC cover the finished body */
+    length = writer.length;
+    writer.length = 0;
+    Snapshot_PutU32(&writer, SM_SNAPSHOT_MAGIC);
+    Snapshot_PutU8(&writer, SM_SNAPSHOT_VERSION);
+    Snapshot_PutU8(&writer, (uint8_t)STATE_MAX);
+    Snapshot_PutU8(&writer, (uint8_t)EVENT_MAX);
+    Snapshot_PutU8(&writer, (uint8_t)ERROR_CODE_MAX);
+    Snapshot_PutU32(&writer, length);
+    Snapshot_PutU32(&writer, Snapshot_Crc32(&buffer[SM_SNAPSHOT_HEADER_SIZE],
+                                            length - SM_SNAPSHOT_HEADER_SIZE));
+    return length;
+}
+
+bool StateMachine_Restore(const uint8_t *data, uint32_t length)
+{
+    SnapshotReader_t reader = { data, length, 0, false };
+    SnapshotReader_t error_section;
+    uint8_t events[SM_EVENT_QUEUE_SIZE];
+    StateMachineState_t current_state;
+    StateMachineState_t previous_state;
+    uint32_t elapsed;
+    uint32_t timeout_ms;
+    uint32_t execution_count;
+    uint32_t tick_count;
+    uint32_t init_step_count;
+    uint32_t now;
+    uint8_t flags;
+    uint8_t count;
+    bool comm_started;
+#if SM_STATS_LEVEL >= 2
+    uint32_t post_us;
+#endif
+
+    if (data == NULL || length < SM_SNAPSHOT_HEADER_SIZE) {
+        return false;
+    }
+
+    /* Header: format, build compatibility, integrity */
+    if (Snapshot_GetU32(&reader) != SM_SNAPSHOT_MAGIC ||
+        Snapshot_GetU8(&reader) != SM_SNAPSHOT_VERSION ||
+        Snapshot_GetU8(&reader) != (uint8_t)STATE_MAX ||
+        Snapshot_GetU8(&reader) != (uint8_t)EVENT_MAX ||
+        Snapshot_GetU8(&reader) != (uint8_t)ERROR_CODE_MAX ||
+        Snapshot_GetU32(&reader) != length ||
+        Snapshot_GetU32(&reader) != Snapshot_Crc32(&data[SM_SNAPSHOT_HEADER_SIZE],
+                                                   length - SM_SNAPSHOT_HEADER_SIZE)) {
+        DEBUG_WARNING("Snapshot rejected: invalid header or CRC");
+        return false;
+    }
+
+    /* Parse everything before touching any state */
+    (void)Snapshot_GetU32(&reader);  /* Snapshot time (informational) */
+    current_state = (StateMachineState_t)Snapshot_GetU8(&reader);
+    previous_state = (StateMachineState_t)Snapshot_GetU8(&reader);
+    flags = Snapshot_GetU8(&reader);
+    elapsed = Snapshot_GetU32(&reader);
+    timeout_ms = Snapshot_GetU32(&reader);
+    execution_count = Snapshot_GetU32(&reader);
+    tick_count = Snapshot_GetU32(&reader);
+    count = Snapshot_GetU8(&reader);
+    if (current_state >= STATE_MAX || previous_state >= STATE_MAX ||
+        count > SM_EVENT_QUEUE_SIZE) {
+        DEBUG_WARNING("Snapshot rejected: invalid context");
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        events[i] = Snapshot_GetU8(&reader);
+        if (events[i] >= (uint8_t)EVENT_MAX) {
+            DEBUG_WARNING("Snapshot rejected: invalid event");
+            return false;
+        }
+    }
+    init_step_count = Snapshot_GetU32(&reader);
+    comm_started = Snapshot_GetU8(&reader) != 0U;
+
+    now = Platform_GetTimeMs();
+    error_section = reader;
+    if (reader.underflow || !ErrorHandler_LoadSnapshot(&error_section, now, false) ||
+        error_section.offset != length) {
+        DEBUG_WARNING("Snapshot rejected: invalid error handler section");
+        return false;
+    }
+
+#if SM_STATS_LEVEL >= 2
+    /* Restored events count as posted now for the latency histogram */
+    post_us = Platform_GetTimeUs();
 #endif
 
+    /* Apply - no callbacks, the next tick runs on_state of the restored state */
+    Platform_EnterCritical();
+    g_sm_context.current_state = current_state;
+    g_sm_context.previous_state = previous_state;
+    g_sm_context.state_entry_time = now - elapsed;
+    g_sm_context.state_timeout_ms = timeout_ms;
+    g_sm_context.state_execution_count = execution_count;
+    g_sm_context.tick_count = tick_count;
+    g_sm_context.state_changed = (flags & 0x01U) != 0U;
+    g_sm_context.critical_lock_active = (flags & 0x02U) != 0U;
+    g_sm_context.queue_head = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        g_sm_context.event_queue[i] = (EventStorage_t)events[i];
+#if SM_STATS_LEVEL >= 2
+        g_post_time_us[i] = post_us;
+#endif
+    }
+    g_sm_context.queue_count = count;
+    memset(&g_async, 0, sizeof(g_async));  /* Resume point is not stored - restart the action */
+    g_state_visit++;
+    Platform_ExitCritical();
+
+    g_state_data.init_step_count = init_step_count;
+    g_state_data.comm_started = comm_started;
+    (void)ErrorHandler_LoadSnapshot(&reader, now, true);
+
+    DEBUG_INFO("Restored snapshot: state %s, %u pending events",
+               StateMachine_StateToString(current_state), (unsigned int)count);
+    return true;
+}
+
 /* =============================================================================
  * PRIVATE HELPER FUNCTIONS
  * ===========================================================================*/
@@ -407,6 +927,7 @@ static void InitializeStateTable(void)
     g_state_table[STATE_INIT].on_state = State_Init_OnState;
     g_state_table[STATE_INIT].on_exit = State_Init_OnExit;
     g_state_table[STATE_INIT].timeout_ms = SM_STATE_TIMEOUT_MS;
+    g_state_table[STATE_INIT].flags = SM_STATE_FLAG_TIME_DEPENDENT;
     g_state_table[STATE_INIT].transitions[idx++] = (StateTransition_t){EVENT_INIT_COMPLETE, STATE_IDLE};
     g_state_table[STATE_INIT].transitions[idx++] = (StateTransition_t){EVENT_ERROR_NORMAL, STATE_RECOVERY};
     g_state_table[STATE_INIT].transitions[idx++] = (StateTransition_t){EVENT_ERROR_CRITICAL, STATE_CRITICAL_ERROR};
@@ -422,6 +943,7 @@ static void InitializeStateTable(void)
     g_state_table[STATE_IDLE].on_state = State_Idle_OnState;
     g_state_table[STATE_IDLE].on_exit = State_Idle_OnExit;
     g_state_table[STATE_IDLE].timeout_ms = 0;  /* No timeout */
+    g_state_table[STATE_IDLE].flags = 0;  /* Waits for events only */
     g_state_table[STATE_IDLE].transitions[idx++] = (StateTransition_t){EVENT_START, STATE_ACTIVE};
     g_state_table[STATE_IDLE].transitions[idx++] = (StateTransition_t){EVENT_ERROR_NORMAL, STATE_RECOVERY};
     g_state_table[STATE_IDLE].transitions[idx++] = (StateTransition_t){EVENT_ERROR_CRITICAL, STATE_CRITICAL_ERROR};
@@ -437,6 +959,7 @@ static void InitializeStateTable(void)
     g_state_table[STATE_ACTIVE].on_state = State_Active_OnState;
     g_state_table[STATE_ACTIVE].on_exit = State_Active_OnExit;
     g_state_table[STATE_ACTIVE].timeout_ms = 0;  /* No timeout */
+    g_state_table[STATE_ACTIVE].flags = 0;  /* Waits for events only */
     g_state_table[STATE_ACTIVE].transitions[idx++] = (StateTransition_t){EVENT_DATA_READY, STATE_PROCESSING};
     g_state_table[STATE_ACTIVE].transitions[idx++] = (StateTransition_t){EVENT_STOP, STATE_IDLE};
     g_state_table[STATE_ACTIVE].transitions[idx++] = (StateTransition_t){EVENT_ERROR_NORMAL, STATE_RECOVERY};
@@ -453,6 +976,7 @@ static void InitializeStateTable(void)
     g_state_table[STATE_PROCESSING].on_state = State_Processing_OnState;
     g_state_table[STATE_PROCESSING].on_exit = State_Processing_OnExit;
     g_state_table[STATE_PROCESSING].timeout_ms = 3000U;
+    g_state_table[STATE_PROCESSING].flags = SM_STATE_FLAG_TIME_DEPENDENT;
     g_state_table[STATE_PROCESSING].transitions[idx++] = (StateTransition_t){EVENT_PROCESSING_DONE, STATE_COMMUNICATING};
     g_state_table[STATE_PROCESSING].transitions[idx++] = (StateTransition_t){EVENT_TIMEOUT, STATE_RECOVERY};
     g_state_table[STATE_PROCESSING].transitions[idx++] = (StateTransition_t){EVENT_ERROR_NORMAL, STATE_RECOVERY};
@@ -469,6 +993,7 @@ static void InitializeStateTable(void)
     g_state_table[STATE_COMMUNICATING].on_state = State_Communicating_OnState;
     g_state_table[STATE_COMMUNICATING].on_exit = State_Communicating_OnExit;
     g_state_table[STATE_COMMUNICATING].timeout_ms = COMM_TIMEOUT_MS;
+    g_state_table[STATE_COMMUNICATING].flags = SM_STATE_FLAG_TIME_DEPENDENT;
     g_state_table[STATE_COMMUNICATING].transitions[idx++] = (StateTransition_t){EVENT_COMM_COMPLETE, STATE_MONITORING};
     g_state_table[STATE_COMMUNICATING].transitions[idx++] = (StateTransition_t){EVENT_TIMEOUT, STATE_RECOVERY};
     g_state_table[STATE_COMMUNICATING].transitions[idx++] = (StateTransition_t){EVENT_ERROR_NORMAL, STATE_RECOVERY};
@@ -485,6 +1010,7 @@ static void InitializeStateTable(void)
     g_state_table[STATE_MONITORING].on_state = State_Monitoring_OnState;
     g_state_table[STATE_MONITORING].on_exit = State_Monitoring_OnExit;
     g_state_table[STATE_MONITORING].timeout_ms = 0;  /* No timeout */
+    g_state_table[STATE_MONITORING].flags = 0;  /* Waits for events only */
     g_state_table[STATE_MONITORING].transitions[idx++] = (StateTransition_t){EVENT_STOP, STATE_IDLE};
     g_state_table[STATE_MONITORING].transitions[idx++] = (StateTransition_t){EVENT_DATA_READY, STATE_PROCESSING};
     g_state_table[STATE_MONITORING].transitions[idx++] = (StateTransition_t){EVENT_ERROR_NORMAL, STATE_RECOVERY};
@@ -501,6 +1027,7 @@ static void InitializeStateTable(void)
     g_state_table[STATE_CALIBRATING].on_state = State_Calibrating_OnState;
     g_state_table[STATE_CALIBRATING].on_exit = State_Calibrating_OnExit;
     g_state_table[STATE_CALIBRATING].timeout_ms = 5000U;
+    g_state_table[STATE_CALIBRATING].flags = SM_STATE_FLAG_TIME_DEPENDENT;
     g_state_table[STATE_CALIBRATING].transitions[idx++] = (StateTransition_t){EVENT_PROCESSING_DONE, STATE_DIAGNOSTICS};
     g_state_table[STATE_CALIBRATING].transitions[idx++] = (StateTransition_t){EVENT_TIMEOUT, STATE_RECOVERY};
     g_state_table[STATE_CALIBRATING].transitions[idx++] = (StateTransition_t){EVENT_ERROR_NORMAL, STATE_RECOVERY};
@@ -517,6 +1044,7 @@ static void InitializeStateTable(void)
     g_state_table[STATE_DIAGNOSTICS].on_state = State_Diagnostics_OnState;
     g_state_table[STATE_DIAGNOSTICS].on_exit = State_Diagnostics_OnExit;
     g_state_table[STATE_DIAGNOSTICS].timeout_ms = 2000U;
+    g_state_table[STATE_DIAGNOSTICS].flags = SM_STATE_FLAG_TIME_DEPENDENT;
     g_state_table[STATE_DIAGNOSTICS].transitions[idx++] = (StateTransition_t){EVENT_PROCESSING_DONE, STATE_ACTIVE};
     g_state_table[STATE_DIAGNOSTICS].transitions[idx++] = (StateTransition_t){EVENT_TIMEOUT, STATE_RECOVERY};
     g_state_table[STATE_DIAGNOSTICS].transitions[idx++] = (StateTransition_t){EVENT_ERROR_NORMAL, STATE_RECOVERY};
@@ -532,6 +1060,7 @@ static void InitializeStateTable(void)
     g_state_table[STATE_RECOVERY].on_state = State_Recovery_OnState;
     g_state_table[STATE_RECOVERY].on_exit = State_Recovery_OnExit;
     g_state_table[STATE_RECOVERY].timeout_ms = 2000U;
+    g_state_table[STATE_RECOVERY].flags = 0;  /* Attempts run at ErrorHandler_GetNextRecoveryTime() */
     g_state_table[STATE_RECOVERY].transitions[idx++] = (StateTransition_t){EVENT_RECOVERY_SUCCESS, STATE_IDLE};
     g_state_table[STATE_RECOVERY].transitions[idx++] = (StateTransition_t){EVENT_RECOVERY_FAILED, STATE_CRITICAL_ERROR};
     g_state_table[STATE_RECOVERY].transitions[idx++] = (StateTransition_t){EVENT_TIMEOUT, STATE_CRITICAL_ERROR};
@@ -547,10 +1076,30 @@ static void InitializeStateTable(void)
     g_state_table[STATE_CRITICAL_ERROR].on_state = State_CriticalError_OnState;
     g_state_table[STATE_CRITICAL_ERROR].on_exit = State_CriticalError_OnExit;
     g_state_table[STATE_CRITICAL_ERROR].timeout_ms = 0;  /* No timeout */
+    g_state_table[STATE_CRITICAL_ERROR].flags = SM_STATE_FLAG_TIME_DEPENDENT;
     g_state_table[STATE_CRITICAL_ERROR].transition_count = 0;  /* No transitions */
+
+    for (idx = 0; idx < (uint8_t)STATE_MAX; idx++) {
+        g_state_table[idx].budget_us = SM_STATE_BUDGET_US;
+        RebuildEventMask((StateMachineState_t)idx);
+    }
+}
+
+/**
+ * @brief Recompute the handled-event bitset of a state from its transitions
+ */
+static void RebuildEventMask(StateMachineState_t state)
+{
+    StateConfig_t *config = &g_state_table[state];
+    uint8_t i;
+
+    memset(config->handled_events, 0, sizeof(config->handled_events));
+    for (i = 0; i < config->transition_count; i++) {
+        SM_EVENT_MASK_SET(config->handled_events, config->transitions[i].event);
+    }
 }
 
-static void PerformStateTransition(StateMachineState_t new_state)
+static void PerformStateTransition(StateMachineState_t new_state, StateMachineEvent_t event)
 {
     StateConfig_t *current_config;
 
@@ -561,21 +1110,155 @@ static void PerformStateTransition(StateMachineState_t new_state)
     }
 
     /* Execute OnExit callback */
+    g_in_transition = true;
     current_config = &g_state_table[g_sm_context.current_state];
     if (current_config->on_exit != NULL) {
-        current_config->on_exit();
+        PERF_TRACE_SLICE(PERF_TRACE_ON_EXIT, g_sm_context.current_state,
+                         current_config->on_exit());
     }
 
+#if FEATURE_TRANSITION_TRACE
+    TransitionTrace_Record(g_sm_context.current_state, new_state, event,
+                           g_sm_context.state_execution_count);
+#endif
+#if FEATURE_ERROR_PERSIST
+    ErrorPersist_RecordTransition(g_sm_context.current_state, new_state, event,
+                                  g_sm_context.state_execution_count);
+#endif
+#if FEATURE_PERF_TRACE
+    PerfTrace_Transition(g_sm_context.current_state, new_state, event);
+#endif
+
     /* Update state */
     g_sm_context.previous_state = g_sm_context.current_state;
     g_sm_context.current_state = new_state;
     g_sm_context.state_changed = true;
+    memset(&g_async, 0, sizeof(g_async));  /* New visit - async action restarts */
+    g_state_visit++;
+    g_in_transition = false;
+
+#if FEATURE_TRANSITION_OBSERVERS
+    {
+        const ObserverTransition_t transition = {
+            g_sm_context.previous_state, new_state, event, g_sm_context.state_execution_count
+        };
+
+        Observer_Notify(&transition);
+    }
+#endif
 
     DEBUG_RUNTIME("State transition: %s -> %s",
                  StateMachine_StateToString(g_sm_context.previous_state),
                  StateMachine_StateToString(g_sm_context.current_state));
 }
 
+#if FEATURE_STATE_BUDGETS
+/**
+ * @brief Account one measured tick of a state against its budget
+ */
+static void CheckBudget(StateMachineState_t state, uint32_t budget_us, uint32_t elapsed_us)
+{
+    StateBudgetStats_t *stats = &g_budget_stats[state];
+
+    stats->runs++;
+    if (elapsed_us > stats->max_us) {
+        stats->max_us = elapsed_us;
+    }
+    if (elapsed_us <= budget_us) {
+        return;
+    }
+
+    stats->overruns++;
+    stats->last_overrun_us = elapsed_us;
+    DEBUG_RUNTIME("State %s over budget: %lu us (budget %lu us)",
+                  StateMachine_StateToString(state),
+                  (unsigned long)elapsed_us, (unsigned long)budget_us);
+
+    if ((g_state_table[state].flags & SM_STATE_FLAG_BUDGET_MINOR) != 0U) {
+        (void)ErrorHandler_Report(ERROR_LEVEL_MINOR, ERROR_CODE_BUDGET_OVERRUN);
+    }
+}
+#endif
+
+#if FEATURE_TRANSITION_MATRIX
+/**
+ * @brief Count one dispatched event in the transition matrix
+ */
+static void CountDispatch(StateMachineState_t state, StateMachineEvent_t event, bool handled)
+{
+    TransitionMatrixCell_t *cell = &g_transition_matrix[state][event];
+
+    if (cell->hits == 0U && cell->ignored == 0U) {
+        cell->first_tick = g_sm_context.tick_count;
+    }
+    cell->last_tick = g_sm_context.tick_count;
+
+    if (handled) {
+        cell->hits++;
+    } else {
+        cell->ignored++;
+    }
+}
+#endif
+
+/**
+ * @brief Check whether the suspended async action can make progress
+ */
+static bool IsAsyncReady(void)
+{
+    switch ((AsyncWait_t)g_async.wait) {
+        case ASYNC_WAIT_NONE:
+        case ASYNC_WAIT_TICK:
+            return true;
+
+        case ASYNC_WAIT_TIME:
+            return (int32_t)(Platform_GetTimeMs() - g_async.wake_time) >= 0;
+
+        case ASYNC_WAIT_IO:
+            return (g_async.io_done == NULL) || *g_async.io_done;
+
+        case ASYNC_WAIT_EVENT:
+        case ASYNC_WAIT_DONE:
+        default:
+            return false;
+    }
+}
+
+static bool DequeueEvent(StateMachineEvent_t *event)
+{
+    bool result = false;
+#if SM_STATS_LEVEL >= 2
+    uint32_t post_us = 0;
+#endif
+
+    /* Lock-free fast path: nothing pending (common case) */
+    if (g_sm_context.queue_count == 0U) {
+        return false;
+    }
+
+    Platform_EnterCritical();
+    {
+        if (g_sm_context.queue_count != 0U) {
+            *event = (StateMachineEvent_t)g_sm_context.event_queue[g_sm_context.queue_head];
+#if SM_STATS_LEVEL >= 2
+            post_us = g_post_time_us[g_sm_context.queue_head];
+#endif
+            g_sm_context.queue_head = (uint8_t)((g_sm_context.queue_head + 1U) % SM_EVENT_QUEUE_SIZE);
+            g_sm_context.queue_count--;
+            result = true;
+        }
+    }
+    Platform_ExitCritical();
+
+#if SM_STATS_LEVEL >= 2
+    if (result) {
+        Histogram_Record(&g_latency_hist, Platform_GetTimeUs() - post_us);
+    }
+#endif
+
+    return result;
+}
+
 static bool CheckStateTransition(StateMachineEvent_t event, StateMachineState_t *next_state)
 {
     StateConfig_t *current_config;
@@ -587,18 +1270,28 @@ static bool CheckStateTransition(StateMachineEvent_t event, StateMachineState_t
 
     current_config = &g_state_table[g_sm_context.current_state];
 
-    /* Search transition table for matching event */
-    for (i = 0; i < current_config->transition_count; i++) {
-        if (current_config->transitions[i].event == event) {
-            *next_state = current_config->transitions[i].next_state;
-            DEBUG_RUNTIME("Event %s triggers transition %s -> %s",
-                         StateMachine_EventToString(event),
-                         StateMachine_StateToString(g_sm_context.current_state),
-                         StateMachine_StateToString(*next_state));
-            return true;
+    /* Most events are not handled in the current state - skip the scan in one AND */
+    if (SM_EVENT_MASK_TEST(current_config->handled_events, event) != 0U) {
+        /* Search transition table for matching event */
+        for (i = 0; i < current_config->transition_count; i++) {
+            if (current_config->transitions[i].event == event) {
+                *next_state = (StateMachineState_t)current_config->transitions[i].next_state;
+                DEBUG_RUNTIME("Event %s triggers transition %s -> %s",
+                             StateMachine_EventToString(event),
+                             StateMachine_StateToString(g_sm_context.current_state),
+                             StateMachine_StateToString(*next_state));
+                return true;
+            }
         }
     }
 
+    /* Awaited by the async action - consumed, not ignored */
+    if (g_async.wait == (uint8_t)ASYNC_WAIT_EVENT && g_async.wait_event == (uint8_t)event) {
+        return false;
+    }
+
+    STATS_COUNT(total_events_ignored);
+    COUNT_DISPATCH(g_sm_context.current_state, event, false);
     DEBUG_WARNING("No transition for event %s in state %s",
                  StateMachine_EventToString(event),
                  StateMachine_StateToString(g_sm_context.current_state));
@@ -797,13 +1490,11 @@ static void State_Recovery_OnState(void)
         DEBUG_INFO("Recovery successful");
         ErrorHandler_ClearError();
         StateMachine_PostEvent(EVENT_RECOVERY_SUCCESS);
-    } else {
+    } else if (ErrorHandler_IsRecoveryExhausted()) {
         if (ErrorHandler_GetCurrentError(&error_info)) {
-            if (error_info.retry_count >= ERROR_MAX_RECOVERY_ATTEMPTS) {
-                DEBUG_ERROR("Recovery failed after %d attempts", error_info.retry_count);
-                StateMachine_PostEvent(EVENT_RECOVERY_FAILED);
-            }
+            DEBUG_ERROR("Recovery failed after %d attempts", error_info.retry_count);
         }
+        StateMachine_PostEvent(EVENT_RECOVERY_FAILED);
     }
 }
 
@@ -0,0 +1,133 @@
+/**
+ * @file sm_trace.c
+ * @brief Binary transition trace ring implementation
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_trace.h"
+#include "sm_framework/sm_platform.h"
+#include <string.h>
+
+/* Active ring (NULL when not tracing) */
+static TransitionTraceHeader_t *g_trace_header = NULL;
+static TransitionRecord_t *g_trace_records = NULL;
+static uint32_t g_trace_mask = 0;
+
+bool TransitionTrace_Init(void *memory, uint32_t size)
+{
+    TransitionTraceHeader_t *header = (TransitionTraceHeader_t *)memory;
+    uint32_t available;
+    uint32_t capacity = 1;
+
+    if (memory == NULL || size < (sizeof(TransitionTraceHeader_t) + sizeof(TransitionRecord_t))) {
+        return false;
+    }
+
+    /* Largest power of two that fits */
+    available = (uint32_t)((size - sizeof(TransitionTraceHeader_t)) / sizeof(TransitionRecord_t));
+    while ((capacity << 1) != 0U && (capacity << 1) <= available) {
+        capacity <<= 1;
+    }
+
+    g_trace_header = NULL;  /* Stop recording while reformatting */
+
+    memset(header, 0, sizeof(TransitionTraceHeader_t));
+    memset(header + 1, 0, capacity * sizeof(TransitionRecord_t));
+    header->magic = TRANSITION_TRACE_MAGIC;
+    header->version = TRANSITION_TRACE_VERSION;
+    header->record_size = (uint16_t)sizeof(TransitionRecord_t);
+    header->capacity = capacity;
+
+    g_trace_records = (TransitionRecord_t *)(void *)(header + 1);
+    g_trace_mask = capacity - 1U;
+    g_trace_header = header;
+    return true;
+}
+
+void TransitionTrace_Stop(void)
+{
+    g_trace_header = NULL;
+}
+
+bool TransitionTrace_IsActive(void)
+{
+    return g_trace_header != NULL;
+}
+
+void TransitionTrace_Record(StateMachineState_t from, StateMachineState_t to,
+                            StateMachineEvent_t event, uint32_t exec_count)
+{
+    TransitionTraceHeader_t *header = g_trace_header;
+    TransitionRecord_t *record;
+    uint32_t seq;
+
+    if (header == NULL) {
+        return;
+    }
+
+    /* Single writer (the state machine task) - no read-modify-write needed */
+    seq = header->write_count;
+    record = &g_trace_records[seq & g_trace_mask];
+    record->seq = seq;
+    record->timestamp = Platform_GetTimeMs();
+    record->exec_count = exec_count;
+    record->from = (uint8_t)from;
+    record->to = (uint8_t)to;
+    record->event = (uint8_t)event;
+    record->reserved = 0;
+
+    /* Publish after the record is complete */
+    SM_ATOMIC_STORE(&header->write_count, seq + 1U);
+}
+
+uint32_t TransitionTrace_Read(uint32_t since_seq, TransitionRecord_t *records,
+                              uint32_t max_records, uint32_t *next_seq)
+{
+    TransitionTraceHeader_t *header = g_trace_header;
+    uint32_t end;
+    uint32_t oldest;
+    uint32_t count;
+    uint32_t copied = 0;
+
+    if (header == NULL || records == NULL) {
+        return 0;
+    }
+
+    /* Wrap-safe: before the ring fills up oldest is "negative" */
+    end = SM_ATOMIC_LOAD(&header->write_count);
+    oldest = end - header->capacity;
+    if ((int32_t)(since_seq - oldest) < 0) {
+        since_seq = oldest;
+    }
+
+    count = end - since_seq;
+    if ((int32_t)count < 0) {
+        count = 0;  /* since_seq is in the future */
+    }
+    if (count > max_records) {
+        count = max_records;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        records[i] = g_trace_records[(since_seq + i) & g_trace_mask];
+    }
+
+    /*
+     * Drop records the writer overwrote while we were copying. While seq
+     * `end` is being written (not yet published) it overwrites the slot of
+     * `end - capacity`, so only records after that one are intact.
+     */
+    SM_ATOMIC_FENCE();
+    end = SM_ATOMIC_LOAD(&header->write_count);
+    oldest = end - header->capacity;
+    for (uint32_t i = 0; i < count; i++) {
+        if ((int32_t)(records[i].seq - oldest) > 0 && records[i].seq == (since_seq + i)) {
+            records[copied++] = records[i];
+        }
+    }
+
+    if (next_seq != NULL) {
+        *next_seq = since_seq + count;
+    }
+    return copied;
+}
@@ -8,18 +8,42 @@
  */
 
 #include "sm_framework/sm_platform.h"
+#if FEATURE_SIMULATION
+#include "sm_framework/sm_sim.h"
+#endif
 #include <stdio.h>
 #include <time.h>
 
 /* ============================= TIMING ================================= */
 
+#if FEATURE_SIMULATION
 SM_WEAK uint32_t Platform_GetTimeMs(void)
 {
-    /* Default: simulation time (increment on each call) */
-    static uint32_t sim_time = 0;
-    return sim_time++;
+    /* Default: virtual simulation clock (+1 ms per call unless made
+     * deterministic with SimClock_SetAutoIncrement(0)) */
+    return SimClock_Read();
 }
 
+SM_WEAK uint32_t Platform_GetTimeUs(void)
+{
+    /* Default: virtual simulation clock, without advancing it */
+    return SimClock_Now() * 1000U;
+}
+#else
+/* Placeholder time base (increment on each call) - override for the target */
+static uint32_t g_placeholder_time_ms = 0;
+
+SM_WEAK uint32_t Platform_GetTimeMs(void)
+{
+    return g_placeholder_time_ms++;
+}
+
+SM_WEAK uint32_t Platform_GetTimeUs(void)
+{
+    return g_placeholder_time_ms * 1000U;
+}
+#endif
+
 bool Platform_IsTimeout(uint32_t start_time_ms, uint32_t timeout_ms)
 {
     uint32_t current_time = Platform_GetTimeMs();
@@ -0,0 +1,71 @@
+/**
+ * @file sm_error_persist_mmap.c
+ * @brief Memory-mapped file backend of the persistent error log (Linux/POSIX)
+ * @version 2.0.0
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sm_framework/sm_error_persist.h"
+#include <fcntl.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Current mapping (NULL when none) */
+static void *g_persist_map = NULL;
+static size_t g_persist_map_size = 0;
+
+bool ErrorPersist_MapFile(const char *path, uint32_t error_capacity,
+                          uint32_t transition_capacity)
+{
+    struct stat info;
+    uint64_t size;
+    void *map;
+    int fd;
+
+    if (path == NULL || error_capacity == 0U || transition_capacity == 0U) {
+        return false;
+    }
+
+    ErrorPersist_UnmapFile();
+
+    size = ERROR_PERSIST_SIZE((uint64_t)error_capacity, (uint64_t)transition_capacity);
+    if (size > UINT32_MAX) {
+        return false;
+    }
+
+    /* Keep an existing log - it is what we want to recover */
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (fstat(fd, &info) != 0 ||
+        ((uint64_t)info.st_size != size && ftruncate(fd, (off_t)size) != 0)) {
+        close(fd);
+        return false;
+    }
+
+    map = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  /* The mapping keeps the file referenced */
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    g_persist_map = map;
+    g_persist_map_size = (size_t)size;
+    return ErrorPersist_Attach(map, (uint32_t)size, error_capacity, transition_capacity);
+}
+
+void ErrorPersist_UnmapFile(void)
+{
+    if (g_persist_map == NULL) {
+        return;
+    }
+
+    ErrorPersist_Detach();
+    munmap(g_persist_map, g_persist_map_size);
+    g_persist_map = NULL;
+    g_persist_map_size = 0;
+}
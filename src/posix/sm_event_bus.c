@@ -0,0 +1,449 @@
+/**
+ * @file sm_event_bus.c
+ * @brief Shared-memory event bus between state machine processes (Linux/POSIX)
+ * @version 2.0.0
+ */
+
+#define _GNU_SOURCE  /* memfd_create() */
+
+#include "sm_framework/sm_event_bus.h"
+#include "sm_framework/sm_state_machine.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RING_MASK (EVENT_BUS_RING_SIZE - 1U)
+
+/* Longest poll() in EventBus_Wait(): long for anonymous buses, where every
+ * poster shares the eventfds; 1 ms for named buses, where processes that
+ * used EventBus_Open() post without waking anyone */
+#define WAIT_SLICE_MS        (1000U)
+#define WAIT_SLICE_NAMED_MS  (1U)
+
+/* Current mapping (NULL when none) */
+static EventBusHeader_t *g_bus = NULL;
+static size_t g_bus_size = 0;
+static char g_bus_name[64];                             /**< Named bus created here ("" if none) */
+static pid_t g_bus_creator = 0;                         /**< Process that removes the named bus */
+static int g_wake_fds[EVENT_BUS_MAX_INSTANCES];         /**< -1 when not available */
+static uint8_t g_instance = EVENT_BUS_NO_INSTANCE;
+static EventBusStats_t g_bus_stats;                     /**< Process-local counters */
+
+/* Forward declarations */
+static bool MapBus(int fd, uint32_t instances, bool format);
+static EventBusMailbox_t *Mailbox(uint32_t instance);
+static bool MailboxEmpty(const EventBusMailbox_t *mailbox);
+static bool PeekSlot(const EventBusMailbox_t *mailbox, StateMachineEvent_t *event, uint8_t *source);
+static void ConsumeSlot(EventBusMailbox_t *mailbox);
+static void Wake(uint32_t instance);
+static uint64_t MonotonicMs(void);
+
+bool EventBus_Create(const char *name, uint8_t instances)
+{
+    int fd;
+
+    if (instances == 0U || instances > EVENT_BUS_MAX_INSTANCES ||
+        (name != NULL && strlen(name) >= sizeof(g_bus_name))) {
+        return false;
+    }
+
+    EventBus_Close();
+
+    if (name == NULL) {
+        fd = memfd_create("sm_event_bus", 0);
+    } else {
+        fd = shm_open(name, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    }
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, (off_t)EVENT_BUS_SIZE((size_t)instances)) != 0 ||
+        !MapBus(fd, instances, true)) {
+        close(fd);
+        if (name != NULL) {
+            shm_unlink(name);
+        }
+        return false;
+    }
+    close(fd);  /* The mapping keeps the memory referenced */
+
+    /* Wakeup eventfds, inherited across fork() */
+    for (uint32_t i = 0; i < instances; i++) {
+        g_wake_fds[i] = eventfd(0, EFD_NONBLOCK);
+        if (g_wake_fds[i] < 0) {
+            EventBus_Close();
+            return false;
+        }
+    }
+
+    if (name != NULL) {
+        strcpy(g_bus_name, name);
+        g_bus_creator = getpid();
+    }
+    return true;
+}
+
+bool EventBus_Open(const char *name)
+{
+    struct stat info;
+    int fd;
+
+    if (name == NULL) {
+        return false;
+    }
+
+    EventBus_Close();
+
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(EventBusHeader_t) ||
+        !MapBus(fd, 0, false)) {
+        close(fd);
+        return false;
+    }
+    close(fd);
+    return true;
+}
+
+bool EventBus_Attach(uint8_t instance)
+{
+    EventBusMailbox_t *mailbox = Mailbox(instance);
+
+    if (mailbox == NULL) {
+        return false;
+    }
+
+    g_instance = instance;
+    memset(&g_bus_stats, 0, sizeof(g_bus_stats));
+    SM_ATOMIC_STORE(&mailbox->owner_pid, (uint32_t)getpid());
+    return true;
+}
+
+void EventBus_Close(void)
+{
+    EventBusMailbox_t *mailbox = Mailbox(g_instance);
+
+    if (mailbox != NULL && SM_ATOMIC_LOAD(&mailbox->owner_pid) == (uint32_t)getpid()) {
+        SM_ATOMIC_STORE(&mailbox->owner_pid, 0U);
+    }
+    g_instance = EVENT_BUS_NO_INSTANCE;
+
+    for (uint32_t i = 0; i < EVENT_BUS_MAX_INSTANCES; i++) {
+        if (g_bus != NULL && g_wake_fds[i] >= 0) {
+            close(g_wake_fds[i]);
+        }
+        g_wake_fds[i] = -1;
+    }
+
+    if (g_bus != NULL) {
+        munmap(g_bus, g_bus_size);
+        g_bus = NULL;
+        g_bus_size = 0;
+    }
+    /* Forked children inherit the name but must not remove the bus */
+    if (g_bus_name[0] != '\0') {
+        if (g_bus_creator == getpid()) {
+            shm_unlink(g_bus_name);
+        }
+        g_bus_name[0] = '\0';
+    }
+}
+
+uint8_t EventBus_GetInstance(void)
+{
+    return g_instance;
+}
+
+bool EventBus_Post(uint8_t instance, StateMachineEvent_t event)
+{
+    EventBusMailbox_t *mailbox = Mailbox(instance);
+    EventBusSlot_t *slot;
+    uint32_t pos;
+
+    if (mailbox == NULL || event == EVENT_NONE || event >= EVENT_MAX) {
+        g_bus_stats.post_failures++;
+        return false;
+    }
+
+    /* Claim a position: the slot is free when its seq equals the position */
+    pos = SM_ATOMIC_LOAD(&mailbox->tail);
+    for (;;) {
+        int32_t diff;
+
+        slot = &mailbox->slots[pos & RING_MASK];
+        diff = (int32_t)(SM_ATOMIC_LOAD(&slot->seq) - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&mailbox->tail, &pos, pos + 1U, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* Still holds an unread event from a full lap ago */
+            __atomic_add_fetch(&mailbox->rejected, 1U, __ATOMIC_RELAXED);
+            g_bus_stats.post_failures++;
+            return false;
+        } else {
+            pos = SM_ATOMIC_LOAD(&mailbox->tail);
+        }
+    }
+
+    slot->event = (uint8_t)event;
+    slot->source = g_instance;
+    slot->reserved = 0;
+    SM_ATOMIC_STORE(&slot->seq, pos + 1U);  /* Publish */
+    g_bus_stats.posted++;
+
+    /* Pairs with the fence in EventBus_Wait(): either it sees the event or we see it waiting */
+    SM_ATOMIC_FENCE();
+    if (SM_ATOMIC_LOAD(&mailbox->waiting) != 0U) {
+        Wake(instance);
+    }
+    return true;
+}
+
+bool EventBus_Receive(StateMachineEvent_t *event, uint8_t *source)
+{
+    EventBusMailbox_t *mailbox = Mailbox(g_instance);
+
+    if (mailbox == NULL || event == NULL) {
+        return false;
+    }
+    if (!PeekSlot(mailbox, event, source)) {
+        return false;
+    }
+
+    ConsumeSlot(mailbox);
+    return true;
+}
+
+uint32_t EventBus_Poll(void)
+{
+    EventBusMailbox_t *mailbox;
+    StateMachineEvent_t event;
+    uint32_t count = 0;
+
+    /* No bus: one load */
+    if (g_bus == NULL) {
+        return 0;
+    }
+
+    mailbox = Mailbox(g_instance);
+    if (mailbox == NULL) {
+        return 0;
+    }
+
+    while (PeekSlot(mailbox, &event, NULL)) {
+        if (StateMachine_PostEvent(event)) {
+            g_bus_stats.delivered++;
+        } else if (StateMachine_IsQueueFull()) {
+            /* Leave it (and the rest) in the mailbox for the next poll */
+            break;
+        } else {
+            /* Refused by the state machine (SM_REJECT_UNHANDLED_EVENTS) */
+            g_bus_stats.dropped++;
+        }
+        ConsumeSlot(mailbox);
+        count++;
+    }
+    return count;
+}
+
+bool EventBus_HasPending(void)
+{
+    EventBusMailbox_t *mailbox = Mailbox(g_instance);
+
+    return mailbox != NULL && !MailboxEmpty(mailbox);
+}
+
+bool EventBus_Wait(uint32_t timeout_ms)
+{
+    EventBusMailbox_t *mailbox = Mailbox(g_instance);
+    uint64_t deadline;
+    uint64_t now;
+    uint64_t slice;
+    int fd;
+    bool ready;
+
+    if (mailbox == NULL) {
+        return false;
+    }
+    if (!MailboxEmpty(mailbox) || timeout_ms == 0U) {
+        return !MailboxEmpty(mailbox);
+    }
+
+    fd = g_wake_fds[g_instance];
+    slice = (g_bus_name[0] != '\0') ? WAIT_SLICE_NAMED_MS : WAIT_SLICE_MS;
+    SM_ATOMIC_STORE(&mailbox->waiting, 1U);
+    SM_ATOMIC_FENCE();
+
+    now = MonotonicMs();
+    deadline = now + timeout_ms;
+    while (MailboxEmpty(mailbox) && now < deadline) {
+        if (fd >= 0) {
+            struct pollfd pfd = { fd, POLLIN, 0 };
+            uint64_t value;
+
+            if (poll(&pfd, 1, (int)(((deadline - now) < slice) ? (deadline - now) : slice)) > 0) {
+                (void)read(fd, &value, sizeof(value));  /* Reset the counter */
+            }
+        } else {
+            /* No eventfd in this process: check the ring every millisecond */
+            struct timespec delay = { 0, 1000000L };
+
+            nanosleep(&delay, NULL);
+        }
+        now = MonotonicMs();
+    }
+
+    SM_ATOMIC_STORE(&mailbox->waiting, 0U);
+    ready = !MailboxEmpty(mailbox);
+    if (ready) {
+        g_bus_stats.wakeups++;
+    }
+    return ready;
+}
+
+bool EventBus_GetStats(EventBusStats_t *stats)
+{
+    EventBusMailbox_t *mailbox = Mailbox(g_instance);
+
+    if (stats == NULL || mailbox == NULL) {
+        return false;
+    }
+
+    *stats = g_bus_stats;
+    stats->rejected = SM_ATOMIC_LOAD(&mailbox->rejected);
+    return true;
+}
+
+bool StateMachine_PostEventTo(uint8_t instance, StateMachineEvent_t event)
+{
+    if (instance != EVENT_BUS_NO_INSTANCE && instance == g_instance) {
+        return StateMachine_PostEvent(event);
+    }
+    return EventBus_Post(instance, event);
+}
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+static bool MapBus(int fd, uint32_t instances, bool format)
+{
+    EventBusHeader_t *header;
+    size_t size = EVENT_BUS_SIZE((size_t)((instances != 0U) ? instances : 1U));
+    void *map;
+
+    /* Opening: map the header first to learn the geometry */
+    if (!format) {
+        map = mmap(NULL, sizeof(EventBusHeader_t), PROT_READ, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        header = (EventBusHeader_t *)map;
+        instances = header->instances;
+        if (header->magic != EVENT_BUS_MAGIC || header->version != EVENT_BUS_VERSION ||
+            header->mailbox_size != sizeof(EventBusMailbox_t) ||
+            header->ring_size != EVENT_BUS_RING_SIZE ||
+            instances == 0U || instances > EVENT_BUS_MAX_INSTANCES) {
+            munmap(map, sizeof(EventBusHeader_t));
+            return false;
+        }
+        munmap(map, sizeof(EventBusHeader_t));
+        size = EVENT_BUS_SIZE((size_t)instances);
+    }
+
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    header = (EventBusHeader_t *)map;
+
+    if (format) {
+        memset(map, 0, size);
+        for (uint32_t i = 0; i < instances; i++) {
+            EventBusMailbox_t *mailbox = (EventBusMailbox_t *)(void *)(header + 1) + i;
+
+            for (uint32_t slot = 0; slot < EVENT_BUS_RING_SIZE; slot++) {
+                mailbox->slots[slot].seq = slot;
+            }
+        }
+        header->version = EVENT_BUS_VERSION;
+        header->mailbox_size = (uint16_t)sizeof(EventBusMailbox_t);
+        header->instances = instances;
+        header->ring_size = EVENT_BUS_RING_SIZE;
+        SM_ATOMIC_STORE(&header->magic, EVENT_BUS_MAGIC);  /* Valid from here on */
+    }
+
+    g_bus = header;
+    g_bus_size = size;
+    return true;
+}
+
+static EventBusMailbox_t *Mailbox(uint32_t instance)
+{
+    if (g_bus == NULL || instance >= g_bus->instances) {
+        return NULL;
+    }
+    return (EventBusMailbox_t *)(void *)(g_bus + 1) + instance;
+}
+
+static bool MailboxEmpty(const EventBusMailbox_t *mailbox)
+{
+    uint32_t head = mailbox->head;
+
+    return SM_ATOMIC_LOAD(&mailbox->slots[head & RING_MASK].seq) != (head + 1U);
+}
+
+static bool PeekSlot(const EventBusMailbox_t *mailbox, StateMachineEvent_t *event, uint8_t *source)
+{
+    /* Single consumer: only this process moves head */
+    uint32_t head = mailbox->head;
+    const EventBusSlot_t *slot = &mailbox->slots[head & RING_MASK];
+
+    if (SM_ATOMIC_LOAD(&slot->seq) != (head + 1U)) {
+        return false;
+    }
+
+    *event = (StateMachineEvent_t)slot->event;
+    if (source != NULL) {
+        *source = slot->source;
+    }
+    return true;
+}
+
+static void ConsumeSlot(EventBusMailbox_t *mailbox)
+{
+    uint32_t head = mailbox->head;
+
+    /* Hand the slot back to producers for the next lap */
+    SM_ATOMIC_STORE(&mailbox->slots[head & RING_MASK].seq, head + EVENT_BUS_RING_SIZE);
+    SM_ATOMIC_STORE(&mailbox->head, head + 1U);
+    mailbox->received++;
+    g_bus_stats.received++;
+}
+
+static void Wake(uint32_t instance)
+{
+    uint64_t one = 1;
+
+    if (g_wake_fds[instance] >= 0) {
+        (void)write(g_wake_fds[instance], &one, sizeof(one));
+    }
+}
+
+static uint64_t MonotonicMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000U) + ((uint64_t)ts.tv_nsec / 1000000U);
+}
@@ -0,0 +1,399 @@
+/**
+ * @file sm_metrics_server.c
+ * @brief Local metrics endpoint: OpenMetrics over HTTP (TCP or Unix socket)
+ * @version 2.0.0
+ */
+
+#define _GNU_SOURCE  /* accept4() */
+
+#include "sm_framework/sm_metrics_server.h"
+#include "sm_framework/sm_metrics.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REQUEST_SIZE   (1024U)   /**< Request line and headers kept */
+#define HEADER_SIZE    (256U)    /**< Response header */
+
+/**
+ * @brief Scrape connection life cycle
+ */
+typedef enum {
+    CONN_FREE = 0,     /**< Slot unused */
+    CONN_READING,      /**< Receiving the request */
+    CONN_WAITING,      /**< Request complete, render buffer in use by another scrape */
+    CONN_SENDING       /**< Sending the response */
+} ConnState_t;
+
+/**
+ * @brief Scrape connection - nonblocking, advanced a little on every poll
+ */
+typedef struct {
+    int fd;                          /**< Accepted socket */
+    uint8_t state;                   /**< ConnState_t */
+    uint32_t request_length;         /**< Bytes in request */
+    uint64_t deadline_ms;            /**< Closed if not answered by then */
+    const char *out;                 /**< Response bytes not sent yet */
+    size_t out_length;               /**< Length of out */
+    char request[REQUEST_SIZE];      /**< Request, then an error response */
+} MetricsConn_t;
+
+static int g_listen_fd = -1;
+static uint16_t g_port = 0;
+static char g_unix_path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+static const char *g_labels = NULL;
+static MetricsConn_t g_conns[METRICS_SERVER_MAX_PER_POLL];
+
+/* Response, built in place: header slot, then the rendered text */
+static char g_response[HEADER_SIZE + METRICS_SERVER_BUFFER_SIZE];
+static MetricsConn_t *g_response_owner = NULL;   /**< Connection sending g_response */
+
+/* Forward declarations */
+static bool Listen(int fd, const struct sockaddr *address, socklen_t length);
+static void AcceptPending(uint64_t now);
+static bool ReadRequest(MetricsConn_t *conn);
+static void Answer(MetricsConn_t *conn);
+static void Respond(MetricsConn_t *conn, const char *status, const char *body, uint32_t body_length);
+static bool SendPending(MetricsConn_t *conn);
+static void CloseConn(MetricsConn_t *conn);
+static uint32_t FormatHeader(char *header, const char *status, uint32_t body_length, const char *type);
+static uint64_t MonotonicMs(void);
+
+bool MetricsServer_OpenTcp(uint16_t port)
+{
+    struct sockaddr_in address;
+    socklen_t length = sizeof(address);
+    int fd;
+    int reuse = 1;
+
+    MetricsServer_Close();
+
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    (void)setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (!Listen(fd, (const struct sockaddr *)&address, sizeof(address))) {
+        return false;
+    }
+
+    if (getsockname(fd, (struct sockaddr *)&address, &length) == 0) {
+        g_port = ntohs(address.sin_port);
+    }
+    g_listen_fd = fd;
+    return true;
+}
+
+bool MetricsServer_OpenUnix(const char *path)
+{
+    struct sockaddr_un address;
+    struct stat info;
+    int fd;
+
+    if (path == NULL || strlen(path) >= sizeof(address.sun_path)) {
+        return false;
+    }
+
+    MetricsServer_Close();
+
+    /* Replace a socket left by a previous run, never anything else */
+    if (lstat(path, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode) || unlink(path) != 0) {
+            return false;
+        }
+    }
+
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    if (!Listen(fd, (const struct sockaddr *)&address, sizeof(address))) {
+        return false;
+    }
+
+    strcpy(g_unix_path, path);
+    g_listen_fd = fd;
+    return true;
+}
+
+void MetricsServer_Close(void)
+{
+    for (uint32_t i = 0; i < METRICS_SERVER_MAX_PER_POLL; i++) {
+        CloseConn(&g_conns[i]);
+    }
+    if (g_listen_fd >= 0) {
+        close(g_listen_fd);
+        g_listen_fd = -1;
+    }
+    if (g_unix_path[0] != '\0') {
+        (void)unlink(g_unix_path);
+        g_unix_path[0] = '\0';
+    }
+    g_port = 0;
+}
+
+void MetricsServer_SetLabels(const char *labels)
+{
+    g_labels = labels;
+}
+
+uint32_t MetricsServer_Poll(void)
+{
+    uint32_t served = 0;
+    uint64_t now;
+
+    if (g_listen_fd < 0) {
+        return 0;
+    }
+
+    now = MonotonicMs();
+    AcceptPending(now);
+
+    /* Advance every connection as far as it goes without blocking */
+    for (uint32_t i = 0; i < METRICS_SERVER_MAX_PER_POLL; i++) {
+        MetricsConn_t *conn = &g_conns[i];
+
+        if (conn->state == (uint8_t)CONN_FREE) {
+            continue;
+        }
+        if (now >= conn->deadline_ms) {
+            CloseConn(conn);  /* Too slow - give up on it */
+            continue;
+        }
+        if (conn->state == (uint8_t)CONN_READING && ReadRequest(conn)) {
+            conn->state = (uint8_t)CONN_WAITING;
+        }
+        if (conn->state == (uint8_t)CONN_WAITING) {
+            Answer(conn);
+        }
+        if (conn->state == (uint8_t)CONN_SENDING && SendPending(conn)) {
+            if (conn->out_length == 0U) {
+                served++;
+            }
+            CloseConn(conn);
+        }
+    }
+    return served;
+}
+
+uint16_t MetricsServer_GetPort(void)
+{
+    return g_port;
+}
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+static bool Listen(int fd, const struct sockaddr *address, socklen_t length)
+{
+    if (bind(fd, address, length) != 0 || listen(fd, (int)METRICS_SERVER_MAX_PER_POLL) != 0) {
+        close(fd);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Accept new connections into free slots (nonblocking sockets)
+ */
+static void AcceptPending(uint64_t now)
+{
+    for (uint32_t i = 0; i < METRICS_SERVER_MAX_PER_POLL; i++) {
+        MetricsConn_t *conn = &g_conns[i];
+        int fd;
+
+        if (conn->state != (uint8_t)CONN_FREE) {
+            continue;
+        }
+        fd = accept4(g_listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;  /* EAGAIN: nothing pending */
+        }
+        conn->fd = fd;
+        conn->state = (uint8_t)CONN_READING;
+        conn->request_length = 0;
+        conn->request[0] = '\0';
+        conn->deadline_ms = now + METRICS_SERVER_TIMEOUT_MS;
+        conn->out = NULL;
+        conn->out_length = 0;
+    }
+}
+
+/**
+ * @brief Read what has arrived
+ * @return true once the request headers are complete (or cannot be)
+ */
+static bool ReadRequest(MetricsConn_t *conn)
+{
+    char *request = conn->request;
+    const uint32_t size = sizeof(conn->request);
+
+    while (conn->request_length < (size - 1U)) {
+        ssize_t received = recv(conn->fd, &request[conn->request_length],
+                                size - 1U - conn->request_length, 0);
+
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return false;  /* Rest arrives on a later poll */
+        }
+        if (received <= 0) {
+            return true;   /* Closed or failed - answer what we have */
+        }
+        conn->request_length += (uint32_t)received;
+        request[conn->request_length] = '\0';
+        if (strstr(request, "\r\n\r\n") != NULL || strstr(request, "\n\n") != NULL) {
+            return true;
+        }
+    }
+    return true;  /* Headers cut off by the buffer: the request line is all we need */
+}
+
+/**
+ * @brief Build the response for a complete request
+ *
+ * Leaves the connection waiting while another scrape is sending g_response.
+ */
+static void Answer(MetricsConn_t *conn)
+{
+    const char *request = conn->request;
+    char header[HEADER_SIZE];
+    char *body = &g_response[HEADER_SIZE];
+    uint32_t body_length;
+    uint32_t header_length;
+    bool complete = strstr(request, "\r\n\r\n") != NULL || strstr(request, "\n\n") != NULL ||
+                    (conn->request_length == (sizeof(conn->request) - 1U) &&
+                     strchr(request, '\n') != NULL);
+
+    if (!complete) {
+        Respond(conn, "400 Bad Request", "bad request\n", 12U);
+        return;
+    }
+    if (strncmp(request, "GET ", 4) != 0) {
+        Respond(conn, "405 Method Not Allowed", "GET only\n", 9U);
+        return;
+    }
+    if (strncmp(&request[4], "/ ", 2) != 0 && strncmp(&request[4], "/metrics", 8) != 0) {
+        Respond(conn, "404 Not Found", "try /metrics\n", 13U);
+        return;
+    }
+    if (g_response_owner != NULL) {
+        return;  /* Render buffer busy - retry on the next poll */
+    }
+
+    body_length = Metrics_Render(body, METRICS_SERVER_BUFFER_SIZE, g_labels);
+    if (body_length == 0U) {
+        Respond(conn, "500 Internal Server Error", "METRICS_SERVER_BUFFER_SIZE too small\n", 37U);
+        return;
+    }
+
+    /* Header right-aligned in front of the body: one buffer for both */
+    header_length = FormatHeader(header, "200 OK", body_length, METRICS_CONTENT_TYPE);
+    memcpy(body - header_length, header, header_length);
+    g_response_owner = conn;
+    conn->out = body - header_length;
+    conn->out_length = (size_t)header_length + body_length;
+    conn->state = (uint8_t)CONN_SENDING;
+}
+
+/**
+ * @brief Queue a short error response (built in the connection's own buffer)
+ */
+static void Respond(MetricsConn_t *conn, const char *status, const char *body, uint32_t body_length)
+{
+    uint32_t header_length = FormatHeader(conn->request, status, body_length,
+                                          "text/plain; charset=utf-8");
+
+    memcpy(&conn->request[header_length], body, body_length);
+    conn->out = conn->request;
+    conn->out_length = (size_t)header_length + body_length;
+    conn->state = (uint8_t)CONN_SENDING;
+}
+
+/**
+ * @brief Send what the socket takes without blocking
+ * @return true when done (all sent, or the client is gone)
+ */
+static bool SendPending(MetricsConn_t *conn)
+{
+    while (conn->out_length > 0U) {
+        ssize_t sent = send(conn->fd, conn->out, conn->out_length, MSG_NOSIGNAL);
+
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return false;  /* Socket buffer full - continue on a later poll */
+        }
+        if (sent <= 0) {
+            return true;   /* Client gone */
+        }
+        conn->out += sent;
+        conn->out_length -= (size_t)sent;
+    }
+    return true;
+}
+
+static void CloseConn(MetricsConn_t *conn)
+{
+    if (conn->state == (uint8_t)CONN_FREE) {
+        return;
+    }
+    if (g_response_owner == conn) {
+        g_response_owner = NULL;
+    }
+    close(conn->fd);
+    conn->fd = -1;
+    conn->state = (uint8_t)CONN_FREE;
+}
+
+/**
+ * @brief HTTP/1.0 response header
+ * @return Header length
+ */
+static uint32_t FormatHeader(char *header, const char *status, uint32_t body_length, const char *type)
+{
+    char digits[10];
+    uint32_t count = 0;
+    uint32_t length;
+
+    do {
+        digits[count++] = (char)('0' + (char)(body_length % 10U));
+        body_length /= 10U;
+    } while (body_length != 0U);
+
+    strcpy(header, "HTTP/1.0 ");
+    strcat(header, status);
+    strcat(header, "\r\nContent-Type: ");
+    strcat(header, type);
+    strcat(header, "\r\nConnection: close\r\nContent-Length: ");
+    length = (uint32_t)strlen(header);
+    while (count > 0U) {
+        header[length++] = digits[--count];
+    }
+    header[length] = '\0';
+    strcat(header, "\r\n\r\n");
+    return length + 4U;
+}
+
+static uint64_t MonotonicMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000U) + ((uint64_t)ts.tv_nsec / 1000000U);
+}
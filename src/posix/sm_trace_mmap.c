@@ -0,0 +1,66 @@
+/**
+ * @file sm_trace_mmap.c
+ * @brief Memory-mapped file export of the transition trace (Linux/POSIX)
+ * @version 2.0.0
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sm_framework/sm_trace.h"
+#include <fcntl.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* Current mapping (NULL when none) */
+static void *g_trace_map = NULL;
+static size_t g_trace_map_size = 0;
+
+bool TransitionTrace_MapFile(const char *path, uint32_t capacity)
+{
+    size_t size;
+    void *map;
+    int fd;
+
+    if (path == NULL || capacity == 0U) {
+        return false;
+    }
+
+    TransitionTrace_UnmapFile();
+
+    size = sizeof(TransitionTraceHeader_t) + ((size_t)capacity * sizeof(TransitionRecord_t));
+    if (size > UINT32_MAX) {
+        return false;
+    }
+
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return false;
+    }
+
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  /* The mapping keeps the file referenced */
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    g_trace_map = map;
+    g_trace_map_size = size;
+    return TransitionTrace_Init(map, (uint32_t)size);
+}
+
+void TransitionTrace_UnmapFile(void)
+{
+    if (g_trace_map == NULL) {
+        return;
+    }
+
+    TransitionTrace_Stop();
+    munmap(g_trace_map, g_trace_map_size);
+    g_trace_map = NULL;
+    g_trace_map_size = 0;
+}
@@ -0,0 +1,343 @@
+/**
+ * @file sm_worker_pool.c
+ * @brief Worker thread pool for long-running state work (POSIX)
+ * @version 2.0.0
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sm_framework/sm_worker_pool.h"
+#include "sm_framework/sm_state_machine.h"
+#include "sm_framework/sm_error_handler.h"
+#include <pthread.h>
+#include <string.h>
+
+/**
+ * @brief Job slot life cycle
+ */
+typedef enum {
+    JOB_FREE = 0,      /**< Slot unused */
+    JOB_QUEUED,        /**< Waiting for a worker */
+    JOB_RUNNING,       /**< Running on a worker */
+    JOB_DONE           /**< Finished, waiting for WorkerPool_Poll() */
+} JobState_t;
+
+/**
+ * @brief Job slot
+ */
+typedef struct {
+    WorkerJob_t job;           /**< Job function */
+    void *arg;                 /**< Job argument */
+    uint32_t id;               /**< Job ID (submission order) */
+    ErrorCode_t result;        /**< Job return value (JOB_DONE) */
+    uint32_t visit;            /**< State visit that submitted the job */
+    uint8_t state;             /**< JobState_t */
+    uint8_t done_event;        /**< Posted on success */
+    uint8_t fail_level;        /**< Reported on failure */
+    bool cancelled;            /**< Result is discarded */
+} JobSlot_t;
+
+/* Pool state - slots and counters are protected by g_lock */
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_work = PTHREAD_COND_INITIALIZER;
+static pthread_t g_threads[WORKER_POOL_THREADS];
+static uint32_t g_thread_count = 0;
+static bool g_stopping = false;
+static JobSlot_t g_jobs[WORKER_POOL_QUEUE_SIZE];
+static uint32_t g_next_id = 1;
+static uint32_t g_pending = 0;                  /**< Slots not free */
+static volatile uint32_t g_done_count = 0;      /**< Slots in JOB_DONE (read lock-free by Poll) */
+static WorkerPoolStats_t g_pool_stats;
+
+/* Forward declarations */
+static void *WorkerThread(void *unused);
+static JobSlot_t *OldestQueued(void);
+static JobSlot_t *FindJob(uint32_t job_id);
+
+bool WorkerPool_Init(void)
+{
+    if (g_thread_count > 0U) {
+        return true;
+    }
+
+    pthread_mutex_lock(&g_lock);
+    memset(g_jobs, 0, sizeof(g_jobs));
+    memset(&g_pool_stats, 0, sizeof(g_pool_stats));
+    g_pending = 0;
+    SM_ATOMIC_STORE(&g_done_count, 0U);
+    g_stopping = false;
+    pthread_mutex_unlock(&g_lock);
+
+    for (uint32_t i = 0; i < WORKER_POOL_THREADS; i++) {
+        if (pthread_create(&g_threads[i], NULL, WorkerThread, NULL) != 0) {
+            WorkerPool_Shutdown();
+            return false;
+        }
+        g_thread_count++;
+    }
+    return true;
+}
+
+void WorkerPool_Shutdown(void)
+{
+    pthread_mutex_lock(&g_lock);
+    g_stopping = true;
+    pthread_cond_broadcast(&g_work);
+    pthread_mutex_unlock(&g_lock);
+
+    for (uint32_t i = 0; i < g_thread_count; i++) {
+        pthread_join(g_threads[i], NULL);
+    }
+    g_thread_count = 0;
+
+    pthread_mutex_lock(&g_lock);
+    memset(g_jobs, 0, sizeof(g_jobs));
+    g_pending = 0;
+    SM_ATOMIC_STORE(&g_done_count, 0U);
+    pthread_mutex_unlock(&g_lock);
+}
+
+uint32_t WorkerPool_Submit(WorkerJob_t job, void *arg)
+{
+    return WorkerPool_SubmitEx(job, arg, EVENT_PROCESSING_DONE, ERROR_LEVEL_NORMAL);
+}
+
+uint32_t WorkerPool_SubmitEx(WorkerJob_t job, void *arg, StateMachineEvent_t done_event,
+                             ErrorLevel_t fail_level)
+{
+    uint32_t job_id = WORKER_JOB_INVALID;
+
+    if (job == NULL || done_event >= EVENT_MAX || fail_level >= ERROR_LEVEL_MAX) {
+        return WORKER_JOB_INVALID;
+    }
+
+    pthread_mutex_lock(&g_lock);
+    if (g_thread_count > 0U && !g_stopping) {
+        for (uint32_t i = 0; i < WORKER_POOL_QUEUE_SIZE; i++) {
+            JobSlot_t *slot = &g_jobs[i];
+
+            if (slot->state != (uint8_t)JOB_FREE) {
+                continue;
+            }
+
+            job_id = g_next_id++;
+            if (g_next_id == WORKER_JOB_INVALID) {
+                g_next_id = 1;
+            }
+
+            slot->job = job;
+            slot->arg = arg;
+            slot->id = job_id;
+            slot->result = ERROR_CODE_NONE;
+            slot->visit = StateMachine_GetStateVisit();
+            slot->done_event = (uint8_t)done_event;
+            slot->fail_level = (uint8_t)fail_level;
+            slot->cancelled = false;
+            slot->state = (uint8_t)JOB_QUEUED;
+
+            g_pending++;
+            if (g_pending > g_pool_stats.max_pending) {
+                g_pool_stats.max_pending = g_pending;
+            }
+            g_pool_stats.submitted++;
+            pthread_cond_signal(&g_work);
+            break;
+        }
+    }
+    if (job_id == WORKER_JOB_INVALID) {
+        g_pool_stats.rejected++;
+    }
+    pthread_mutex_unlock(&g_lock);
+
+    return job_id;
+}
+
+bool WorkerPool_Cancel(uint32_t job_id)
+{
+    JobSlot_t *slot;
+    bool found = false;
+
+    pthread_mutex_lock(&g_lock);
+    slot = FindJob(job_id);
+    if (slot != NULL) {
+        found = true;
+        if (slot->state == (uint8_t)JOB_RUNNING) {
+            slot->cancelled = true;     /* Discarded when it finishes */
+        } else {
+            if (slot->state == (uint8_t)JOB_DONE) {
+                SM_ATOMIC_STORE(&g_done_count, g_done_count - 1U);
+            }
+            slot->state = (uint8_t)JOB_FREE;
+            g_pending--;
+            g_pool_stats.discarded++;
+        }
+    }
+    pthread_mutex_unlock(&g_lock);
+
+    return found;
+}
+
+uint32_t WorkerPool_Poll(void)
+{
+    JobSlot_t done[WORKER_POOL_QUEUE_SIZE];
+    uint8_t index[WORKER_POOL_QUEUE_SIZE];
+    bool retry[WORKER_POOL_QUEUE_SIZE];
+    uint32_t count = 0;
+    uint32_t succeeded = 0;
+    uint32_t failed = 0;
+    uint32_t discarded = 0;
+
+    /* Common case: nothing finished since the last tick */
+    if (SM_ATOMIC_LOAD(&g_done_count) == 0U) {
+        return 0;
+    }
+
+    /* Copy the results under the lock, deliver them without it */
+    pthread_mutex_lock(&g_lock);
+    for (uint32_t i = 0; i < WORKER_POOL_QUEUE_SIZE; i++) {
+        if (g_jobs[i].state == (uint8_t)JOB_DONE) {
+            done[count] = g_jobs[i];
+            index[count++] = (uint8_t)i;
+        }
+    }
+    pthread_mutex_unlock(&g_lock);
+
+    for (uint32_t i = 0; i < count; i++) {
+        const JobSlot_t *slot = &done[i];
+
+        retry[i] = false;
+
+        /* Stale result: the visit that asked for it is over */
+        if (slot->cancelled || slot->visit != StateMachine_GetStateVisit()) {
+            discarded++;
+            continue;
+        }
+
+        if (slot->result == ERROR_CODE_NONE) {
+            if (slot->done_event != (uint8_t)EVENT_NONE &&
+                !StateMachine_PostEvent((StateMachineEvent_t)slot->done_event)) {
+                if (StateMachine_IsQueueFull()) {
+                    retry[i] = true;  /* Keep it in JOB_DONE for the next poll */
+                } else {
+                    discarded++;      /* Refused by the state machine */
+                }
+                continue;
+            }
+            succeeded++;
+        } else {
+            (void)ErrorHandler_Report((ErrorLevel_t)slot->fail_level, slot->result);
+            failed++;
+        }
+    }
+
+    /* Free the delivered slots (unless cancelled meanwhile) */
+    pthread_mutex_lock(&g_lock);
+    for (uint32_t i = 0; i < count; i++) {
+        JobSlot_t *slot = &g_jobs[index[i]];
+
+        if (!retry[i] && slot->state == (uint8_t)JOB_DONE && slot->id == done[i].id) {
+            slot->state = (uint8_t)JOB_FREE;
+            g_pending--;
+            SM_ATOMIC_STORE(&g_done_count, g_done_count - 1U);
+        }
+    }
+    g_pool_stats.succeeded += succeeded;
+    g_pool_stats.failed += failed;
+    g_pool_stats.discarded += discarded;
+    pthread_mutex_unlock(&g_lock);
+
+    return succeeded + failed;
+}
+
+bool WorkerPool_HasCompletions(void)
+{
+    return SM_ATOMIC_LOAD(&g_done_count) != 0U;
+}
+
+bool WorkerPool_GetStats(WorkerPoolStats_t *stats)
+{
+    if (stats == NULL) {
+        return false;
+    }
+
+    pthread_mutex_lock(&g_lock);
+    *stats = g_pool_stats;
+    pthread_mutex_unlock(&g_lock);
+    return true;
+}
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+static void *WorkerThread(void *unused)
+{
+    (void)unused;
+
+    pthread_mutex_lock(&g_lock);
+    for (;;) {
+        JobSlot_t *slot;
+        WorkerJob_t job;
+        void *arg;
+        ErrorCode_t result;
+
+        while (!g_stopping && (slot = OldestQueued()) == NULL) {
+            pthread_cond_wait(&g_work, &g_lock);
+        }
+        if (g_stopping) {
+            break;
+        }
+
+        slot->state = (uint8_t)JOB_RUNNING;
+        job = slot->job;
+        arg = slot->arg;
+        pthread_mutex_unlock(&g_lock);
+
+        result = job(arg);
+
+        pthread_mutex_lock(&g_lock);
+        if (slot->cancelled) {
+            slot->state = (uint8_t)JOB_FREE;
+            g_pending--;
+            g_pool_stats.discarded++;
+        } else {
+            slot->result = result;
+            slot->state = (uint8_t)JOB_DONE;
+            SM_ATOMIC_STORE(&g_done_count, g_done_count + 1U);
+        }
+    }
+    pthread_mutex_unlock(&g_lock);
+
+    return NULL;
+}
+
+/* Called with g_lock held - FIFO by job ID */
+static JobSlot_t *OldestQueued(void)
+{
+    JobSlot_t *oldest = NULL;
+
+    for (uint32_t i = 0; i < WORKER_POOL_QUEUE_SIZE; i++) {
+        JobSlot_t *slot = &g_jobs[i];
+
+        if (slot->state == (uint8_t)JOB_QUEUED &&
+            (oldest == NULL || (int32_t)(slot->id - oldest->id) < 0)) {
+            oldest = slot;
+        }
+    }
+    return oldest;
+}
+
+/* Called with g_lock held */
+static JobSlot_t *FindJob(uint32_t job_id)
+{
+    if (job_id == WORKER_JOB_INVALID) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < WORKER_POOL_QUEUE_SIZE; i++) {
+        if (g_jobs[i].state != (uint8_t)JOB_FREE && g_jobs[i].id == job_id) {
+            return &g_jobs[i];
+        }
+    }
+    return NULL;
+}
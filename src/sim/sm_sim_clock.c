@@ -0,0 +1,46 @@
+/**
+ * @file sm_sim_clock.c
+ * @brief Deterministic virtual clock for simulation
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_sim.h"
+
+/* Virtual clock state */
+static volatile uint32_t g_sim_now_ms = 0;
+static uint32_t g_sim_step_ms = 1U;  /* Classic behavior: +1 ms per read */
+
+void SimClock_Reset(uint32_t start_ms)
+{
+    g_sim_now_ms = start_ms;
+}
+
+uint32_t SimClock_Now(void)
+{
+    return g_sim_now_ms;
+}
+
+uint32_t SimClock_Read(void)
+{
+    uint32_t now = g_sim_now_ms;
+    g_sim_now_ms = now + g_sim_step_ms;
+    return now;
+}
+
+void SimClock_AdvanceBy(uint32_t delta_ms)
+{
+    g_sim_now_ms += delta_ms;
+}
+
+void SimClock_AdvanceTo(uint32_t time_ms)
+{
+    /* Wraparound-safe "is in the future" check */
+    if ((int32_t)(time_ms - g_sim_now_ms) > 0) {
+        g_sim_now_ms = time_ms;
+    }
+}
+
+void SimClock_SetAutoIncrement(uint32_t step_ms)
+{
+    g_sim_step_ms = step_ms;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file sm_sim_driver.c
+ * @brief Fast-forward simulation driver
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_framework.h"
+#include "sm_framework/sm_sim.h"
+#include <string.h>
+
+/* Forward declarations */
+static void EarliestDeadline(uint32_t now, uint32_t candidate, bool *found, uint32_t *earliest);
+
+uint32_t SimDriver_SkippableTicks(uint32_t max_ticks)
+{
+    uint32_t now = SimClock_Now();
+    uint32_t deadline;
+    uint32_t earliest = 0;
+    bool found = false;
+    uint32_t ticks;
+
+    if (max_ticks == 0U || StateMachine_IsTickRequired() || ErrorHandler_HasPendingSuppressed()) {
+        return 0;
+    }
+#if FEATURE_WORKER_POOL
+    if (WorkerPool_HasCompletions()) {
+        return 0;
+    }
+#endif
+#if FEATURE_EVENT_BUS
+    if (EventBus_HasPending()) {
+        return 0;
+    }
+#endif
+
+    if (StateMachine_GetTimeoutDeadline(&deadline)) {
+        EarliestDeadline(now, deadline, &found, &earliest);
+    }
+    if (StateMachine_GetAsyncWakeTime(&deadline)) {
+        EarliestDeadline(now, deadline, &found, &earliest);
+    }
+    if (Debug_GetNextPeriodicTime(&deadline)) {
+        EarliestDeadline(now, deadline, &found, &earliest);
+    }
+    if (StateMachine_GetCurrentState() == STATE_RECOVERY &&
+        ErrorHandler_GetNextRecoveryTime(&deadline)) {
+        EarliestDeadline(now, deadline, &found, &earliest);
+    }
+
+    if (!found) {
+        return max_ticks;
+    }
+
+    /* Deadline already due - the next tick handles it */
+    if ((int32_t)(earliest - now) <= 0) {
+        return 0;
+    }
+
+    /* Skip up to (and including) the last tick before the deadline */
+    ticks = ((earliest - now) + SM_TASK_PERIOD_MS - 1U) / SM_TASK_PERIOD_MS;
+    return (ticks < max_ticks) ? ticks : max_ticks;
+}
+
+void SimDriver_RunUntil(uint32_t end_time_ms, SimDriverStats_t *stats)
+{
+    SimDriverStats_t summary;
+
+    memset(&summary, 0, sizeof(summary));
+    SimClock_SetAutoIncrement(0);
+
+    while ((int32_t)(end_time_ms - SimClock_Now()) > 0) {
+        uint32_t remaining = ((end_time_ms - SimClock_Now()) + SM_TASK_PERIOD_MS - 1U) /
+                             SM_TASK_PERIOD_MS;
+        uint32_t skip = SimDriver_SkippableTicks(remaining);
+
+        if (skip > 0U) {
+            StateMachine_SkipTicks(skip);
+            SimClock_AdvanceBy(skip * SM_TASK_PERIOD_MS);
+            summary.ticks_skipped += skip;
+        } else {
+            App_Main_Task();
+            SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+            summary.ticks_executed++;
+        }
+    }
+
+    summary.end_time = SimClock_Now();
+    if (stats != NULL) {
+        stats->ticks_executed += summary.ticks_executed;
+        stats->ticks_skipped += summary.ticks_skipped;
+        stats->end_time = summary.end_time;
+    }
+}
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+static void EarliestDeadline(uint32_t now, uint32_t candidate, bool *found, uint32_t *earliest)
+{
+    /* Compare relative to now so clock wraparound is handled */
+    if (!*found || (int32_t)(candidate - now) < (int32_t)(*earliest - now)) {
+        *earliest = candidate;
+        *found = true;
+    }
+}
@@ -0,0 +1,359 @@
+/**
+ * @file sm_sim_trace.c
+ * @brief Event trace recorder and replayer
+ * @version 2.0.0
+ */
+
+#include "sm_framework/sm_framework.h"
+#include "sm_framework/sm_platform.h"
+#include "sm_framework/sm_sim.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_VERSION (2U)
+
+/* Active recording (NULL when not recording) */
+static SimTrace_t *g_recording = NULL;
+
+/* Internal posts observed during replay */
+static uint32_t g_replay_internal_posts = 0;
+
+/* Skip idle ticks during replay */
+static bool g_fast_forward = false;
+
+/* Forward declarations */
+static void RecordHook(StateMachineEvent_t event, uint8_t flags);
+static void RecordReportHook(ErrorLevel_t level, ErrorCode_t code);
+static void ReplayHook(StateMachineEvent_t event, uint8_t flags);
+static bool AppendRecord(SimTrace_t *trace, uint32_t tick, uint32_t time_ms,
+                         uint8_t event, uint8_t flags, uint8_t level);
+static uint32_t WriteVarint(uint8_t *out, uint32_t value);
+static bool ReadVarint(const SimTrace_t *trace, uint32_t *pos, uint32_t *value);
+static void PutU32(uint8_t *out, uint32_t value);
+static uint32_t GetU32(const uint8_t *in);
+
+bool SimTrace_StartRecording(SimTrace_t *trace, uint8_t *buffer, uint32_t capacity)
+{
+    if (trace == NULL || buffer == NULL || capacity < SIM_TRACE_HEADER_SIZE) {
+        return false;
+    }
+
+    memset(trace, 0, sizeof(SimTrace_t));
+    trace->buffer = buffer;
+    trace->capacity = capacity;
+    trace->last_tick = StateMachine_GetTickCount();
+    trace->last_time = SimClock_Now();
+
+    /* Header */
+    memcpy(buffer, "SMTR", 4);
+    buffer[4] = TRACE_VERSION;
+    buffer[5] = 0;
+    buffer[6] = 0;
+    buffer[7] = 0;
+    PutU32(&buffer[8], trace->last_tick);
+    PutU32(&buffer[12], trace->last_time);
+    trace->length = SIM_TRACE_HEADER_SIZE;
+
+    g_recording = trace;
+    StateMachine_SetPostHook(RecordHook);
+    ErrorHandler_SetReportHook(RecordReportHook);
+    return true;
+}
+
+void SimTrace_StopRecording(void)
+{
+    SimTrace_t *trace = g_recording;
+
+    if (trace == NULL) {
+        return;
+    }
+
+    StateMachine_SetPostHook(NULL);
+    ErrorHandler_SetReportHook(NULL);
+    g_recording = NULL;
+
+    if (!AppendRecord(trace, StateMachine_GetTickCount(), SimClock_Now(),
+                      (uint8_t)EVENT_NONE, (uint8_t)SIM_TRACE_FLAG_END, 0U)) {
+        trace->overflow = true;
+    }
+}
+
+bool SimTrace_Attach(SimTrace_t *trace, uint8_t *buffer, uint32_t length)
+{
+    if (trace == NULL || buffer == NULL || length < SIM_TRACE_HEADER_SIZE) {
+        return false;
+    }
+    if (memcmp(buffer, "SMTR", 4) != 0 || buffer[4] != TRACE_VERSION) {
+        return false;
+    }
+
+    memset(trace, 0, sizeof(SimTrace_t));
+    trace->buffer = buffer;
+    trace->capacity = length;
+    trace->length = length;
+    trace->last_tick = GetU32(&buffer[8]);
+    trace->last_time = GetU32(&buffer[12]);
+    return true;
+}
+
+bool SimTrace_Replay(const SimTrace_t *trace, SimReplayResult_t *result)
+{
+    SimReplayResult_t summary;
+    uint32_t pos = SIM_TRACE_HEADER_SIZE;
+    uint32_t start_tick;
+    uint32_t tick;
+    uint32_t time_ms;
+    bool ended = false;
+
+    if (trace == NULL || trace->buffer == NULL || trace->length < SIM_TRACE_HEADER_SIZE) {
+        return false;
+    }
+
+    memset(&summary, 0, sizeof(summary));
+    start_tick = GetU32(&trace->buffer[8]);
+    tick = start_tick;
+    time_ms = GetU32(&trace->buffer[12]);
+
+    /* Fresh machine on a deterministic clock */
+    SimClock_SetAutoIncrement(0);
+    SimClock_Reset(time_ms);
+    if (!StateMachine_Init()) {
+        return false;
+    }
+    g_replay_internal_posts = 0;
+    StateMachine_SetPostHook(ReplayHook);
+
+    while (!ended && pos < trace->length) {
+        uint32_t delta_tick;
+        uint32_t delta_time;
+        uint8_t event;
+        uint8_t flags;
+        uint8_t level = 0;
+
+        if (!ReadVarint(trace, &pos, &delta_tick) ||
+            !ReadVarint(trace, &pos, &delta_time) ||
+            (pos + 2U) > trace->length) {
+            StateMachine_SetPostHook(NULL);
+            return false;
+        }
+        event = trace->buffer[pos++];
+        flags = trace->buffer[pos++];
+        if ((flags & SIM_TRACE_FLAG_REPORT) != 0U) {
+            if (pos >= trace->length) {
+                StateMachine_SetPostHook(NULL);
+                return false;
+            }
+            level = trace->buffer[pos++];
+        }
+        tick += delta_tick;
+        time_ms += delta_time;
+
+        /* Run the recorded number of ticks, one task period apart */
+        while ((int32_t)(tick - start_tick - summary.ticks) > 0) {
+            uint32_t skip = 0;
+
+            if (g_fast_forward) {
+                skip = SimDriver_SkippableTicks(tick - start_tick - summary.ticks);
+            }
+            if (skip > 0U) {
+                StateMachine_SkipTicks(skip);
+                SimClock_AdvanceBy(skip * SM_TASK_PERIOD_MS);
+                summary.ticks += skip;
+                summary.ticks_skipped += skip;
+            } else {
+                StateMachine_Execute();
+                summary.ticks++;
+                SimClock_AdvanceBy(SM_TASK_PERIOD_MS);
+            }
+        }
+
+        if ((flags & (SIM_TRACE_FLAG_INTERNAL | SIM_TRACE_FLAG_REPORT)) ==
+            (SIM_TRACE_FLAG_INTERNAL | SIM_TRACE_FLAG_REPORT)) {
+            /* Internal report - regenerated by the callbacks during the tick */
+            continue;
+        }
+        if ((flags & SIM_TRACE_FLAG_INTERNAL) != 0U) {
+            /* Regenerated by the callbacks during the tick - just count */
+            summary.internal_expected++;
+            continue;
+        }
+
+        /* External posts, reports and the end marker happen between ticks */
+        SimClock_AdvanceTo(time_ms);
+        if ((flags & SIM_TRACE_FLAG_END) != 0U) {
+            ended = true;
+        } else if ((flags & SIM_TRACE_FLAG_REPORT) != 0U) {
+            ErrorHandler_Report((ErrorLevel_t)level, (ErrorCode_t)event);
+            summary.errors_injected++;
+        } else if ((flags & SIM_TRACE_FLAG_ERROR) != 0U) {
+            /* Regenerated by the replayed ErrorHandler_Report() above */
+        } else {
+            StateMachine_PostEvent((StateMachineEvent_t)event);
+            summary.events_injected++;
+        }
+    }
+
+    StateMachine_SetPostHook(NULL);
+
+    summary.internal_observed = g_replay_internal_posts;
+    summary.end_time = SimClock_Now();
+    summary.final_state = StateMachine_GetCurrentState();
+    if (result != NULL) {
+        *result = summary;
+    }
+    return true;
+}
+
+void SimTrace_SetFastForward(bool enable)
+{
+    g_fast_forward = enable;
+}
+
+bool SimTrace_Save(const SimTrace_t *trace, const char *path)
+{
+    FILE *file;
+    size_t written;
+
+    if (trace == NULL || trace->buffer == NULL || path == NULL) {
+        return false;
+    }
+
+    file = fopen(path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+    written = fwrite(trace->buffer, 1, trace->length, file);
+    fclose(file);
+
+    return written == trace->length;
+}
+
+bool SimTrace_Load(SimTrace_t *trace, uint8_t *buffer, uint32_t capacity, const char *path)
+{
+    FILE *file;
+    size_t length;
+
+    if (trace == NULL || buffer == NULL || path == NULL) {
+        return false;
+    }
+
+    file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+    length = fread(buffer, 1, capacity, file);
+    fclose(file);
+
+    return SimTrace_Attach(trace, buffer, (uint32_t)length);
+}
+
+/* =============================================================================
+ * PRIVATE HELPER FUNCTIONS
+ * ===========================================================================*/
+
+static void RecordHook(StateMachineEvent_t event, uint8_t flags)
+{
+    SimTrace_t *trace = g_recording;
+
+    if (trace == NULL || trace->overflow) {
+        return;
+    }
+    if (!AppendRecord(trace, StateMachine_GetTickCount(), SimClock_Now(),
+                      (uint8_t)event, flags, 0U)) {
+        trace->overflow = true;
+    }
+}
+
+static void RecordReportHook(ErrorLevel_t level, ErrorCode_t code)
+{
+    SimTrace_t *trace = g_recording;
+    uint8_t flags = (uint8_t)SIM_TRACE_FLAG_REPORT;
+
+    if (trace == NULL || trace->overflow) {
+        return;
+    }
+    if (StateMachine_IsExecuting()) {
+        flags = (uint8_t)(flags | SIM_TRACE_FLAG_INTERNAL);
+    }
+    if (!AppendRecord(trace, StateMachine_GetTickCount(), SimClock_Now(),
+                      (uint8_t)code, flags, (uint8_t)level)) {
+        trace->overflow = true;
+    }
+}
+
+static void ReplayHook(StateMachineEvent_t event, uint8_t flags)
+{
+    (void)event;
+    if ((flags & SIM_TRACE_FLAG_INTERNAL) != 0U) {
+        g_replay_internal_posts++;
+    }
+}
+
+static bool AppendRecord(SimTrace_t *trace, uint32_t tick, uint32_t time_ms,
+                         uint8_t event, uint8_t flags, uint8_t level)
+{
+    uint8_t record[13];  /* 2 x 5-byte varint + event + flags + level */
+    uint32_t length = 0;
+
+    length += WriteVarint(&record[length], tick - trace->last_tick);
+    length += WriteVarint(&record[length], time_ms - trace->last_time);
+    record[length++] = event;
+    record[length++] = flags;
+    if ((flags & SIM_TRACE_FLAG_REPORT) != 0U) {
+        record[length++] = level;
+    }
+
+    if ((trace->length + length) > trace->capacity) {
+        return false;
+    }
+
+    memcpy(&trace->buffer[trace->length], record, length);
+    trace->length += length;
+    trace->last_tick = tick;
+    trace->last_time = time_ms;
+    trace->record_count++;
+    return true;
+}
+
+static uint32_t WriteVarint(uint8_t *out, uint32_t value)
+{
+    uint32_t length = 0;
+
+    while (value >= 0x80U) {
+        out[length++] = (uint8_t)((value & 0x7FU) | 0x80U);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+static bool ReadVarint(const SimTrace_t *trace, uint32_t *pos, uint32_t *value)
+{
+    uint32_t result = 0;
+    uint32_t shift = 0;
+
+    while (*pos < trace->length && shift < 35U) {
+        uint8_t byte = trace->buffer[(*pos)++];
+        result |= (uint32_t)(byte & 0x7FU) << shift;
+        if ((byte & 0x80U) == 0U) {
+            *value = result;
+            return true;
+        }
+        shift += 7U;
+    }
+    return false;
+}
+
+static void PutU32(uint8_t *out, uint32_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t GetU32(const uint8_t *in)
+{
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) |
+           ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}